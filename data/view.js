@@ -41,6 +41,34 @@ function updateView(DataElements, ViewType) {
   }
 }
 
+function requestAllValues(ws, Subscription) {
+  //Updates only contain Changes, so the View needs all Values once it is created
+  //The Subscription selects Elements, Groups, Tags and the Rate-Class of the Updates
+  let Request = { "seq": 0 };
+  if (Subscription !== undefined) {
+    Request.subscribe = Subscription;
+  }
+  Request = JSON.stringify(Request);
+  if (ws.readyState === WebSocket.OPEN) {
+    ws.send(Request);
+  } else {
+    ws.addEventListener("open", () => ws.send(Request), { once: true });
+  }
+}
+
+function connectWebSocket(OnMessage, OnOpen) {
+  //The Server closes lost or idle Clients, so the Connection is reopened after a Delay
+  //OnOpen gets every new Socket and has to request all Values again
+  let ws = new WebSocket("ws://" + location.host + "/ws", "msgpack");
+  ws.binaryType = "arraybuffer";
+  ws.onmessage = OnMessage;
+  ws.onclose = function () {
+    setTimeout(() => connectWebSocket(OnMessage, OnOpen), 2000);
+  };
+  OnOpen(ws);
+  return ws;
+}
+
 function createViewElement(ViewElements, DataElement) {
   let ViewElement = document.createElement("article");
   ViewElement.setAttribute("name", DataElement.name);
@@ -216,4 +244,93 @@ function getOnClickObject(ValueInput) {
   let DataElements = { "elements": [] };
   DataElements.elements.push(DataElement);
   return DataElements;
-}
\ No newline at end of file
+}
+
+function parseWsMsg(Msg) {
+  //Binary Messages are MessagePack, Text Messages are JSON
+  if (Msg.data instanceof ArrayBuffer) {
+    return decodeMsgPack(Msg.data);
+  }
+  return JSON.parse(Msg.data);
+}
+
+function decodeMsgPack(Buffer) {
+  //Decoder for the MessagePack Types written by ArduinoJson (no Extensions)
+  let View = new DataView(Buffer);
+  let Bytes = new Uint8Array(Buffer);
+  let TextDecode = new TextDecoder();
+  let Pos = 0;
+
+  function readString(Length) {
+    let Text = TextDecode.decode(Bytes.subarray(Pos, Pos + Length));
+    Pos += Length;
+    return Text;
+  }
+  function readBinary(Length) {
+    let Value = Bytes.slice(Pos, Pos + Length);
+    Pos += Length;
+    return Value;
+  }
+  function readArray(Length) {
+    let Value = [];
+    for (let i = 0; i < Length; i++) {
+      Value.push(readValue());
+    }
+    return Value;
+  }
+  function readMap(Length) {
+    let Value = {};
+    for (let i = 0; i < Length; i++) {
+      let Key = readValue();
+      Value[Key] = readValue();
+    }
+    return Value;
+  }
+  function readNumber(Getter, Size) {
+    let Value = Getter.call(View, Pos);
+    Pos += Size;
+    return Value;
+  }
+  function readValue() {
+    let Type = Bytes[Pos++];
+    if (Type < 0x80) {
+      return Type;
+    } else if (Type < 0x90) {
+      return readMap(Type & 0x0F);
+    } else if (Type < 0xA0) {
+      return readArray(Type & 0x0F);
+    } else if (Type < 0xC0) {
+      return readString(Type & 0x1F);
+    } else if (Type >= 0xE0) {
+      return Type - 0x100;
+    }
+    switch (Type) {
+      case 0xC0: return null;
+      case 0xC2: return false;
+      case 0xC3: return true;
+      case 0xC4: return readBinary(readNumber(View.getUint8, 1));
+      case 0xC5: return readBinary(readNumber(View.getUint16, 2));
+      case 0xC6: return readBinary(readNumber(View.getUint32, 4));
+      case 0xCA: return parseFloat(readNumber(View.getFloat32, 4).toPrecision(7));
+      case 0xCB: return readNumber(View.getFloat64, 8);
+      case 0xCC: return readNumber(View.getUint8, 1);
+      case 0xCD: return readNumber(View.getUint16, 2);
+      case 0xCE: return readNumber(View.getUint32, 4);
+      case 0xCF: return Number(readNumber(View.getBigUint64, 8));
+      case 0xD0: return readNumber(View.getInt8, 1);
+      case 0xD1: return readNumber(View.getInt16, 2);
+      case 0xD2: return readNumber(View.getInt32, 4);
+      case 0xD3: return Number(readNumber(View.getBigInt64, 8));
+      case 0xD9: return readString(readNumber(View.getUint8, 1));
+      case 0xDA: return readString(readNumber(View.getUint16, 2));
+      case 0xDB: return readString(readNumber(View.getUint32, 4));
+      case 0xDC: return readArray(readNumber(View.getUint16, 2));
+      case 0xDD: return readArray(readNumber(View.getUint32, 4));
+      case 0xDE: return readMap(readNumber(View.getUint16, 2));
+      case 0xDF: return readMap(readNumber(View.getUint32, 4));
+    }
+    throw new Error("MessagePack Type 0x" + Type.toString(16) + " not supported");
+  }
+
+  return readValue();
+}
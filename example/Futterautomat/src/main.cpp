@@ -7,6 +7,7 @@
 // Basics
 #include <JCA_IOT_Webserver.h>
 #include <JCA_SYS_DebugOut.h>
+#include <JCA_SYS_JsonStream.h>
 
 // Project function
 #include <JCA_FNC_Feeder.h>
@@ -46,19 +47,37 @@ Webserver Server;
 // System Functions
 //-------------------------------------------------------
 void cbSystemReset () {
+  Debug.flush ();
   ESP.restart ();
 }
 void cbSaveConfig () {
   File ConfigFile = LittleFS.open (CONFIGPATH, "w");
-  bool ElementInit = false;
-  ConfigFile.println("{\"elements\":[");
-  Server.writeSetup(ConfigFile, ElementInit);
-  Spindel.writeSetup (ConfigFile, ElementInit);
-  Futter.writeSetup (ConfigFile, ElementInit);
-  ConfigFile.println ("]}");
+  JsonStream Setup (ConfigFile);
+  Setup.beginObject ();
+  Setup.beginArray (Protocol::JsonTagElements);
+  Server.writeSetup (Setup);
+  Spindel.writeSetup (Setup);
+  Futter.writeSetup (Setup);
+  Setup.endArray ();
+  Setup.endObject ();
+  Setup.flush ();
   ConfigFile.close ();
 }
 
+void getAllValues(JsonVariant &_In, JsonVariant &_Out) {
+  // Only Changes after the Sequence of the Client, missing Sequence returns all Values
+  uint32_t Since = _In[Protocol::JsonTagSequence].as<uint32_t> ();
+  JsonObject Elements = _Out.createNestedObject (Protocol::JsonTagElements);
+  Protocol::getAllValues (Elements, Since, _In[Protocol::JsonTagSubscribe].as<JsonObject> ());
+  _Out[Protocol::JsonTagSequence] = Protocol::getSequence ();
+}
+
+void setAll(JsonVariant &_In) {
+  if (_In.containsKey (Protocol::JsonTagElements)) {
+    JsonArray Elements = (_In.as<JsonObject> ())[Protocol::JsonTagElements].as<JsonArray> ();
+    Protocol::setAll (Elements);
+  }
+}
 //-------------------------------------------------------
 // Website Functions
 //-------------------------------------------------------
@@ -72,19 +91,11 @@ String cbWebConfigReplace (const String &var) {
 // RestAPI Functions
 //-------------------------------------------------------
 void cbRestApiGet (JsonVariant &_In, JsonVariant &_Out) {
-  JsonObject Elements = _Out.createNestedObject (Protocol::JsonTagElements);
-  Server.getValues (Elements);
-  Spindel.getValues (Elements);
-  Futter.getValues (Elements);
+  getAllValues(_In, _Out);
 }
 
 void cbRestApiPost (JsonVariant &_In, JsonVariant &_Out) {
-  if (_In.containsKey (Protocol::JsonTagElements)) {
-    JsonArray Elements = (_In.as<JsonObject> ())[Protocol::JsonTagElements].as<JsonArray> ();
-    Server.set (Elements);
-    Spindel.set (Elements);
-    Futter.set (Elements);
-  }
+  setAll(_In);
 }
 
 void cbRestApiPut (JsonVariant &_In, JsonVariant &_Out) {
@@ -92,7 +103,8 @@ void cbRestApiPut (JsonVariant &_In, JsonVariant &_Out) {
 }
 
 void cbRestApiPatch (JsonVariant &_In, JsonVariant &_Out) {
-  cbSaveConfig();
+  // Deferred while the Spindel is moving
+  Server.runJob (cbSaveConfig, JCA_IOT_WEBSERVER_JOB_SAVECONFIG);
 }
 
 void cbRestApiDelete (JsonVariant &_In, JsonVariant &_Out) {
@@ -103,19 +115,13 @@ void cbRestApiDelete (JsonVariant &_In, JsonVariant &_Out) {
 // Websocket Functions
 //-------------------------------------------------------
 void cbWsUpdate (JsonVariant &_In, JsonVariant &_Out) {
-  JsonObject Elements = _Out.createNestedObject (Protocol::JsonTagElements);
-  Spindel.getValues (Elements);
-  Futter.getValues (Elements);
+  getAllValues(_In, _Out);
 }
 void cbWsData (JsonVariant &_In, JsonVariant &_Out) {
-  if (_In.containsKey (Protocol::JsonTagElements)) {
-    JsonArray Elements = (_In.as<JsonObject> ())[Protocol::JsonTagElements].as<JsonArray> ();
-    Spindel.set (Elements);
-    Futter.set (Elements);
-  }
-  JsonObject Elements = _Out.createNestedObject (Protocol::JsonTagElements);
-  Spindel.getValues (Elements);
-  Futter.getValues (Elements);
+  setAll(_In);
+
+  // Return Value update
+  getAllValues(_In, _Out);
 }
 
 //#######################################################
@@ -134,7 +140,7 @@ void setup () {
   // Filesystem
   //+++++++++++++++++++++++++++++++++++++++++++++++++++++++
   if (!LittleFS.begin ()) {
-    Debug.println (FLAG_ERROR, false, "root", "setup", "LITTLEFS Mount Failed");
+    JCA_DEBUG_PRINTLN (FLAG_ERROR, false, "root", "setup", "LITTLEFS Mount Failed");
     return;
   }
 
@@ -165,23 +171,21 @@ void setup () {
   //-------------------------------------------------------
   File ConfigFile = LittleFS.open (CONFIGPATH, "r");
   if (ConfigFile) {
-    Debug.println (FLAG_CONFIG, false, "main", "setup", "Config File Found");
+    JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, "main", "setup", "Config File Found");
     DeserializationError Error = deserializeJson (JDoc, ConfigFile);
     if (!Error) {
-      Debug.println (FLAG_CONFIG, false, "main", "setup", "Deserialize Done");
-      if (JDoc.containsKey (Protocol::JsonTagElements)) {
-        JsonArray Elements = (JDoc.as<JsonObject> ())[Protocol::JsonTagElements].as<JsonArray> ();
-        Spindel.set (Elements);
-        Futter.set (Elements);
-      }
+      JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, "main", "setup", "Deserialize Done");
+      JsonVariant InConfig = JDoc.as<JsonVariant>();
+      setAll(InConfig);
     } else {
-      Debug.print (FLAG_ERROR, false, "main", "setup", "deserializeJson() failed: ");
-      Debug.println (FLAG_ERROR, false, "main", "setup", Error.c_str ());
+      JCA_DEBUG_PRINT (FLAG_ERROR, false, "main", "setup", "deserializeJson() failed: ");
+      JCA_DEBUG_PRINTLN (FLAG_ERROR, false, "main", "setup", Error.c_str ());
     }
     ConfigFile.close ();
   } else {
-    Debug.println (FLAG_ERROR, false, "main", "setup", "Config File NOT found");
+    JCA_DEBUG_PRINTLN (FLAG_ERROR, false, "main", "setup", "Config File NOT found");
   }
+  Debug.flush ();
 }
 
 //#######################################################
@@ -191,6 +195,9 @@ void loop () {
   Server.handle ();
   tm CurrentTime = Server.getTimeStruct ();
 
-  Spindel.update (CurrentTime);
-  Futter.update (CurrentTime);
+  // Due Elements by Priority, the Spindel in every Pass
+  Protocol::updateAll (CurrentTime);
+
+  // Debug-Output in the Rest of the Pass, without waiting for the UART
+  Debug.handle ();
 }
\ No newline at end of file
@@ -4,22 +4,11 @@ using namespace JCA::SYS;
 
 namespace JCA {
   namespace FNC {
-    const char *DS18B20::Filter_Name = "Filter";
-    const char *DS18B20::Filter_Text = "Filterkonstante";
-    const char *DS18B20::Filter_Unit = "s";
-    const char *DS18B20::Filter_Comment = nullptr;
-    const char *DS18B20::Addr_Name = "Addr";
-    const char *DS18B20::Addr_Text = "Sensoradresse";
-    const char *DS18B20::Addr_Unit = "X";
-    const char *DS18B20::Addr_Comment = "Sensoradress HEX Codiert, ohne führende Fomatkennzeichnung";
-    const char *DS18B20::ReadInterval_Name = "ReadInterval";
-    const char *DS18B20::ReadInterval_Text = "Leseintervall";
-    const char *DS18B20::ReadInterval_Unit = "s";
-    const char *DS18B20::ReadInterval_Comment = nullptr;
-    const char *DS18B20::Temp_Name = "Temp";
-    const char *DS18B20::Temp_Text = "Temperatur";
-    const char *DS18B20::Temp_Unit = "°C";
-    const char *DS18B20::Temp_Comment = nullptr;
+    const TagDescriptor<DS18B20> DS18B20::Tags[] = {
+      {TagGroup::Config, "Filter", "Filterkonstante", nullptr, false, "s", &DS18B20::Filter},
+      {TagGroup::Config, "Addr", "Sensoradresse", "Sensoradress HEX Codiert, ohne führende Fomatkennzeichnung", false, &DS18B20::AddrHex, &DS18B20::onAddrChanged},
+      {TagGroup::Config, "ReadInterval", "Leseintervall", nullptr, false, "s", &DS18B20::ReadInterval, &DS18B20::onReadIntervalChanged},
+      {TagGroup::Data, "Temp", "Temperatur", nullptr, true, "°C", &DS18B20::Value}};
 
     /**
      * @brief Construct a new DS18B20::DS18B20 object
@@ -37,13 +26,20 @@ namespace JCA {
       Addr[4] = 0;
       Addr[5] = 0;
       Addr[6] = 0;
-      Addr[71] = 0;
+      Addr[7] = 0;
+      AddrHex = ByteArrayToHexString (Addr, 8);
       ReadInterval = 1;
       Filter = 5.0;
       Value = 0.0;
-      Resend = 0;
       ReadData = false;
-      LastMillis = millis();
+      setSchedule ((uint32_t)ReadInterval * 1000, TaskPriority::Low, JCA_FNC_DS18B20_BUDGET);
+    }
+
+    /**
+     * @brief Read-Interval changed, the Scheduler uses it as Period
+     */
+    void DS18B20::onReadIntervalChanged () {
+      setPeriod ((uint32_t)ReadInterval * 1000);
     }
 
     /**
@@ -52,32 +48,17 @@ namespace JCA {
      * @param _Tags Array of Config-Tags ("config": [])
      */
     void DS18B20::setConfig (JsonArray _Tags) {
-      Debug.println (FLAG_CONFIG, false, Name, __func__, "Set");
-      for (JsonObject Tag : _Tags) {
-        if (Tag[JsonTagName] == Filter_Name) {
-          Filter = Tag[JsonTagValue].as<float> ();
-          if (Debug.print (FLAG_CONFIG, false, Name, __func__, Filter_Name)) {
-            Debug.print (FLAG_CONFIG, false, Name, __func__, DebugSeparator);
-            Debug.println (FLAG_CONFIG, false, Name, __func__, Filter);
-          }
-        }
-        if (Tag[JsonTagName] == Addr_Name) {
-          String AddrHex = Tag[JsonTagValue].as<String> ();
-          // Convert HEX-String to Byte-Array
-          HexStringToByteArray(AddrHex, Addr, 8);
-          if (Debug.print (FLAG_CONFIG, false, Name, __func__, Addr_Name)) {
-            Debug.print (FLAG_CONFIG, false, Name, __func__, DebugSeparator);
-            Debug.println (FLAG_CONFIG, false, Name, __func__, AddrHex);
-          }
-        }
-        if (Tag[JsonTagName] == ReadInterval_Name) {
-          ReadInterval = Tag[JsonTagValue].as<uint16_t> ();
-          if (Debug.print (FLAG_CONFIG, false, Name, __func__, ReadInterval_Name)) {
-            Debug.print (FLAG_CONFIG, false, Name, __func__, DebugSeparator);
-            Debug.println (FLAG_CONFIG, false, Name, __func__, ReadInterval);
-          }
-        }
-      }
+      JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, Name, __func__, "Set");
+      setTags (this, Tags, TagGroup::Config, _Tags);
+    }
+
+    /**
+     * @brief Convert the new HEX-Address to the Byte-Array
+     * The String is rebuilt from the Array, so it shows the used Address if the Input was invalid
+     */
+    void DS18B20::onAddrChanged () {
+      HexStringToByteArray (AddrHex, Addr, 8);
+      AddrHex = ByteArrayToHexString (Addr, 8);
     }
 
     /**
@@ -99,73 +80,72 @@ namespace JCA {
     /**
      * @brief Create a list of Config-Tags containing the current Value
      *
-     * @param _Tags Array the Tags have to add
+     * @param _Setup Writer inside the Element
      */
-    void DS18B20::writeSetupConfig (File _SetupFile) {
-      Debug.println (FLAG_CONFIG, false, Name, __func__, "Get");
-      _SetupFile.println (",\"" + String(JsonTagConfig) + "\":[");
-      _SetupFile.println ("{" + createSetupTag (Filter_Name, Filter_Text, Filter_Comment, false, Filter_Unit, Filter) + "}");
-      _SetupFile.println (",{" + createSetupTag (Addr_Name, Addr_Text, Addr_Comment, false, ByteArrayToHexString(Addr, 8)) + "}");
-      _SetupFile.println (",{" + createSetupTag (ReadInterval_Name, ReadInterval_Text, ReadInterval_Comment, false, ReadInterval_Unit, ReadInterval) + "}");
-      _SetupFile.println ("]");
+    void DS18B20::writeSetupConfig (JsonStream &_Setup) {
+      JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, Name, __func__, "Get");
+      _Setup.beginArray (JsonTagConfig);
+      writeSetupTags (this, Tags, TagGroup::Config, _Setup);
+      _Setup.endArray ();
     }
 
     /**
      * @brief Create a list of Data-Tags containing the current Value
      *
-     * @param _Tags Array the Tags have to add
+     * @param _Setup Writer inside the Element
      */
-    void DS18B20::writeSetupData (File _SetupFile) {
-      Debug.println (FLAG_CONFIG, false, Name, __func__, "Get");
-      _SetupFile.println (",\"" + String(JsonTagData) + "\":[");
-      _SetupFile.println ("{" + createSetupTag (Temp_Name, Temp_Text, Temp_Comment, true, Temp_Unit, Value) + "}");
-      _SetupFile.println ("]");
+    void DS18B20::writeSetupData (JsonStream &_Setup) {
+      JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, Name, __func__, "Get");
+      _Setup.beginArray (JsonTagData);
+      writeSetupTags (this, Tags, TagGroup::Data, _Setup);
+      _Setup.endArray ();
     }
 
     /**
      * @brief Create a list of Command-Informations
      *
-     * @param _Tags Array the Command-Infos have to add
+     * @param _Setup Writer inside the Element
      */
-    void DS18B20::writeSetupCmdInfo (File _SetupFile) {
-      Debug.println (FLAG_CONFIG, false, Name, __func__, "Get");
+    void DS18B20::writeSetupCmdInfo (JsonStream &_Setup) {
+      JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, Name, __func__, "Get");
     }
 
     void DS18B20::createConfigValues (JsonObject &_Values) {
-      _Values[Filter_Name] = Filter;
-      _Values[Addr_Name] = ByteArrayToHexString(Addr, 8);
-      _Values[ReadInterval_Name] = ReadInterval;
+      createTagValues (this, Tags, TagGroup::Config, _Values);
     }
 
     void DS18B20::createDataValues (JsonObject &_Values) {
-      _Values[Temp_Name] = Value;
+      createTagValues (this, Tags, TagGroup::Data, _Values);
+    }
+
+    void DS18B20::trackChanges () {
+      trackTags (this, Tags);
     }
 
     /**
      * @brief Handling DS18B20-Sensor
-     * Read and Skale the Temperature
-     * @param time Current Time to check the Samplerate
+     * Read and Skale the Temperature.
+     * The Scheduler calls the Function every Read-Interval to start the Conversion,
+     * the Result is read after the Conversion-Time by an own Deadline.
+     * @param time Current Time
      */
     void DS18B20::update (struct tm &time) {
-      int i;
       int16_t raw;
-      uint8_t cfg;
-      uint32_t DiffMillis = millis () - LastMillis;
 
-      // If Resend counts to 0 resend convertion Request
-      if (this->Resend <= 0) {
+      // Start the Conversion
+      if (!this->ReadData) {
         // OneWire Bus is free to write Data
         if (Wire->reset ()) {
           Wire->select (this->Addr);
           Wire->write (JCA_FNC_DS18B20_CMD_CONV);
-          this->Resend = (uint32_t)(this->ReadInterval);
           this->ReadData = true;
+          setDeadline (JCA_FNC_DS18B20_CONVTIME);
         } else {
-          this->Resend = 100;
+          setDeadline (JCA_FNC_DS18B20_RETRY);
         }
       }
-      // checking if Convetion is Done
-      else if (this->ReadData) {
+      // Conversion is Done
+      else {
         // OneWire Bus is free to write Data
         if (Wire->reset ()) {
           // send Data Request
@@ -198,16 +178,15 @@ namespace JCA {
               }
             }
             Value = (float)raw / 16.0;
-            if (Debug.print (FLAG_LOOP, false, Name, __func__, Temp_Name)) {
-              Debug.print (FLAG_CONFIG, false, Name, __func__, DebugSeparator);
-              Debug.println (FLAG_CONFIG, false, Name, __func__, Value);
+            if (JCA_DEBUG_PRINT (FLAG_LOOP, false, Name, __func__, "Temp")) {
+              JCA_DEBUG_PRINT (FLAG_CONFIG, false, Name, __func__, DebugSeparator);
+              JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, Name, __func__, Value);
             }
             this->ReadData = false;
+            return;
           }
         }
-        this->Resend -= DiffMillis;
-      } else {
-        this->Resend -= DiffMillis;
+        setDeadline (JCA_FNC_DS18B20_RETRY);
       }
     }
 
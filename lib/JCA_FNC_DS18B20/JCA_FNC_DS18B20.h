@@ -20,38 +20,30 @@
 #define JCA_FNC_DS18B20_CMD_RECALL 0xB8
 #define JCA_FNC_DS18B20_CMD_POWER 0xB4
 
+// Conversion-Time at 12 Bit and Retry if the Bus is busy (ms)
+#define JCA_FNC_DS18B20_CONVTIME 750
+#define JCA_FNC_DS18B20_RETRY 100
+// Run-Time Budget of one Bus-Access (us)
+#define JCA_FNC_DS18B20_BUDGET 15000
+
 namespace JCA {
   namespace FNC {
     class DS18B20 : public Protocol{
     private:
       // Datapoint description
-      static const char *Filter_Name;
-      static const char *Filter_Text;
-      static const char *Filter_Unit;
-      static const char *Filter_Comment;
-      static const char *Addr_Name;
-      static const char *Addr_Text;
-      static const char *Addr_Unit;
-      static const char *Addr_Comment;
-      static const char *ReadInterval_Name;
-      static const char *ReadInterval_Text;
-      static const char *ReadInterval_Unit;
-      static const char *ReadInterval_Comment;
-      static const char *Temp_Name;
-      static const char *Temp_Text;
-      static const char *Temp_Unit;
-      static const char *Temp_Comment;
+      static const TagDescriptor<DS18B20> Tags[];
 
       // Protocol Functions
       void createConfigValues (JsonObject &_Values);
       void createDataValues (JsonObject &_Values);
+      void trackChanges ();
       void setConfig (JsonArray _Tags);
       void setData (JsonArray _Tags);
       void setCmd (JsonArray _Tags);
 
-      void writeSetupConfig (File _SetupFile);
-      void writeSetupData (File _SetupFile);
-      void writeSetupCmdInfo (File _SetupFile);
+      void writeSetupConfig (JCA::SYS::JsonStream &_Setup);
+      void writeSetupData (JCA::SYS::JsonStream &_Setup);
+      void writeSetupCmdInfo (JCA::SYS::JsonStream &_Setup);
 
       // Hardware
       OneWire* Wire;
@@ -59,6 +51,7 @@ namespace JCA {
       // Konfig
       float Filter;
       uint8_t Addr[8];
+      String AddrHex;
       uint16_t ReadInterval;
 
       // Daten
@@ -66,10 +59,10 @@ namespace JCA {
 
       // Intern
       uint8_t Raw[12];
-      int32_t Resend;
       bool ReadData;
-      uint32_t LastMillis;
 
+      void onAddrChanged ();
+      void onReadIntervalChanged ();
       void HexStringToByteArray (String _HexString, uint8_t *_ByteArray, uint8_t _Length);
       uint8_t HexCharToInt(char _HexChar);
       String ByteArrayToHexString (uint8_t *_ByteArray, uint8_t _Length);
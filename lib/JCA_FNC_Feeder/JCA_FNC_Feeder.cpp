@@ -5,56 +5,43 @@ using namespace JCA::SYS;
 namespace JCA {
   namespace FNC {
     const char *Feeder::FeedingHour_Name = "FeedingHour";
-    const char *Feeder::FeedingHour_Text = "Fütterung Stunde";
-    const char *Feeder::FeedingHour_Unit = "h";
-    const char *Feeder::FeedingHour_Comment = nullptr;
     const char *Feeder::FeedingMinute_Name = "FeedingMinute";
-    const char *Feeder::FeedingMinute_Text = "Fütterung Minute";
-    const char *Feeder::FeedingMinute_Unit = "m";
-    const char *Feeder::FeedingMinute_Comment = nullptr;
-    const char *Feeder::SteppsPerRotation_Name = "SteppsPerRotation";
-    const char *Feeder::SteppsPerRotation_Text = "Schritte pro Umdrehung";
-    const char *Feeder::SteppsPerRotation_Unit = "st/rot";
-    const char *Feeder::SteppsPerRotation_Comment = nullptr;
-    const char *Feeder::FeedingRotations_Name = "FeedingRotations";
-    const char *Feeder::FeedingRotations_Text = "Umdrehungen je Fütterung";
-    const char *Feeder::FeedingRotaions_Unit = "rot";
-    const char *Feeder::FeedingRotaions_Comment = nullptr;
-    const char *Feeder::Acceleration_Name = "Acceleration";
-    const char *Feeder::Acceleration_Text = "Beschleuningung";
-    const char *Feeder::Acceleration_Unit = "st/s2";
-    const char *Feeder::Acceleration_Comment = nullptr;
-    const char *Feeder::MaxSpeed_Name = "MaxSpeed";
-    const char *Feeder::MaxSpeed_Text = "Maximale Geschwindigkeit";
-    const char *Feeder::MaxSpeed_Unit = "st/s";
-    const char *Feeder::MaxSpeed_Comment = nullptr;
-    const char *Feeder::ConstSpeed_Name = "ConstSpeed";
-    const char *Feeder::ConstSpeed_Text = "Konstant Geschwindigkeit";
-    const char *Feeder::ConstSpeed_Unit = "st/s";
-    const char *Feeder::ConstSpeed_Comment = nullptr;
-    const char *Feeder::Feeding_Name = "Feeding";
-    const char *Feeder::Feeding_Text = "Fütterung aktiv";
-    const char *Feeder::Feeding_Comment = nullptr;
-    const char *Feeder::Feeding_TextOn = nullptr;
-    const char *Feeder::Feeding_TextOff = nullptr;
-    const char *Feeder::DistanceToGo_Name = "DistanceToGo";
-    const char *Feeder::DistanceToGo_Text = "Verbleibende Schritte";
-    const char *Feeder::DistanceToGo_Unit = "st";
-    const char *Feeder::DistanceToGo_Comment = nullptr;
-    const char *Feeder::RunConst_Name = "RunConst";
-    const char *Feeder::RunConst_Text = "Konstante Drehung aktiv";
-    const char *Feeder::RunConst_Comment = nullptr;
-    const char *Feeder::RunConst_TextOn = nullptr;
-    const char *Feeder::RunConst_TextOff = nullptr;
-    const char *Feeder::Speed_Name = "Speed";
-    const char *Feeder::Speed_Text = "aktuelle Geschwindigkeit";
-    const char *Feeder::Speed_Unit = "st/s";
-    const char *Feeder::Speed_Comment = nullptr;
-    const char *Feeder::CmdDoFeed_Name = "doFeed";
-    const char *Feeder::CmdDoFeed_Text = "Jetzt Füttern";
-    const char *Feeder::CmdDoFeed_Comment = nullptr;
-    const char *Feeder::CmdDoFeed_Type = "bool";
-    const char *Feeder::CmdDoFeed_BtnText = "GO";
+    const char *Feeder::Slot_Name = "Slot";
+    const char *Feeder::Slot_Text = "Fütterung";
+    const char *Feeder::SlotHour_Name = "Hour";
+    const char *Feeder::SlotHour_Text = "Stunde";
+    const char *Feeder::SlotHour_Unit = "h";
+    const char *Feeder::SlotHour_Comment = "-1 = deaktiviert";
+    const char *Feeder::SlotMinute_Name = "Minute";
+    const char *Feeder::SlotMinute_Text = "Minute";
+    const char *Feeder::SlotMinute_Unit = "m";
+    const char *Feeder::SlotMinute_Comment = nullptr;
+    const char *Feeder::SlotDays_Name = "Days";
+    const char *Feeder::SlotDays_Text = "Wochentage";
+    const char *Feeder::SlotDays_Unit = "#";
+    const char *Feeder::SlotDays_Comment = "Summe aus So=1, Mo=2, Di=4, Mi=8, Do=16, Fr=32, Sa=64 (127 = täglich)";
+    const char *Feeder::SlotDose_Name = "Dose";
+    const char *Feeder::SlotDose_Text = "Menge";
+    const char *Feeder::SlotDose_Unit = "rot";
+    const char *Feeder::SlotDose_Comment = "0 = Umdrehungen je Fütterung";
+    const char *Feeder::StepLate_Name = "StepLate";
+    const char *Feeder::StepLate_Text = "Schritte verspätet bis";
+    const char *Feeder::StepLate_Comment = "Schritte je Verspätung seit Start der Bewegung (nicht kumuliert)";
+    const TagDescriptor<Feeder> Feeder::Tags[] = {
+      {TagGroup::Config, "SteppsPerRotation", "Schritte pro Umdrehung", nullptr, false, "st/rot", &Feeder::SteppsPerRotation},
+      {TagGroup::Config, "FeedingRotations", "Umdrehungen je Fütterung", nullptr, false, "rot", &Feeder::FeedingRotations},
+      {TagGroup::Config, "Acceleration", "Beschleuningung", nullptr, false, "st/s2", &Feeder::Acceleration, &Feeder::onRampChanged},
+      {TagGroup::Config, "MaxSpeed", "Maximale Geschwindigkeit", nullptr, false, "st/s", &Feeder::MaxSpeed, &Feeder::onRampChanged},
+      {TagGroup::Config, "ConstSpeed", "Konstant Geschwindigkeit", nullptr, false, "st/s", &Feeder::ConstSpeed, &Feeder::onConstSpeedChanged},
+      {TagGroup::Config, "MotionPriority", "Vorrang für Bewegung", "Websocket-Updates, Speichern, Sensoren und Debug-Ausgaben warten bis die Bewegung beendet ist, höchstens 2 s am Stück", false, nullptr, nullptr, &Feeder::MotionPriority},
+      {TagGroup::Data, "Feeding", "Fütterung aktiv", nullptr, true, nullptr, nullptr, &Feeder::Feeding},
+      {TagGroup::Data, "DistanceToGo", "Verbleibende Schritte", nullptr, true, "st", &Feeder::DistanceToGo},
+      {TagGroup::Data, "RunConst", "Konstante Drehung aktiv", nullptr, false, nullptr, nullptr, &Feeder::RunConst, &Feeder::onRunConstChanged},
+      {TagGroup::Data, "Speed", "aktuelle Geschwindigkeit", nullptr, true, "st/s", &Feeder::Speed},
+      {TagGroup::Data, "StepLateness", "Schritt-Verspätung (max.)", "Größte Abweichung eines Schritts vom geplanten Intervall seit Start der Bewegung", true, "us", &Feeder::StepLateness},
+      {TagGroup::Data, "MissedSteps", "Verpasste Schritte", "Schritte die später als ihr ganzes Intervall kamen, seit Start der Bewegung", true, "st", &Feeder::MissedSteps},
+      {TagGroup::Data, "MissedFeedings", "Verpasste Fütterungen", "Fällig während konstanter Drehung oder während schon eine Fütterung wartete", true, nullptr, &Feeder::MissedFeedings},
+      {TagGroup::Data, "doFeed", "Jetzt Füttern", nullptr, "bool", "GO", &Feeder::doFeedCmd}};
 
     /**
      * @brief Construct a new Feeder::Feeder object
@@ -65,29 +52,48 @@ namespace JCA {
      * @param _Name Element Name inside the Communication
      */
     Feeder::Feeder (uint8_t _PinEnable, uint8_t _PinStep, uint8_t _PinDir, const char *_Name)
-        : Protocol (_Name), Stepper (AccelStepper::DRIVER, _PinStep, _PinDir) {
+        : Protocol (_Name), Generator (_PinEnable, _PinStep, _PinDir) {
 
       // Intern
       DoFeed = false;
-      AutoFeedDone = false;
+      Target = 0;
+      NextSlot = 0;
+      NextDueEpoch = 0;
+      LastEpoch = 0;
+      ScheduleDirty = true;
+      RampSteps = 0;
+      RampShift = 0;
+      RampDirty = false;
 
       // Konfig
-      FeedingHour = -1;
-      FeedingMinute = -1;
+      for (uint8_t i = 0; i < JCA_FNC_FEEDER_SLOTS; i++) {
+        Slots[i].Hour = -1;
+        Slots[i].Minute = 0;
+        Slots[i].Days = JCA_FNC_FEEDER_DAYS_ALL;
+        Slots[i].Dose = 0.0;
+      }
       SteppsPerRotation = 0.0;
       FeedingRotations = 0.0;
       Acceleration = 0.0;
       MaxSpeed = 0.0;
       ConstSpeed = 0.0;
+      MotionPriority = true;
 
       // Daten
       RunConst = false;
       Feeding = false;
+      DistanceToGo = 0;
+      Speed = 0.0;
+      StepLateness = 0;
+      MissedSteps = 0;
+      MissedFeedings = 0;
+      FeedPending = false;
+      PendingRotations = 0.0;
+      LateSteps = 0;
+      LateSeq = 0;
 
-      // Hardware
-      Stepper.setEnablePin (_PinEnable);
-      Stepper.setPinsInverted (false, false, true);
-      Stepper.disableOutputs ();
+      // The Stepper-Queue is refilled in every Pass of the Scheduler
+      setSchedule (0, TaskPriority::Critical);
     }
 
     /**
@@ -96,93 +102,88 @@ namespace JCA {
      * @param _Tags Array of Config-Tags ("config": [])
      */
     void Feeder::setConfig (JsonArray _Tags) {
-      Debug.println (FLAG_CONFIG, false, Name, __func__, "Set");
+      JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, Name, __func__, "Set");
+      bool SlotsChanged = false;
       for (JsonObject Tag : _Tags) {
-        if (Tag[JsonTagName] == FeedingHour_Name) {
-          FeedingHour = Tag[JsonTagValue].as<int16_t> ();
-          if (Debug.print (FLAG_CONFIG, false, Name, __func__, FeedingHour_Name)) {
-            Debug.print (FLAG_CONFIG, false, Name, __func__, DebugSeparator);
-            Debug.println (FLAG_CONFIG, false, Name, __func__, FeedingHour);
-          }
-        }
-        if (Tag[JsonTagName] == FeedingMinute_Name) {
-          FeedingMinute = Tag[JsonTagValue].as<int16_t> ();
-          if (Debug.print (FLAG_CONFIG, false, Name, __func__, FeedingMinute_Name)) {
-            Debug.print (FLAG_CONFIG, false, Name, __func__, DebugSeparator);
-            Debug.println (FLAG_CONFIG, false, Name, __func__, FeedingMinute);
-          }
-        }
-        if (Tag[JsonTagName] == SteppsPerRotation_Name) {
-          SteppsPerRotation = Tag[JsonTagValue].as<float> ();
-          if (Debug.print (FLAG_CONFIG, false, Name, __func__, SteppsPerRotation_Name)) {
-            Debug.print (FLAG_CONFIG, false, Name, __func__, DebugSeparator);
-            Debug.println (FLAG_CONFIG, false, Name, __func__, SteppsPerRotation);
-          }
-        }
-        if (Tag[JsonTagName] == FeedingRotations_Name) {
-          FeedingRotations = Tag[JsonTagValue].as<float> ();
-          if (Debug.print (FLAG_CONFIG, false, Name, __func__, FeedingRotations_Name)) {
-            Debug.print (FLAG_CONFIG, false, Name, __func__, DebugSeparator);
-            Debug.println (FLAG_CONFIG, false, Name, __func__, FeedingRotations);
-          }
-        }
-        if (Tag[JsonTagName] == Acceleration_Name) {
-          Acceleration = Tag[JsonTagValue].as<float> ();
-          Stepper.setAcceleration (Acceleration);
-          if (Debug.print (FLAG_CONFIG, false, Name, __func__, Acceleration_Name)) {
-            Debug.print (FLAG_CONFIG, false, Name, __func__, DebugSeparator);
-            Debug.println (FLAG_CONFIG, false, Name, __func__, Acceleration);
-          }
-        }
-        if (Tag[JsonTagName] == MaxSpeed_Name) {
-          MaxSpeed = Tag[JsonTagValue].as<float> ();
-          Stepper.setMaxSpeed (MaxSpeed);
-          if (Debug.print (FLAG_CONFIG, false, Name, __func__, MaxSpeed_Name)) {
-            Debug.print (FLAG_CONFIG, false, Name, __func__, DebugSeparator);
-            Debug.println (FLAG_CONFIG, false, Name, __func__, MaxSpeed);
-          }
-        }
-        if (Tag[JsonTagName] == ConstSpeed_Name) {
-          ConstSpeed = Tag[JsonTagValue].as<float> ();
-          Stepper.setSpeed (ConstSpeed);
-          if (Debug.print (FLAG_CONFIG, false, Name, __func__, ConstSpeed_Name)) {
-            Debug.print (FLAG_CONFIG, false, Name, __func__, DebugSeparator);
-            Debug.println (FLAG_CONFIG, false, Name, __func__, ConstSpeed);
-          }
+        if (!setTag (this, Tags, TagGroup::Config, Tag)) {
+          SlotsChanged |= setSlotConfig (Tag);
         }
       }
+      // The Interrupt reads the Ramp-Table while Feeding, planMove rebuilds it later
+      if (RampDirty && !Feeding) {
+        buildRamp ();
+      }
+      if (SlotsChanged) {
+        compileSchedule ();
+      }
     }
 
     /**
      * @brief Set the Element Data
-     * currently not used
+     * Only existing Tags will be updated
      * @param _Tags Array of Data-Tags ("data": [])
      */
     void Feeder::setData (JsonArray _Tags) {
-      for (JsonObject Tag : _Tags) {
-        if (Tag[JsonTagName] == RunConst_Name) {
-          RunConst = Tag[JsonTagValue].as<bool> ();
-          if (Debug.print (FLAG_LOOP, false, Name, __func__, RunConst_Name)) {
-            Debug.print (FLAG_CONFIG, false, Name, __func__, DebugSeparator);
-            Debug.println (FLAG_LOOP, false, Name, __func__, RunConst);
-          }
-          if (RunConst) {
-            Stepper.enableOutputs ();
-          } else {
-            Stepper.disableOutputs ();
-          }
-        }
+      setTags (this, Tags, TagGroup::Data, _Tags);
+    }
 
-        if (Tag[JsonTagName] == CmdDoFeed_Name) {
-          DoFeed = Tag[JsonTagValue].as<bool> ();
-          if (Debug.print (FLAG_LOOP, false, Name, __func__, CmdDoFeed_Name)) {
-            Debug.print (FLAG_CONFIG, false, Name, __func__, DebugSeparator);
-            Debug.println (FLAG_LOOP, false, Name, __func__, DoFeed);
-          }
-          if (DoFeed) {
-            RunConst = false;
-          }
-        }
+    /**
+     * @brief Acceleration or MaxSpeed changed, the Ramp-Table has to be rebuilt
+     */
+    void Feeder::onRampChanged () {
+      RampDirty = true;
+    }
+
+    /**
+     * @brief Constant Speed changed
+     * Queued Segments still use the old Speed
+     */
+    void Feeder::onConstSpeedChanged () {
+      if (RunConst) {
+        Generator.stop ();
+      }
+    }
+
+    /**
+     * @brief Constant Mode switched
+     * Stop the current Movement and switch the Driver
+     */
+    void Feeder::onRunConstChanged () {
+      Generator.stop ();
+      if (RunConst) {
+        Generator.resetLateness ();
+        Generator.enableOutputs ();
+      } else {
+        Generator.disableOutputs ();
+      }
+    }
+
+    /**
+     * @brief Start a Feeding with the Rotations per Feeding on next update
+     * Ends the constant Mode
+     * @param _Value true to start the Feeding
+     */
+    void Feeder::doFeedCmd (JsonVariant _Value) {
+      DoFeed = _Value.as<bool> ();
+      if (DoFeed) {
+        RunConst = false;
+      }
+    }
+
+    /**
+     * @brief Copy the current Values of the Generator to the Data-Tags
+     * The Lateness-Tags get a new Sequence only if Steps were counted or the Histogram was reset
+     */
+    void Feeder::updateDataValues () {
+      DistanceToGo = Target - Generator.getPosition ();
+      Speed = Generator.getSpeed ();
+      StepLateness = Generator.getMaxLateness ();
+      MissedSteps = Generator.getMissedSteps ();
+      uint32_t Steps = Generator.getLateness ().count ();
+      if (Steps != LateSteps) {
+        LateSteps = Steps;
+        LateSeq = ++Sequence;
+        DataSeq = LateSeq;
       }
     }
 
@@ -192,66 +193,105 @@ namespace JCA {
      * @param _Tags Array of Commands ("cmd": [])
      */
     void Feeder::setCmd (JsonArray _Tags) {
+      setTags (this, Tags, TagGroup::Cmd, _Tags);
     }
 
     /**
      * @brief Create a list of Config-Tags containing the current Value
      *
-     * @param _Tags Array the Tags have to add
+     * @param _Setup Writer inside the Element
      */
-    void Feeder::writeSetupConfig (File _SetupFile) {
-      Debug.println (FLAG_CONFIG, false, Name, __func__, "Get");
-      _SetupFile.println (",\"" + String(JsonTagConfig) + "\":[");
-      _SetupFile.println ("{" + createSetupTag (FeedingHour_Name, FeedingHour_Text, FeedingHour_Comment, false, FeedingHour_Unit, FeedingHour) + "}");
-      _SetupFile.println (",{" + createSetupTag (FeedingMinute_Name, FeedingMinute_Text, FeedingMinute_Comment, false, FeedingMinute_Unit, FeedingMinute) + "}");
-      _SetupFile.println (",{" + createSetupTag (SteppsPerRotation_Name, SteppsPerRotation_Text, SteppsPerRotation_Comment, false, SteppsPerRotation_Unit, SteppsPerRotation) + "}");
-      _SetupFile.println (",{" + createSetupTag (FeedingRotations_Name, FeedingRotations_Text, FeedingRotaions_Comment, false, FeedingRotaions_Unit, FeedingRotations) + "}");
-      _SetupFile.println (",{" + createSetupTag (Acceleration_Name, Acceleration_Text, Acceleration_Comment, false, Acceleration_Unit, Acceleration) + "}");
-      _SetupFile.println (",{" + createSetupTag (MaxSpeed_Name, MaxSpeed_Text, MaxSpeed_Comment, false, MaxSpeed_Unit, MaxSpeed) + "}");
-      _SetupFile.println (",{" + createSetupTag (ConstSpeed_Name, ConstSpeed_Text, ConstSpeed_Comment, false, ConstSpeed_Unit, ConstSpeed) + "}");
-      _SetupFile.println ("]");
+    void Feeder::writeSetupConfig (JsonStream &_Setup) {
+      JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, Name, __func__, "Get");
+      _Setup.beginArray (JsonTagConfig);
+      writeSetupTags (this, Tags, TagGroup::Config, _Setup);
+      char SlotTag[JCA_FNC_FEEDER_SLOTTAG_LENGTH];
+      char SlotText[JCA_FNC_FEEDER_SLOTTAG_LENGTH];
+      for (uint8_t i = 0; i < JCA_FNC_FEEDER_SLOTS; i++) {
+        getSlotTag (SlotTag, i, SlotHour_Name);
+        getSlotText (SlotText, i, SlotHour_Text);
+        writeSetupTag (_Setup, SlotTag, SlotText, SlotHour_Comment, false, SlotHour_Unit, Slots[i].Hour);
+        getSlotTag (SlotTag, i, SlotMinute_Name);
+        getSlotText (SlotText, i, SlotMinute_Text);
+        writeSetupTag (_Setup, SlotTag, SlotText, SlotMinute_Comment, false, SlotMinute_Unit, Slots[i].Minute);
+        getSlotTag (SlotTag, i, SlotDays_Name);
+        getSlotText (SlotText, i, SlotDays_Text);
+        writeSetupTag (_Setup, SlotTag, SlotText, SlotDays_Comment, false, SlotDays_Unit, (uint16_t)Slots[i].Days);
+        getSlotTag (SlotTag, i, SlotDose_Name);
+        getSlotText (SlotText, i, SlotDose_Text);
+        writeSetupTag (_Setup, SlotTag, SlotText, SlotDose_Comment, false, SlotDose_Unit, Slots[i].Dose);
+      }
+      _Setup.endArray ();
     }
 
     /**
      * @brief Create a list of Data-Tags containing the current Value
      *
-     * @param _Tags Array the Tags have to add
+     * @param _Setup Writer inside the Element
      */
-    void Feeder::writeSetupData (File _SetupFile) {
-      Debug.println (FLAG_CONFIG, false, Name, __func__, "Get");
-      _SetupFile.println (",\"" + String(JsonTagData) + "\":[");
-      _SetupFile.println ("{" + createSetupTag (Feeding_Name, Feeding_Text, Feeding_Comment, true, Feeding_TextOn, Feeding_TextOff, Feeding) + "}");
-      _SetupFile.println (",{" + createSetupTag (DistanceToGo_Name, DistanceToGo_Text, DistanceToGo_Comment, true, DistanceToGo_Unit, Stepper.distanceToGo ()) + "}");
-      _SetupFile.println (",{" + createSetupTag (RunConst_Name, RunConst_Text, RunConst_Comment, false, RunConst_TextOn, RunConst_TextOff, RunConst) + "}");
-      _SetupFile.println (",{" + createSetupTag (Speed_Name, Speed_Text, Speed_Comment, true, Speed_Unit, Stepper.speed ()) + "}");
-      _SetupFile.println (",{" + createSetupCmdInfo (CmdDoFeed_Name, CmdDoFeed_Text, CmdDoFeed_Comment, CmdDoFeed_Type, CmdDoFeed_BtnText) + "}");
-      _SetupFile.println ("]");
+    void Feeder::writeSetupData (JsonStream &_Setup) {
+      JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, Name, __func__, "Get");
+      _Setup.beginArray (JsonTagData);
+      updateDataValues ();
+      writeSetupTags (this, Tags, TagGroup::Data, _Setup);
+      Histogram &Lateness = Generator.getLateness ();
+      char LateTag[JCA_FNC_FEEDER_SLOTTAG_LENGTH];
+      char LateText[JCA_FNC_FEEDER_SLOTTAG_LENGTH];
+      for (uint8_t i = 0; i < Lateness.size (); i++) {
+        getLateTag (LateTag, i);
+        if (i < Lateness.size () - 1) {
+          snprintf (LateText, sizeof (LateText), "%s %lu us", StepLate_Text, (unsigned long)Lateness.bound (i));
+        } else {
+          snprintf (LateText, sizeof (LateText), "%s inf", StepLate_Text);
+        }
+        writeSetupTag (_Setup, LateTag, LateText, StepLate_Comment, true, "st", Lateness.bucket (i));
+      }
+      _Setup.endArray ();
     }
 
     /**
      * @brief Create a list of Command-Informations
      *
-     * @param _Tags Array the Command-Infos have to add
+     * @param _Setup Writer inside the Element
      */
-    void Feeder::writeSetupCmdInfo (File _SetupFile) {
+    void Feeder::writeSetupCmdInfo (JsonStream &_Setup) {
     }
 
     void Feeder::createConfigValues (JsonObject &_Values) {
-      _Values[FeedingHour_Name] = FeedingHour;
-      _Values[FeedingMinute_Name] = FeedingMinute;
-      _Values[SteppsPerRotation_Name] = SteppsPerRotation;
-      _Values[FeedingRotations_Name] = FeedingRotations;
-      _Values[Acceleration_Name] = Acceleration;
-      _Values[MaxSpeed_Name] = MaxSpeed;
-      _Values[ConstSpeed_Name] = ConstSpeed;
+      createTagValues (this, Tags, TagGroup::Config, _Values);
+      // Non-const Names are copied by ArduinoJson
+      char SlotTag[JCA_FNC_FEEDER_SLOTTAG_LENGTH];
+      for (uint8_t i = 0; i < JCA_FNC_FEEDER_SLOTS; i++) {
+        getSlotTag (SlotTag, i, SlotHour_Name);
+        _Values[SlotTag] = Slots[i].Hour;
+        getSlotTag (SlotTag, i, SlotMinute_Name);
+        _Values[SlotTag] = Slots[i].Minute;
+        getSlotTag (SlotTag, i, SlotDays_Name);
+        _Values[SlotTag] = Slots[i].Days;
+        getSlotTag (SlotTag, i, SlotDose_Name);
+        _Values[SlotTag] = Slots[i].Dose;
+      }
     }
 
     void Feeder::createDataValues (JsonObject &_Values) {
-      _Values[Feeding_Name] = Feeding;
-      _Values[DistanceToGo_Name] = Stepper.distanceToGo ();
-      _Values[RunConst_Name] = RunConst;
-      _Values[Speed_Name] = Stepper.speed ();
-      _Values[CmdDoFeed_Name] = false;
+      createTagValues (this, Tags, TagGroup::Data, _Values);
+      if (ValuesSince > 0 && LateSeq <= ValuesSince) {
+        return;
+      }
+      // Non-const Names are copied by ArduinoJson
+      Histogram &Lateness = Generator.getLateness ();
+      char LateTag[JCA_FNC_FEEDER_SLOTTAG_LENGTH];
+      for (uint8_t i = 0; i < Lateness.size (); i++) {
+        getLateTag (LateTag, i);
+        if (matchPatterns (ValuesTags, LateTag)) {
+          _Values[LateTag] = Lateness.bucket (i);
+        }
+      }
+    }
+
+    void Feeder::trackChanges () {
+      updateDataValues ();
+      trackTags (this, Tags);
     }
 
     void writeSetupConfig (File _SetupFile) {
@@ -266,38 +306,253 @@ namespace JCA {
 
     }
 
+    /**
+     * @brief Compile the Acceleration-Ramp into the Interval-Table
+     * Has to be called after Acceleration or MaxSpeed is changed and no Movement is active.
+     */
+    void Feeder::buildRamp () {
+      RampDirty = false;
+      RampSteps = StepGenerator::buildRamp (Ramp, JCA_FNC_FEEDER_RAMP_SIZE, Acceleration, MaxSpeed, RampShift);
+      if (JCA_DEBUG_PRINT (FLAG_CONFIG, false, Name, __func__, "RampSteps")) {
+        JCA_DEBUG_PRINT (FLAG_CONFIG, false, Name, __func__, DebugSeparator);
+        JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, Name, __func__, RampSteps);
+      }
+    }
+
+    /**
+     * @brief Plan a new Movement relative to the current Position
+     * Stops the current Movement and pushes Acceleration, constant Speed and Deceleration
+     * as three Segments to the Generator, so the whole Movement runs inside the Interrupt.
+     * @param _Steps Steps to move, negative for backward
+     */
+    void Feeder::planMove (long _Steps) {
+      Generator.stop ();
+      if (RampDirty) {
+        buildRamp ();
+      }
+      Target = Generator.getPosition ();
+      if (MaxSpeed <= 0.0) {
+        return;
+      }
+      Target += _Steps;
+
+      bool Forward = _Steps >= 0;
+      uint32_t Steps = (uint32_t)abs (_Steps);
+      uint32_t AccelSteps = min (RampSteps, (Steps + 1) / 2);
+      uint32_t DecelSteps = min (RampSteps, Steps / 2);
+      // Segments without Steps are not queued
+      if (AccelSteps > 0) {
+        Generator.pushRamp (Ramp, RampShift, AccelSteps, true, Forward);
+      }
+      if (Steps > AccelSteps + DecelSteps) {
+        Generator.push ((uint32_t)(JCA_SYS_STEPGENERATOR_TICKS_PER_SECOND / MaxSpeed), Steps - AccelSteps - DecelSteps, Forward);
+      }
+      if (DecelSteps > 0) {
+        Generator.pushRamp (Ramp, RampShift, DecelSteps, false, Forward);
+      }
+      Generator.start ();
+    }
+
+    /**
+     * @brief Keep the Generator running with constant Speed
+     * Every Segment is about 250ms long, one Segment is queued behind the active one
+     */
+    void Feeder::planConst () {
+      float Speed = fabs (ConstSpeed);
+      if (Speed <= 0.0) {
+        Generator.stop ();
+        return;
+      }
+      if (Generator.isEmpty ()) {
+        Generator.push ((uint32_t)(JCA_SYS_STEPGENERATOR_TICKS_PER_SECOND / Speed), (uint32_t)(Speed / 4.0) + 1, ConstSpeed > 0.0);
+      }
+      Generator.start ();
+    }
+
+    /**
+     * @brief Set a Config-Tag of a Feeding-Slot
+     * Slot-Tags are named "Slot<Number><Field>", like "Slot1Hour".
+     * The old single Feeding-Time (FeedingHour, FeedingMinute) is loaded into Slot 1.
+     * @param _Tag Config-Tag
+     * @return true Tag belongs to a Slot
+     * @return false no Slot-Tag
+     */
+    bool Feeder::setSlotConfig (JsonObject &_Tag) {
+      const char *TagName = _Tag[JsonTagName].as<const char *> ();
+      if (TagName == nullptr) {
+        return false;
+      }
+      FeedingSlot *Slot = nullptr;
+      const char *Field = nullptr;
+      if (strcmp (TagName, FeedingHour_Name) == 0) {
+        Slot = &Slots[0];
+        Field = SlotHour_Name;
+      } else if (strcmp (TagName, FeedingMinute_Name) == 0) {
+        Slot = &Slots[0];
+        Field = SlotMinute_Name;
+      } else {
+        size_t PrefixLength = strlen (Slot_Name);
+        if (strncmp (TagName, Slot_Name, PrefixLength) != 0) {
+          return false;
+        }
+        uint8_t Index = TagName[PrefixLength] - '1';
+        if (Index >= JCA_FNC_FEEDER_SLOTS) {
+          return false;
+        }
+        Slot = &Slots[Index];
+        Field = &TagName[PrefixLength + 1];
+      }
+
+      if (strcmp (Field, SlotHour_Name) == 0) {
+        Slot->Hour = _Tag[JsonTagValue].as<int16_t> ();
+      } else if (strcmp (Field, SlotMinute_Name) == 0) {
+        Slot->Minute = _Tag[JsonTagValue].as<int16_t> ();
+      } else if (strcmp (Field, SlotDays_Name) == 0) {
+        Slot->Days = _Tag[JsonTagValue].as<uint8_t> () & JCA_FNC_FEEDER_DAYS_ALL;
+      } else if (strcmp (Field, SlotDose_Name) == 0) {
+        Slot->Dose = _Tag[JsonTagValue].as<float> ();
+      } else {
+        return false;
+      }
+      if (JCA_DEBUG_PRINT (FLAG_CONFIG, false, Name, __func__, TagName)) {
+        JCA_DEBUG_PRINT (FLAG_CONFIG, false, Name, __func__, DebugSeparator);
+        JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, Name, __func__, _Tag[JsonTagValue].as<String> ());
+      }
+      return true;
+    }
+
+    /**
+     * @brief Create the Tag-Name of a Slot-Field
+     *
+     * @param _Buffer Buffer for the Name (JCA_FNC_FEEDER_SLOTTAG_LENGTH)
+     * @param _Slot Slot-Index (0 based)
+     * @param _Field Field-Name, like "Hour"
+     */
+    void Feeder::getSlotTag (char *_Buffer, uint8_t _Slot, const char *_Field) {
+      snprintf (_Buffer, JCA_FNC_FEEDER_SLOTTAG_LENGTH, "%s%u%s", Slot_Name, _Slot + 1, _Field);
+    }
+
+    /**
+     * @brief Create the Tag-Name of a Lateness-Bucket
+     * Named "StepLate<Upper Bound in us>", the last Bucket is "StepLateInf"
+     * @param _Buffer Buffer for the Name (JCA_FNC_FEEDER_SLOTTAG_LENGTH)
+     * @param _Bucket Bucket-Index of the Lateness-Histogram
+     */
+    void Feeder::getLateTag (char *_Buffer, uint8_t _Bucket) {
+      Histogram &Lateness = Generator.getLateness ();
+      if (_Bucket < Lateness.size () - 1) {
+        snprintf (_Buffer, JCA_FNC_FEEDER_SLOTTAG_LENGTH, "%s%lu", StepLate_Name, (unsigned long)Lateness.bound (_Bucket));
+      } else {
+        snprintf (_Buffer, JCA_FNC_FEEDER_SLOTTAG_LENGTH, "%sInf", StepLate_Name);
+      }
+    }
+
+    /**
+     * @brief Create the Website-Text of a Slot-Field
+     *
+     * @param _Buffer Buffer for the Text (JCA_FNC_FEEDER_SLOTTAG_LENGTH)
+     * @param _Slot Slot-Index (0 based)
+     * @param _Field Field-Text, like "Stunde"
+     */
+    void Feeder::getSlotText (char *_Buffer, uint8_t _Slot, const char *_Field) {
+      snprintf (_Buffer, JCA_FNC_FEEDER_SLOTTAG_LENGTH, "%s %u %s", Slot_Text, _Slot + 1, _Field);
+    }
+
+    /**
+     * @brief Sort the active Slots by Time of Day
+     * The next due Time is recalculated on the next update.
+     */
+    void Feeder::compileSchedule () {
+      Plan.compile (Slots);
+      ScheduleDirty = true;
+    }
+
+    /**
+     * @brief Calculate the Epoch of the next due Slot
+     * Stays dirty until the Time is valid.
+     * @param _Time Current local Time
+     * @param _Now Epoch of _Time (local)
+     */
+    void Feeder::planSchedule (struct tm &_Time, time_t _Now) {
+      NextDueEpoch = 0;
+      ScheduleDirty = _Time.tm_year <= 100;
+      if (ScheduleDirty) {
+        return;
+      }
+      int32_t Delta;
+      if (Plan.next (Slots, _Time, Delta, NextSlot)) {
+        NextDueEpoch = _Now + Delta;
+      }
+    }
+
     /**
      * @brief Handling the Feeder
-     * Handling the Stepper-Functions and check if Feeding is requested
+     * Plan the Stepper-Movement and check if Feeding is requested.
+     * The Steps are output by the Timer-Interrupt of the Generator.
      * @param _Time Current Time to check automated feeding
      */
     void Feeder::update (struct tm &_Time) {
-      bool AutoFeed = FeedingHour == _Time.tm_hour && FeedingMinute == _Time.tm_min && _Time.tm_year > 100;
+      // Check the Schedule, only one Compare if nothing changed.
+      // Now is taken from the same Time as the Slot-Search, a Slot that just fired is never found again
+      struct tm Local = _Time;
+      time_t Now = mktime (&Local);
+      if (Now < LastEpoch || Now - LastEpoch > JCA_FNC_FEEDER_TIMEJUMP) {
+        ScheduleDirty = true;
+      }
+      LastEpoch = Now;
+      if (ScheduleDirty) {
+        planSchedule (_Time, Now);
+      }
+      // A due Slot waits until a running Feeding is done, it is missed during the constant Mode
+      if (NextDueEpoch > 0 && Now >= NextDueEpoch) {
+        if (RunConst || FeedPending) {
+          JCA_DEBUG_PRINTLN (FLAG_LOOP, false, Name, __func__, "Missed Feeding");
+          MissedFeedings++;
+        }
+        if (!RunConst) {
+          FeedPending = true;
+          PendingRotations = Slots[NextSlot].Dose > 0.0 ? Slots[NextSlot].Dose : FeedingRotations;
+        }
+        planSchedule (_Time, Now);
+      }
 
       // Run const Speed
       if (RunConst) {
         // Constant Mode
-        Stepper.setSpeed (ConstSpeed);
-        Stepper.runSpeed ();
+        if (Feeding) {
+          JCA_DEBUG_PRINTLN (FLAG_LOOP, false, Name, __func__, "Abort Feeding");
+          Generator.stop ();
+          Feeding = false;
+          signalChange ();
+        }
+        planConst ();
+        Target = Generator.getPosition ();
         DoFeed = false;
       } else {
         // Dosing Mode
-        if ((AutoFeed && !AutoFeedDone) || DoFeed) {
-          Debug.println (FLAG_LOOP, false, Name, __func__, "Start Feeding");
-          Stepper.move ((long)(SteppsPerRotation * FeedingRotations));
-          Stepper.enableOutputs ();
+        if ((FeedPending || DoFeed) && !Feeding) {
+          JCA_DEBUG_PRINTLN (FLAG_LOOP, false, Name, __func__, "Start Feeding");
+          float Rotations = FeedingRotations;
+          if (!DoFeed) {
+            Rotations = PendingRotations;
+            FeedPending = false;
+          }
+          Generator.resetLateness ();
+          planMove ((long)(SteppsPerRotation * Rotations));
+          Generator.enableOutputs ();
           Feeding = true;
-          DoFeed = false;
+          signalChange ();
         }
-        if (Stepper.distanceToGo () == 0 && Feeding) {
-          Debug.println (FLAG_LOOP, false, Name, __func__, "Done Feeding");
-          Stepper.disableOutputs ();
+        DoFeed = false;
+        if (Feeding && !Generator.isRunning ()) {
+          JCA_DEBUG_PRINTLN (FLAG_LOOP, false, Name, __func__, "Done Feeding");
+          Generator.disableOutputs ();
           Feeding = false;
+          signalChange ();
         }
-
-        Stepper.run ();
       }
-      AutoFeedDone = AutoFeed;
+      // Critical Section, Background-Jobs of other Elements and the Webserver wait until the Movement is done
+      setMotion (MotionPriority && (RunConst || Feeding));
     }
   }
 }
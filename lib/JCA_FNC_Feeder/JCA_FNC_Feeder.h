@@ -2,100 +2,124 @@
 #ifndef _JCA_FNC_FEEDER_
 #define _JCA_FNC_FEEDER_
 
-#include <AccelStepper.h>
 #include <ArduinoJson.h>
 #include <time.h>
 
 #include <JCA_SYS_DebugOut.h>
+#include <JCA_SYS_StepGenerator.h>
 #include <JCA_FNC_Parent.h>
+#include <JCA_FNC_Schedule.h>
+
+// Entries of the Acceleration-Ramp, longer Ramps use one Entry for multiple Steps
+#define JCA_FNC_FEEDER_RAMP_SIZE 256
+// Clock changes bigger than this (s) reschedule instead of feeding missed Slots
+#define JCA_FNC_FEEDER_TIMEJUMP 60
+// Length of generated Slot- and Lateness-Tag Names and Texts
+#define JCA_FNC_FEEDER_SLOTTAG_LENGTH 40
 
 namespace JCA {
   namespace FNC {
     class Feeder : public Protocol{
     private:
-      // Protocol Datapoint description
+      // Protocol Datapoint description, Slot-Tags are generated
       static const char *FeedingHour_Name;
-      static const char *FeedingHour_Text;
-      static const char *FeedingHour_Unit;
-      static const char *FeedingHour_Comment;
       static const char *FeedingMinute_Name;
-      static const char *FeedingMinute_Text;
-      static const char *FeedingMinute_Unit;
-      static const char *FeedingMinute_Comment;
-      static const char *SteppsPerRotation_Name;
-      static const char *SteppsPerRotation_Text;
-      static const char *SteppsPerRotation_Unit;
-      static const char *SteppsPerRotation_Comment;
-      static const char *FeedingRotations_Name;
-      static const char *FeedingRotations_Text;
-      static const char *FeedingRotaions_Unit;
-      static const char *FeedingRotaions_Comment;
-      static const char *Acceleration_Name;
-      static const char *Acceleration_Text;
-      static const char *Acceleration_Unit;
-      static const char *Acceleration_Comment;
-      static const char *MaxSpeed_Name;
-      static const char *MaxSpeed_Text;
-      static const char *MaxSpeed_Unit;
-      static const char *MaxSpeed_Comment;
-      static const char *ConstSpeed_Name;
-      static const char *ConstSpeed_Text;
-      static const char *ConstSpeed_Unit;
-      static const char *ConstSpeed_Comment;
-      static const char *Feeding_Name;
-      static const char *Feeding_Text;
-      static const char *Feeding_Comment;
-      static const char *Feeding_TextOn;
-      static const char *Feeding_TextOff;
-      static const char *DistanceToGo_Name;
-      static const char *DistanceToGo_Text;
-      static const char *DistanceToGo_Unit;
-      static const char *DistanceToGo_Comment;
-      static const char *RunConst_Name;
-      static const char *RunConst_Text;
-      static const char *RunConst_Comment;
-      static const char *RunConst_TextOn;
-      static const char *RunConst_TextOff;
-      static const char *Speed_Name;
-      static const char *Speed_Text;
-      static const char *Speed_Unit;
-      static const char *Speed_Comment;
-      static const char *CmdDoFeed_Name;
-      static const char *CmdDoFeed_Text;
-      static const char *CmdDoFeed_Comment;
-      static const char *CmdDoFeed_Type;
-      static const char *CmdDoFeed_BtnText;
-      
+      static const char *Slot_Name;
+      static const char *Slot_Text;
+      static const char *SlotHour_Name;
+      static const char *SlotHour_Text;
+      static const char *SlotHour_Unit;
+      static const char *SlotHour_Comment;
+      static const char *SlotMinute_Name;
+      static const char *SlotMinute_Text;
+      static const char *SlotMinute_Unit;
+      static const char *SlotMinute_Comment;
+      static const char *SlotDays_Name;
+      static const char *SlotDays_Text;
+      static const char *SlotDays_Unit;
+      static const char *SlotDays_Comment;
+      static const char *SlotDose_Name;
+      static const char *SlotDose_Text;
+      static const char *SlotDose_Unit;
+      static const char *SlotDose_Comment;
+      static const char *StepLate_Name;
+      static const char *StepLate_Text;
+      static const char *StepLate_Comment;
+      static const TagDescriptor<Feeder> Tags[];
+
       // Protocol Functions
       void createConfigValues (JsonObject &_Values);
       void createDataValues (JsonObject &_Values);
+      void trackChanges ();
       void setConfig (JsonArray _Tags);
       void setData (JsonArray _Tags);
       void setCmd (JsonArray _Tags);
 
-      void writeSetupConfig (File _SetupFile);
-      void writeSetupData (File _SetupFile);
-      void writeSetupCmdInfo (File _SetupFile);
+      void writeSetupConfig (JCA::SYS::JsonStream &_Setup);
+      void writeSetupData (JCA::SYS::JsonStream &_Setup);
+      void writeSetupCmdInfo (JCA::SYS::JsonStream &_Setup);
 
       // Hardware
-      AccelStepper Stepper;
+      JCA::SYS::StepGenerator Generator;
 
       // Konfig
-      int16_t FeedingHour;
-      int16_t FeedingMinute;
+      FeedingSlot Slots[JCA_FNC_FEEDER_SLOTS];
       float SteppsPerRotation;
       float FeedingRotations;
       float Acceleration;
       float MaxSpeed;
       float ConstSpeed;
+      bool MotionPriority;
 
       // Daten
       bool RunConst;
       bool Feeding;
+      int32_t DistanceToGo;
+      float Speed;
+      uint32_t StepLateness;
+      uint32_t MissedSteps;
+      uint32_t MissedFeedings;
 
       // Intern
       bool DoFeed;
-      bool AutoFeedDone;
+      bool FeedPending;
+      float PendingRotations;
+      uint32_t LateSteps;
+      uint32_t LateSeq;
+      int32_t Target;
+
+      // Schedule, Slot-Indexes sorted by Time of Day
+      Schedule Plan;
+      uint8_t NextSlot;
+      time_t NextDueEpoch;
+      time_t LastEpoch;
+      bool ScheduleDirty;
+
+      // Acceleration-Ramp, Intervals in Generator-Ticks
+      uint32_t Ramp[JCA_FNC_FEEDER_RAMP_SIZE];
+      uint32_t RampSteps;
+      uint8_t RampShift;
+      bool RampDirty;
+
+      // Tag Events
+      void onRampChanged ();
+      void onConstSpeedChanged ();
+      void onRunConstChanged ();
+      void doFeedCmd (JsonVariant _Value);
+      void updateDataValues ();
+
+      // Movement Planning
+      void buildRamp ();
+      void planMove (long _Steps);
+      void planConst ();
+
+      // Feeding Schedule
+      bool setSlotConfig (JsonObject &_Tag);
+      void getSlotTag (char *_Buffer, uint8_t _Slot, const char *_Field);
+      void getSlotText (char *_Buffer, uint8_t _Slot, const char *_Field);
+      void getLateTag (char *_Buffer, uint8_t _Bucket);
+      void compileSchedule ();
+      void planSchedule (struct tm &_Time, time_t _Now);
 
     public:
       Feeder (uint8_t _PinEnable, uint8_t _PinStep, uint8_t _PinDir, const char *_Name);
@@ -18,9 +18,20 @@ namespace JCA {
     const char *Protocol::JsonTagOff = "off";
     const char *Protocol::JsonTagType = "type";
     const char *Protocol::JsonTagReadOnly = "readOnly";
+    const char *Protocol::JsonTagSequence = "seq";
+    const char *Protocol::JsonTagSubscribe = "subscribe";
+    const char *Protocol::JsonTagGroups = "groups";
+    const char *Protocol::JsonTagTags = "tags";
     const char *Protocol::BtnOnDefault = "ON";
     const char *Protocol::BtnOffDefault = "OFF";
     const char *Protocol::DebugSeparator = " - ";
+    Protocol *Protocol::Elements[JCA_FNC_PROTOCOL_MAXELEMENTS];
+    Protocol *Protocol::Index[JCA_FNC_PROTOCOL_MAXELEMENTS];
+    uint8_t Protocol::ElementCount = 0;
+    uint32_t Protocol::Sequence = 1;
+    bool Protocol::ChangeSignaled = false;
+    uint8_t Protocol::MotionCount = 0;
+    ProfileCallback Protocol::Profiler = nullptr;
     
     /**
      * @brief Construct a new Protocol::Protocol object
@@ -31,6 +42,19 @@ namespace JCA {
     Protocol::Protocol (String _Name, String _Comment) {
       Name = _Name;
       Comment = _Comment;
+      NameHash = tagHash (Name.c_str ());
+      ConfigSeq = 0;
+      DataSeq = 0;
+      ValuesSince = 0;
+      memset (DataStates, 0, sizeof (DataStates));
+      Moving = false;
+      TagsFound = 0;
+      Runs = 0;
+      Misses = 0;
+      Overruns = 0;
+      MaxRunTime = 0;
+      setSchedule (0, TaskPriority::Normal);
+      registerElement ();
     }
 
     /**
@@ -42,130 +66,305 @@ namespace JCA {
     }
 
     /**
-     * @brief Search the Config-Block ("config": []) of the Element
-     * The Functions first search the Element inside the Elements-Array by Name,
-     * Then returns the Config-Tags Array if extist
-     * @param _Elements Array of Elements ("elements": [])
-     * @return JsonVariant if not found returns an empty Variant
+     * @brief Add the Element to the Router
+     * The Index is kept sorted by Name-Hash with Insertion-Sort,
+     * Elements are created once on Startup so the Cost is only on Construction.
      */
-    JsonVariant Protocol::findConfig (JsonArray &_Elements) {
-      Debug.println (FLAG_PROTOCOL, true, Name, __func__, "Start");
-      for (JsonObject Element : _Elements) {
-        if (Element[JsonTagName] == Name) {
-          if (Element.containsKey (JsonTagConfig)) {
-            return Element[JsonTagConfig];
-          }
-        }
+    void Protocol::registerElement () {
+      if (ElementCount >= JCA_FNC_PROTOCOL_MAXELEMENTS) {
+        return;
       }
-      return JsonVariant ();
+      Elements[ElementCount] = this;
+      uint8_t Pos = ElementCount;
+      while (Pos > 0 && Index[Pos - 1]->NameHash > NameHash) {
+        Index[Pos] = Index[Pos - 1];
+        Pos--;
+      }
+      Index[Pos] = this;
+      ElementCount++;
     }
 
     /**
-     * @brief Search the Data-Block ("data": []) of the Element
-     * The Functions first search the Element inside the Elements-Array by Name,
-     * Then returns the Data-Tags Array if extist
-     * @param _Elements Array of Elements ("elements": [])
-     * @return JsonVariant if not found returns an empty Variant
+     * @brief Set Period, Priority and Budget of the Element, the Element is due immediately
+     *
+     * @param _Period Time between two Updates in ms, 0 updates the Element in every Pass
+     * @param _Priority Order of the Elements inside a Pass
+     * @param _Budget Run-Time of one Update in us, longer Updates count as Overrun
      */
-    JsonVariant Protocol::findData (JsonArray &_Elements) {
-      Debug.println (FLAG_PROTOCOL, true, Name, __func__, "Start");
-      for (JsonObject Element : _Elements) {
-        if (Element[JsonTagName] == Name) {
-          if (Element.containsKey (JsonTagData)) {
-            return Element[JsonTagData];
+    void Protocol::setSchedule (uint32_t _Period, TaskPriority _Priority, uint32_t _Budget) {
+      Period = _Period;
+      Priority = _Priority;
+      Budget = _Budget;
+      Deadline = millis ();
+    }
+
+    /**
+     * @brief Change the Period, like after a Config-Change
+     * The next Deadline is kept
+     * @param _Period Time between two Updates in ms, 0 updates the Element in every Pass
+     */
+    void Protocol::setPeriod (uint32_t _Period) {
+      Period = _Period;
+    }
+
+    /**
+     * @brief Set the next Deadline, overrides the Period for the next Update
+     * Called inside update(), like to wait for a Conversion
+     * @param _Delay Time until the next Update in ms
+     */
+    void Protocol::setDeadline (uint32_t _Delay) {
+      Deadline = millis () + _Delay;
+    }
+
+    /**
+     * @brief Update all due Elements
+     * Due Elements are sorted by Priority and Deadline, Elements below Critical Priority
+     * wait for the next Pass if the Pass is over JCA_FNC_PROTOCOL_PASSBUDGET.
+     * Elements late by a whole Period are promoted one Priority per Period (up to High),
+     * and the first due Element below Critical runs in every Pass, so Low Elements can not starve.
+     * @param _Time Current Time
+     */
+    void Protocol::updateAll (struct tm &_Time) {
+      Protocol *Due[JCA_FNC_PROTOCOL_MAXELEMENTS];
+      uint8_t Rank[JCA_FNC_PROTOCOL_MAXELEMENTS];
+      uint8_t DueCount = 0;
+      uint32_t ActMillis = millis ();
+      for (uint8_t i = 0; i < ElementCount; i++) {
+        Protocol *Element = Elements[i];
+        if ((int32_t)(ActMillis - Element->Deadline) < 0) {
+          continue;
+        }
+        // Deadline-Aging
+        uint8_t ElementRank = (uint8_t)Element->Priority;
+        if (Element->Priority != TaskPriority::Critical && Element->Period > 0) {
+          uint32_t Periods = (ActMillis - Element->Deadline) / Element->Period;
+          ElementRank = min ((uint32_t)TaskPriority::High, ElementRank + Periods);
+        }
+        uint8_t Pos = DueCount;
+        while (Pos > 0 && (Rank[Pos - 1] < ElementRank || (Rank[Pos - 1] == ElementRank && (int32_t)(Due[Pos - 1]->Deadline - Element->Deadline) > 0))) {
+          Due[Pos] = Due[Pos - 1];
+          Rank[Pos] = Rank[Pos - 1];
+          Pos--;
+        }
+        Due[Pos] = Element;
+        Rank[Pos] = ElementRank;
+        DueCount++;
+      }
+      uint32_t PassStart = micros ();
+      bool RanNonCritical = false;
+      for (uint8_t i = 0; i < DueCount; i++) {
+        // Sorted by Priority, all following Elements are also below Critical
+        if (Due[i]->Priority != TaskPriority::Critical) {
+          if (RanNonCritical && micros () - PassStart > JCA_FNC_PROTOCOL_PASSBUDGET) {
+            break;
           }
+          RanNonCritical = true;
         }
+        Due[i]->run (_Time);
       }
-      return JsonVariant ();
     }
 
     /**
-     * @brief Search the Command-Block ("cmd": []) of the Element
-     * The Functions first search the Element inside the Elements-Array by Name,
-     * Then returns the Command-Tags Array if extist
-     * @param _Elements Array of Elements ("elements": [])
-     * @return JsonVariant if not found returns an empty Variant
+     * @brief Update the Element and track Deadline and Run-Time
+     * Missed Periods are skipped, the next Deadline is set before update() to allow an Override.
+     * The Run-Time is measured with the CPU-Cycle-Counter and passed to the Profiler.
+     * @param _Time Current Time
      */
-    JsonVariant Protocol::findCmd (JsonArray &_Elements) {
-      Debug.println (FLAG_PROTOCOL, true, Name, __func__, "Start");
-      for (JsonObject Element : _Elements) {
-        if (Element[JsonTagName] == Name) {
-          if (Element.containsKey (JsonTagCmd)) {
-            return Element[JsonTagCmd];
-          }
+    void Protocol::run (struct tm &_Time) {
+      uint32_t ActMillis = millis ();
+      if (ActMillis - Deadline > JCA_FNC_PROTOCOL_DEADLINE_SLACK) {
+        Misses++;
+      }
+      Deadline += Period;
+      if ((int32_t)(ActMillis - Deadline) >= 0) {
+        Deadline = ActMillis + Period;
+      }
+      uint32_t Start = ESP.getCycleCount ();
+      update (_Time);
+      uint32_t Cycles = ESP.getCycleCount () - Start;
+      uint32_t RunTime = Cycles / ESP.getCpuFreqMHz ();
+      if (Profiler != nullptr) {
+        Profiler (Name.c_str (), Cycles);
+      }
+      Runs++;
+      if (RunTime > MaxRunTime) {
+        MaxRunTime = RunTime;
+      }
+      if (RunTime > Budget) {
+        Overruns++;
+      }
+    }
+
+    /**
+     * @brief Search an Element by Name
+     * Binary Search on the Hash-Index, the Name is compared to exclude Collisions
+     * @param _Name Element Name inside the Communication
+     * @return Protocol* Element, nullptr if not found
+     */
+    Protocol *Protocol::findElement (const char *_Name) {
+      uint32_t Hash = tagHash (_Name);
+      uint8_t Low = 0;
+      uint8_t High = ElementCount;
+      while (Low < High) {
+        uint8_t Mid = (Low + High) / 2;
+        if (Index[Mid]->NameHash < Hash) {
+          Low = Mid + 1;
+        } else {
+          High = Mid;
+        }
+      }
+      for (; Low < ElementCount && Index[Low]->NameHash == Hash; Low++) {
+        if (strcmp (Index[Low]->Name.c_str (), _Name) == 0) {
+          return Index[Low];
         }
       }
-      return JsonVariant ();
+      return nullptr;
     }
 
-    String Protocol::createDefaultTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly) {
-      String SetupTag;
-      SetupTag += "\"" + String(JsonTagName) + "\":\"" + String(_Name) + "\"";
-      SetupTag += ",\"" + String(JsonTagText) + "\":\"" + String(_Text) + "\"";
-      if (_Comment != nullptr) {
-        SetupTag += ",\"" + String(JsonTagComment) + "\":\"" + String(_Comment) + "\"";
+    /**
+     * @brief Pass the Tag-Arrays of an Element-Object to the Element
+     *
+     * @param _Element Element-Object ({"name":..., "config":[], "data":[], "cmd":[]})
+     * @return uint16_t Number of Tags found in the Descriptor-Table
+     */
+    uint16_t Protocol::dispatch (JsonObject &_Element) {
+      JCA_DEBUG_PRINTLN (FLAG_PROTOCOL, true, Name, __func__, "Start");
+      TagsFound = 0;
+      JsonVariant Tags;
+      Tags = _Element[JsonTagConfig];
+      if (Tags.is<JsonArray> ()) {
+        setConfig (Tags.as<JsonArray> ());
+        configChanged ();
+      }
+      Tags = _Element[JsonTagData];
+      if (Tags.is<JsonArray> ()) {
+        setData (Tags.as<JsonArray> ());
+      }
+      Tags = _Element[JsonTagCmd];
+      if (Tags.is<JsonArray> ()) {
+        setCmd (Tags.as<JsonArray> ());
+      }
+      signalChange ();
+      return TagsFound;
+    }
+
+    /**
+     * @brief Mark the Config of the Element as changed
+     * The Config-Block is sent complete to all Clients on the next Update
+     */
+    void Protocol::configChanged () {
+      ConfigSeq = ++Sequence;
+      signalChange ();
+    }
+
+    /**
+     * @brief Signal an important Change (State, Alarm, Command)
+     * The Values are pushed to the Clients without waiting for the next Update-Cycle
+     */
+    void Protocol::signalChange () {
+      ChangeSignaled = true;
+    }
+
+    /**
+     * @brief Check and reset the Change-Signal of all Elements
+     *
+     * @return true An Element has signaled a Change since the last Call
+     * @return false Nothing signaled
+     */
+    bool Protocol::takeChangeSignal () {
+      bool Signaled = ChangeSignaled;
+      ChangeSignaled = false;
+      return Signaled;
+    }
+
+    /**
+     * @brief Set the Motion-State of the Element
+     * Timing-critical Hardware is moving, other Elements and Services should reduce their Load.
+     * The moving Elements are counted, the Debug-Output is held and a Change is signaled
+     * when the first Element starts and when the last Element stops.
+     * @param _Active Hardware of the Element is moving
+     */
+    void Protocol::setMotion (bool _Active) {
+      if (Moving == _Active) {
+        return;
+      }
+      Moving = _Active;
+      if (_Active) {
+        MotionCount++;
+      } else if (MotionCount > 0) {
+        MotionCount--;
+      }
+      if (MotionCount == (_Active ? 1 : 0)) {
+        JCA::SYS::Debug.hold (_Active);
+        signalChange ();
       }
-      SetupTag += ",\"" + String(JsonTagReadOnly) + "\":" + String(_ReadOnly);
-      return SetupTag;
     }
 
     /**
-     * @brief Add a bool-/Button-Tag to the Array
-     * use createEmptyTag to create the Body and attach the Button-Information
-     * @param _Tags Array of Tags like Data ("data": []) or Config
+     * @brief Check if timing-critical Hardware is moving
+     *
+     * @return true an Element is moving
+     * @return false all Elements are idle
+     */
+    bool Protocol::inMotion () {
+      return MotionCount > 0;
+    }
+
+    /**
+     * @brief Check if a Job has to wait for the Movement
+     * A Movement can run for an unlimited Time (constant Rotation), so the Job is only deferred
+     * until its last Run is JCA_FNC_PROTOCOL_MOTIONHOLD ago, then it runs with this slow Rate.
+     * @param _LastRun Time of the last Run of the Job (millis)
+     * @return true Job has to wait
+     * @return false Job can run
+     */
+    bool Protocol::deferForMotion (uint32_t _LastRun) {
+      return MotionCount > 0 && millis () - _LastRun < JCA_FNC_PROTOCOL_MOTIONHOLD;
+    }
+
+    /**
+     * @brief Open a Tag-Object and write the common Information
+     * The Caller adds the Value and closes the Object
+     * @param _Setup Writer inside a Tag-Array
      * @param _Name Name of the Tag to add
      * @param _Text Text for Website Lable
      * @param _Comment Comment, if not used set nullptr
      * @param _ReadOnly Disable Input on Website
-     * @param _BtnOnText Buttontext if Value is True, if not defined (nullptr) set to "ON"
-     * @param _BntOffText Buttontext if Value is False, if not defined (nullptr) set to "OFF"
-     * @param _Value Current value of the Tag
      */
-    String Protocol::createSetupTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_BtnOnText, const char *_BtnOffText, bool _Value) {
-      String SetupTag = createDefaultTag (_Name, _Text, _Comment, _ReadOnly);
-      if (_BtnOnText != nullptr) {
-        SetupTag += ",\"" + String(JsonTagOn) + "\":\"" + String(_BtnOnText) + "\"";
-      } else {
-        SetupTag += ",\"" + String(JsonTagOn) + "\":\"" + String(BtnOnDefault) + "\"";
-      }
-      if (_BtnOffText != nullptr) {
-        SetupTag += ",\"" + String(JsonTagOff) + "\":\"" + String(_BtnOffText) + "\"";
-      } else {
-        SetupTag += ",\"" + String(JsonTagOff) + "\":\"" + String(BtnOffDefault) + "\"";
-      }
-      SetupTag += ",\"" + String(JsonTagValue) + "\":";
-      if (_Value) {
-        SetupTag += "true";
-      } else {
-        SetupTag += "false";
+    void Protocol::writeDefaultTag (JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly) {
+      _Setup.beginObject ();
+      _Setup.add (JsonTagName, _Name);
+      _Setup.add (JsonTagText, _Text);
+      if (_Comment != nullptr) {
+        _Setup.add (JsonTagComment, _Comment);
       }
-      return SetupTag;
+      _Setup.add (JsonTagReadOnly, _ReadOnly);
     }
 
     /**
-     * @brief Add a Value-Tag to the Array
-     * use createEmptyTag to create the Body and attach the Value-Information
-     * @param _Tags Array of Tags like Data ("data": []) or Config
+     * @brief Add a bool-/Button-Tag to the Setup
+     * use writeDefaultTag to create the Body and attach the Button-Information
+     * @param _Setup Writer inside a Tag-Array like Data ("data": []) or Config
      * @param _Name Name of the Tag to add
      * @param _Text Text for Website Lable
      * @param _Comment Comment, if not used set nullptr
      * @param _ReadOnly Disable Input on Website
-     * @param _Unit Unit, if not used set nullptr
+     * @param _BtnOnText Buttontext if Value is True, if not defined (nullptr) set to "ON"
+     * @param _BntOffText Buttontext if Value is False, if not defined (nullptr) set to "OFF"
      * @param _Value Current value of the Tag
      */
-    String Protocol::createSetupTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, float _Value) {
-      String SetupTag = createDefaultTag (_Name, _Text, _Comment, _ReadOnly);
-      if (_Unit != nullptr) {
-        SetupTag += ",\"" + String(JsonTagUnit) + "\":\"" + String(_Unit) + "\"";
-      }
-      SetupTag += ",\"" + String(JsonTagValue) + "\":" + String(_Value);
-      return SetupTag;
+    void Protocol::writeSetupTag (JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_BtnOnText, const char *_BtnOffText, bool _Value) {
+      writeDefaultTag (_Setup, _Name, _Text, _Comment, _ReadOnly);
+      _Setup.add (JsonTagOn, _BtnOnText != nullptr ? _BtnOnText : BtnOnDefault);
+      _Setup.add (JsonTagOff, _BtnOffText != nullptr ? _BtnOffText : BtnOffDefault);
+      _Setup.add (JsonTagValue, _Value);
+      _Setup.endObject ();
     }
 
     /**
-     * @brief Add a Value-Tag to the Array
-     * use createEmptyTag to create the Body and attach the Value-Information
-     * @param _Tags Array of Tags like Data ("data": []) or Config
+     * @brief Add a Value-Tag to the Setup
+     * use writeDefaultTag to create the Body and attach the Value-Information
+     * @param _Setup Writer inside a Tag-Array like Data ("data": []) or Config
      * @param _Name Name of the Tag to add
      * @param _Text Text for Website Lable
      * @param _Comment Comment, if not used set nullptr
@@ -173,19 +372,19 @@ namespace JCA {
      * @param _Unit Unit, if not used set nullptr
      * @param _Value Current value of the Tag
      */
-    String Protocol::createSetupTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, int16_t _Value) {
-      String SetupTag = createDefaultTag (_Name, _Text, _Comment, _ReadOnly);
+    void Protocol::writeSetupTag (JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, float _Value) {
+      writeDefaultTag (_Setup, _Name, _Text, _Comment, _ReadOnly);
       if (_Unit != nullptr) {
-        SetupTag += ",\"" + String(JsonTagUnit) + "\":\"" + String(_Unit) + "\"";
+        _Setup.add (JsonTagUnit, _Unit);
       }
-      SetupTag += ",\"" + String(JsonTagValue) + "\":" + String(_Value);
-      return SetupTag;
+      _Setup.add (JsonTagValue, (double)_Value);
+      _Setup.endObject ();
     }
 
     /**
-     * @brief Add a Value-Tag to the Array
-     * use createEmptyTag to create the Body and attach the Value-Information
-     * @param _Tags Array of Tags like Data ("data": []) or Config
+     * @brief Add a Value-Tag to the Setup
+     * use writeDefaultTag to create the Body and attach the Value-Information
+     * @param _Setup Writer inside a Tag-Array like Data ("data": []) or Config
      * @param _Name Name of the Tag to add
      * @param _Text Text for Website Lable
      * @param _Comment Comment, if not used set nullptr
@@ -193,19 +392,19 @@ namespace JCA {
      * @param _Unit Unit, if not used set nullptr
      * @param _Value Current value of the Tag
      */
-    String Protocol::createSetupTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, uint16_t _Value) {
-      String SetupTag = createDefaultTag (_Name, _Text, _Comment, _ReadOnly);
+    void Protocol::writeSetupTag (JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, int16_t _Value) {
+      writeDefaultTag (_Setup, _Name, _Text, _Comment, _ReadOnly);
       if (_Unit != nullptr) {
-        SetupTag += ",\"" + String(JsonTagUnit) + "\":\"" + String(_Unit) + "\"";
+        _Setup.add (JsonTagUnit, _Unit);
       }
-      SetupTag += ",\"" + String(JsonTagValue) + "\":" + String(_Value);
-      return SetupTag;
+      _Setup.add (JsonTagValue, (int)_Value);
+      _Setup.endObject ();
     }
 
     /**
-     * @brief Add a Value-Tag to the Array
-     * use createEmptyTag to create the Body and attach the Value-Information
-     * @param _Tags Array of Tags like Data ("data": []) or Config
+     * @brief Add a Value-Tag to the Setup
+     * use writeDefaultTag to create the Body and attach the Value-Information
+     * @param _Setup Writer inside a Tag-Array like Data ("data": []) or Config
      * @param _Name Name of the Tag to add
      * @param _Text Text for Website Lable
      * @param _Comment Comment, if not used set nullptr
@@ -213,19 +412,19 @@ namespace JCA {
      * @param _Unit Unit, if not used set nullptr
      * @param _Value Current value of the Tag
      */
-    String Protocol::createSetupTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, int32_t _Value) {
-      String SetupTag = createDefaultTag (_Name, _Text, _Comment, _ReadOnly);
+    void Protocol::writeSetupTag (JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, uint16_t _Value) {
+      writeDefaultTag (_Setup, _Name, _Text, _Comment, _ReadOnly);
       if (_Unit != nullptr) {
-        SetupTag += ",\"" + String(JsonTagUnit) + "\":\"" + String(_Unit) + "\"";
+        _Setup.add (JsonTagUnit, _Unit);
       }
-      SetupTag += ",\"" + String(JsonTagValue) + "\":" + String(_Value);
-      return SetupTag;
+      _Setup.add (JsonTagValue, (unsigned int)_Value);
+      _Setup.endObject ();
     }
 
     /**
-     * @brief Add a Value-Tag to the Array
-     * use createEmptyTag to create the Body and attach the Value-Information
-     * @param _Tags Array of Tags like Data ("data": []) or Config
+     * @brief Add a Value-Tag to the Setup
+     * use writeDefaultTag to create the Body and attach the Value-Information
+     * @param _Setup Writer inside a Tag-Array like Data ("data": []) or Config
      * @param _Name Name of the Tag to add
      * @param _Text Text for Website Lable
      * @param _Comment Comment, if not used set nullptr
@@ -233,19 +432,19 @@ namespace JCA {
      * @param _Unit Unit, if not used set nullptr
      * @param _Value Current value of the Tag
      */
-    String Protocol::createSetupTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, uint32_t _Value) {
-      String SetupTag = createDefaultTag (_Name, _Text, _Comment, _ReadOnly);
+    void Protocol::writeSetupTag (JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, int32_t _Value) {
+      writeDefaultTag (_Setup, _Name, _Text, _Comment, _ReadOnly);
       if (_Unit != nullptr) {
-        SetupTag += ",\"" + String(JsonTagUnit) + "\":\"" + String(_Unit) + "\"";
+        _Setup.add (JsonTagUnit, _Unit);
       }
-      SetupTag += ",\"" + String(JsonTagValue) + "\":" + String(_Value);
-      return SetupTag;
+      _Setup.add (JsonTagValue, (long)_Value);
+      _Setup.endObject ();
     }
 
     /**
-     * @brief Add a Value-Tag to the Array
-     * use createEmptyTag to create the Body and attach the Value-Information
-     * @param _Tags Array of Tags like Data ("data": []) or Config
+     * @brief Add a Value-Tag to the Setup
+     * use writeDefaultTag to create the Body and attach the Value-Information
+     * @param _Setup Writer inside a Tag-Array like Data ("data": []) or Config
      * @param _Name Name of the Tag to add
      * @param _Text Text for Website Lable
      * @param _Comment Comment, if not used set nullptr
@@ -253,127 +452,316 @@ namespace JCA {
      * @param _Unit Unit, if not used set nullptr
      * @param _Value Current value of the Tag
      */
-    String Protocol::createSetupTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, long _Value) {
-      String SetupTag = createDefaultTag (_Name, _Text, _Comment, _ReadOnly);
+    void Protocol::writeSetupTag (JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, uint32_t _Value) {
+      writeDefaultTag (_Setup, _Name, _Text, _Comment, _ReadOnly);
       if (_Unit != nullptr) {
-        SetupTag += ",\"" + String(JsonTagUnit) + "\":\"" + String(_Unit) + "\"";
+        _Setup.add (JsonTagUnit, _Unit);
       }
-      SetupTag += ",\"" + String(JsonTagValue) + "\":" + String(_Value);
-      return SetupTag;
+      _Setup.add (JsonTagValue, (unsigned long)_Value);
+      _Setup.endObject ();
     }
 
     /**
-     * @brief Add a String-Tag to the Array
-     * use createEmptyTag to create the Body and attach the String
-     * @param _Tags Array of Tags like Data ("data": []) or Config
+     * @brief Add a Value-Tag to the Setup
+     * use writeDefaultTag to create the Body and attach the Value-Information
+     * @param _Setup Writer inside a Tag-Array like Data ("data": []) or Config
      * @param _Name Name of the Tag to add
      * @param _Text Text for Website Lable
      * @param _Comment Comment, if not used set nullptr
      * @param _ReadOnly Disable Input on Website
+     * @param _Unit Unit, if not used set nullptr
      * @param _Value Current value of the Tag
      */
-    String Protocol::createSetupTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, String _Value) {
-      String SetupTag = createDefaultTag (_Name, _Text, _Comment, _ReadOnly);
-      SetupTag += ",\"" + String(JsonTagValue) + "\":\"" + _Value + "\"";
-      return SetupTag;
+    void Protocol::writeSetupTag (JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, long _Value) {
+      writeDefaultTag (_Setup, _Name, _Text, _Comment, _ReadOnly);
+      if (_Unit != nullptr) {
+        _Setup.add (JsonTagUnit, _Unit);
+      }
+      _Setup.add (JsonTagValue, _Value);
+      _Setup.endObject ();
     }
 
     /**
-     * @brief Add a String-Tag to the Array
-     * use createEmptyTag to create the Body and attach the String
-     * @param _Tags Array of Tags like Data ("data": []) or Config
+     * @brief Add a String-Tag to the Setup
+     * use writeDefaultTag to create the Body and attach the String
+     * @param _Setup Writer inside a Tag-Array like Data ("data": []) or Config
      * @param _Name Name of the Tag to add
      * @param _Text Text for Website Lable
      * @param _Comment Comment, if not used set nullptr
      * @param _ReadOnly Disable Input on Website
      * @param _Value Current value of the Tag
      */
-    String Protocol::createSetupTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Value) {
-      String SetupTag = createDefaultTag (_Name, _Text, _Comment, _ReadOnly);
-      SetupTag += ",\"" + String(JsonTagValue) + "\":\"" + String(_Value) + "\"";
-      return SetupTag;
+    void Protocol::writeSetupTag (JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const String &_Value) {
+      writeSetupTag (_Setup, _Name, _Text, _Comment, _ReadOnly, _Value.c_str ());
     }
 
     /**
-     * @brief Add a Command-Info-Tag to the Array
-     * use createEmptyTag to create the Body and attach the String
-     * @param _Tags Array of Command-Inormations ("cmdInfo": [])
-     * @param _Name Name of the Command
+     * @brief Add a String-Tag to the Setup
+     * use writeDefaultTag to create the Body and attach the String
+     * @param _Setup Writer inside a Tag-Array like Data ("data": []) or Config
+     * @param _Name Name of the Tag to add
      * @param _Text Text for Website Lable
      * @param _Comment Comment, if not used set nullptr
-     * @param _Type Type for the HMI to know what ist requested (boot, in16, string, ...)
+     * @param _ReadOnly Disable Input on Website
+     * @param _Value Current value of the Tag
      */
-    String Protocol::createSetupCmdInfo (const char *_Name, const char *_Text, const char *_Comment, const char *_Type) {
-      String SetupTag = createDefaultTag (_Name, _Text, _Comment, false);
-      SetupTag += ",\"" + String(JsonTagType) + "\":\"" + String(_Type) + "\"";
-      return SetupTag;
+    void Protocol::writeSetupTag (JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Value) {
+      writeDefaultTag (_Setup, _Name, _Text, _Comment, _ReadOnly);
+      _Setup.add (JsonTagValue, _Value);
+      _Setup.endObject ();
     }
 
     /**
-     * @brief Add a Button-Command-Info to the Array
+     * @brief Add a Command-Info-Tag to the Setup
      * contains additional Information for Button dynamic
-     * @param _Tags Array of Command-Inormations ("cmdInfo": [])
+     * @param _Setup Writer inside the Command-Array ("cmdInfo": [])
      * @param _Name Name of the Command
      * @param _Text Text for Website Lable
      * @param _Comment Comment, if not used set nullptr
-     * @param _Type sould be bool
-     * @param _BtnText Buttontext, if not defined (nullptr) set to "ON"
+     * @param _Type Type for the HMI to know what ist requested (boot, in16, string, ...)
+     * @param _BtnText Buttontext, if not used set nullptr
      */
-    String Protocol::createSetupCmdInfo (const char *_Name, const char *_Text, const char *_Comment, const char *_Type, const char *_BtnText) {
-      String SetupTag = createDefaultTag (_Name, _Text, _Comment, false);
+    void Protocol::writeSetupCmdTag (JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, const char *_Type, const char *_BtnText) {
+      writeDefaultTag (_Setup, _Name, _Text, _Comment, false);
       if (_BtnText != nullptr) {
-        SetupTag += ",\"" + String(JsonTagOff) + "\":\"" + String(_BtnText) + "\"";
+        _Setup.add (JsonTagOff, _BtnText);
       }
-      SetupTag += ",\"" + String(JsonTagType) + "\":\"" + String(_Type) + "\"";
-      return SetupTag;
+      _Setup.add (JsonTagType, _Type);
+      _Setup.endObject ();
     }
 
     /**
      * @brief Set Data, Config and execute Commands
-     * Check if the Element in the Array and pass the Tag-Arrays to the Element Data
+     * Search the Element inside the Array and pass the Tag-Arrays to the Element Data
      * @param _Elements Array of Elements that maybe const Tags for the Element
+     * @return uint16_t Number of Tags found in the Descriptor-Table, generated Tags are not counted
      */
-    void Protocol::set (JsonArray &_Elements) {
-      Debug.println (FLAG_PROTOCOL, true, Name, __func__, "Start");
-      JsonVariant _Tags;
-      _Tags = findConfig (_Elements);
-      if (_Tags.is<JsonArray> ()) {
-        setConfig(_Tags.as<JsonArray>());
-      }
-      _Tags = findData (_Elements);
-      if (_Tags.is<JsonArray> ()) {
-        setData(_Tags.as<JsonArray>());
+    uint16_t Protocol::set (JsonArray &_Elements) {
+      uint16_t Found = 0;
+      for (JsonObject Element : _Elements) {
+        if (Element[JsonTagName] == Name) {
+          Found += dispatch (Element);
+        }
       }
-      _Tags = findCmd (_Elements);
-      if (_Tags.is<JsonArray> ()) {
-        setCmd (_Tags.as<JsonArray> ());
+      return Found;
+    }
+
+    /**
+     * @brief Set Data, Config and execute Commands of all Elements
+     * Walk the Array once and route every Element-Object by Name to the registered Element
+     * @param _Elements Array of Elements ("elements": [])
+     */
+    void Protocol::setAll (JsonArray &_Elements) {
+      for (JsonObject Element : _Elements) {
+        const char *ElementName = Element[JsonTagName].as<const char *> ();
+        if (ElementName == nullptr) {
+          continue;
+        }
+        Protocol *Target = findElement (ElementName);
+        if (Target != nullptr) {
+          Target->dispatch (Element);
+        } else {
+          JCA_DEBUG_PRINTLN (FLAG_PROTOCOL, true, ElementName, __func__, "Unknown Element");
+        }
       }
     }
 
-    void Protocol::getValues (JsonObject &_Elements) {
+    /**
+     * @brief Add the Values of the Element
+     * Only Tags changed after _Since are added, unchanged Blocks and Elements are skipped.
+     * The Config-Block is always sent complete.
+     * @param _Elements Object of Elements ("elements": {})
+     * @param _Since Last Sequence the Client has received, 0 adds all Values
+     * @param _Subscription Groups and Data-Tags of the Client, null adds all Values
+     */
+    void Protocol::getValues (JsonObject &_Elements, uint32_t _Since, JsonObject _Subscription) {
+      trackChanges ();
+      JsonArray Groups = _Subscription[JsonTagGroups].as<JsonArray> ();
+      bool DataChanged = (_Since == 0 || DataSeq > _Since) && matchPatterns (Groups, JsonTagData);
+      bool ConfigChanged = (_Since == 0 || ConfigSeq > _Since) && matchPatterns (Groups, JsonTagConfig);
+      if (!DataChanged && !ConfigChanged) {
+        return;
+      }
       JsonObject Element = _Elements.createNestedObject (Name);
       JsonObject Values;
-      Values = Element.createNestedObject (JsonTagData);
-      createDataValues (Values);
-      Values = Element.createNestedObject (JsonTagConfig);
-      createConfigValues (Values);
-    }
-
-    void Protocol::writeSetup (File _SetupFile, bool &_ElementInit) {
-      if (_ElementInit) {
-        _SetupFile.println(",{");
-      } else {
-        _SetupFile.println ("{");
-        _ElementInit = true;
-      }
-      _SetupFile.println ("\"" + String(JsonTagName) + "\":\"" + Name + "\"");
-      if (Comment.length() > 0) {
-        _SetupFile.println(",\"" + String(JsonTagComment) + "\":\"" + Comment + "\"");
-      }
-      writeSetupConfig (_SetupFile);
-      writeSetupData (_SetupFile);
-      writeSetupCmdInfo (_SetupFile);
-      _SetupFile.println ("}");
+      if (DataChanged) {
+        ValuesSince = _Since;
+        ValuesTags = _Subscription[JsonTagTags].as<JsonArray> ();
+        Values = Element.createNestedObject (JsonTagData);
+        createDataValues (Values);
+        ValuesSince = 0;
+        ValuesTags = JsonArray ();
+        // only unsubscribed Tags changed
+        if (_Since > 0 && Values.size () == 0) {
+          Element.remove (JsonTagData);
+        }
+      }
+      if (ConfigChanged) {
+        Values = Element.createNestedObject (JsonTagConfig);
+        createConfigValues (Values);
+      }
+      if (Element.size () == 0) {
+        _Elements.remove (Name.c_str ());
+      }
+    }
+
+    /**
+     * @brief Add the current Values of one Block of the Element
+     * Used to read single Tags without creating the Values of all Elements
+     * @param _Group Name of the Block (JsonTagData or JsonTagConfig)
+     * @param _Values Object the Values have to add
+     * @return true Values added
+     * @return false unknown Block
+     */
+    bool Protocol::getGroupValues (const char *_Group, JsonObject &_Values) {
+      if (strcmp (_Group, JsonTagData) == 0) {
+        trackChanges ();
+        createDataValues (_Values);
+        return true;
+      }
+      if (strcmp (_Group, JsonTagConfig) == 0) {
+        createConfigValues (_Values);
+        return true;
+      }
+      return false;
+    }
+
+    /**
+     * @brief Add the Values of all registered Elements
+     *
+     * @param _Elements Object of Elements ("elements": {})
+     * @param _Since Last Sequence the Client has received, 0 adds all Values
+     * @param _Subscription Patterns of the Client ({"elements": [], "groups": [], "tags": []}), null adds all Elements
+     */
+    void Protocol::getAllValues (JsonObject &_Elements, uint32_t _Since, JsonObject _Subscription) {
+      JsonArray Patterns = _Subscription[JsonTagElements].as<JsonArray> ();
+      for (uint8_t i = 0; i < ElementCount; i++) {
+        if (matchPatterns (Patterns, Elements[i]->Name.c_str ())) {
+          Elements[i]->getValues (_Elements, _Since, _Subscription);
+        }
+      }
+    }
+
+    /**
+     * @brief Write the numeric Data-Tags of all Elements in the Prometheus Text-Format
+     * Bools are written as 0/1, Strings are skipped.
+     * The Scheduler-Statistics of the Elements are added as own Metrics.
+     * @param _Out Target, like a Response-Stream
+     * @param _Buffer Document for the Values of one Element
+     */
+    void Protocol::writeAllMetrics (Print &_Out, JsonDocument &_Buffer) {
+      _Out.print ("# TYPE " JCA_FNC_PROTOCOL_METRIC " gauge\n");
+      for (uint8_t i = 0; i < ElementCount; i++) {
+        JsonObject Values = _Buffer.to<JsonObject> ();
+        Elements[i]->getGroupValues (JsonTagData, Values);
+        for (JsonPair Pair : Values) {
+          JsonVariant Value = Pair.value ();
+          if (!Value.is<float> () && !Value.is<bool> ()) {
+            continue;
+          }
+          _Out.print (JCA_FNC_PROTOCOL_METRIC "{element=\"");
+          _Out.print (Elements[i]->Name);
+          _Out.print ("\",tag=\"");
+          _Out.print (Pair.key ().c_str ());
+          _Out.print ("\"} ");
+          if (Value.is<bool> ()) {
+            _Out.print (Value.as<bool> () ? 1 : 0);
+          } else if (Value.is<long> ()) {
+            _Out.print (Value.as<long> ());
+          } else {
+            _Out.print (Value.as<float> (), 3);
+          }
+          _Out.print ('\n');
+        }
+      }
+      _Buffer.clear ();
+
+      // Scheduler
+      _Out.print ("# TYPE jca_task_runs_total counter\n");
+      for (uint8_t i = 0; i < ElementCount; i++) {
+        _Out.printf ("jca_task_runs_total{element=\"%s\"} %u\n", Elements[i]->Name.c_str (), Elements[i]->Runs);
+      }
+      _Out.print ("# TYPE jca_task_deadline_misses_total counter\n");
+      for (uint8_t i = 0; i < ElementCount; i++) {
+        _Out.printf ("jca_task_deadline_misses_total{element=\"%s\"} %u\n", Elements[i]->Name.c_str (), Elements[i]->Misses);
+      }
+      _Out.print ("# TYPE jca_task_budget_overruns_total counter\n");
+      for (uint8_t i = 0; i < ElementCount; i++) {
+        _Out.printf ("jca_task_budget_overruns_total{element=\"%s\"} %u\n", Elements[i]->Name.c_str (), Elements[i]->Overruns);
+      }
+      _Out.print ("# TYPE jca_task_runtime_max_seconds gauge\n");
+      for (uint8_t i = 0; i < ElementCount; i++) {
+        _Out.printf ("jca_task_runtime_max_seconds{element=\"%s\"} ", Elements[i]->Name.c_str ());
+        _Out.print ((float)Elements[i]->MaxRunTime / 1000000.0, 6);
+        _Out.print ('\n');
+      }
+    }
+
+    /**
+     * @brief Check a Name against the Patterns of a Subscription
+     * A Pattern is the exact Name or a Prefix ending with '*', "*" matches all Names
+     * @param _Patterns Array of Patterns, null matches all Names
+     * @param _Name Name to check
+     * @return true Name is subscribed
+     * @return false Name doesn't match any Pattern
+     */
+    bool Protocol::matchPatterns (JsonArray _Patterns, const char *_Name) {
+      if (_Patterns.isNull ()) {
+        return true;
+      }
+      for (JsonVariant Pattern : _Patterns) {
+        const char *Text = Pattern.as<const char *> ();
+        if (Text == nullptr) {
+          continue;
+        }
+        size_t Length = strlen (Text);
+        if (Length > 0 && Text[Length - 1] == '*') {
+          if (strncmp (Text, _Name, Length - 1) == 0) {
+            return true;
+          }
+        } else if (strcmp (Text, _Name) == 0) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /**
+     * @brief Run the Change-Tracking of all registered Elements
+     * Used to check a Client-Sequence without creating the Values
+     * @return uint32_t Sequence of the last Change
+     */
+    uint32_t Protocol::trackAllChanges () {
+      for (uint8_t i = 0; i < ElementCount; i++) {
+        Elements[i]->trackChanges ();
+      }
+      return Sequence;
+    }
+
+    /**
+     * @brief Sequence of the last Change
+     * Clients send it back to get only the Changes after it
+     * @return uint32_t Sequence
+     */
+    uint32_t Protocol::getSequence () {
+      return Sequence;
+    }
+
+    /**
+     * @brief Write the Setup of the Element
+     * Contains the Element Name and the Tag-Arrays with Texts, Units and current Values
+     * @param _Setup Writer inside the Elements-Array ("elements": [])
+     */
+    void Protocol::writeSetup (JsonStream &_Setup) {
+      _Setup.beginObject ();
+      _Setup.add (JsonTagName, Name);
+      if (Comment.length () > 0) {
+        _Setup.add (JsonTagComment, Comment);
+      }
+      writeSetupConfig (_Setup);
+      writeSetupData (_Setup);
+      writeSetupCmdInfo (_Setup);
+      _Setup.endObject ();
     }
   }
 }
@@ -5,10 +5,42 @@
 #include "FS.h"
 #include <ArduinoJson.h>
 
+#include <JCA_FNC_Tag.h>
 #include <JCA_SYS_DebugOut.h>
+#include <JCA_SYS_JsonStream.h>
+
+// Maximum Number of Elements inside the Router, further Elements are not registered
+#define JCA_FNC_PROTOCOL_MAXELEMENTS 32
+// Maximum Number of tracked Data-Tags per Element, further Tags are sent with every Update of the Element
+#define JCA_FNC_PROTOCOL_MAXDATATAGS 24
+// Prometheus-Metric of the numeric Data-Tags
+#define JCA_FNC_PROTOCOL_METRIC "jca_tag_value"
+// Scheduler, an update() starting later than this after its Deadline is a Miss (ms)
+#define JCA_FNC_PROTOCOL_DEADLINE_SLACK 20
+// Default Run-Time Budget of an update() in us
+#define JCA_FNC_PROTOCOL_BUDGET 1000
+// Elements below Critical Priority wait for the next Pass if the Pass already took longer (us)
+#define JCA_FNC_PROTOCOL_PASSBUDGET 5000
+// Maximum Time a Job is deferred by a Movement (ms), then it runs once and is deferred again
+#define JCA_FNC_PROTOCOL_MOTIONHOLD 2000
 
 namespace JCA {
   namespace FNC {
+    /**
+     * @brief
+     * Priority of an Element inside the Scheduler, due Elements are updated in this Order
+     */
+    enum class TaskPriority : uint8_t {
+      Low,     ///< Slow Sensors, skipped if the Pass is over Budget
+      Normal,  ///< Default
+      High,    ///< Updated before the other Elements
+      Critical ///< Timing-critical Hardware like the Stepper, updated in every Pass
+    };
+
+    class Protocol;
+    // Gets the Run-Time of every update() in CPU-Cycles, the Name-Pointer is constant for an Element
+    typedef void (*ProfileCallback) (const char *_Name, uint32_t _Cycles);
+
     class Protocol {
     protected:
       // Element Strings for Protocol and Debug-Output
@@ -20,6 +52,48 @@ namespace JCA {
       String Name;
       String Comment;
 
+      // Element-Router, all Elements in creation Order and an Index sorted by Name-Hash
+      static Protocol *Elements[JCA_FNC_PROTOCOL_MAXELEMENTS];
+      static Protocol *Index[JCA_FNC_PROTOCOL_MAXELEMENTS];
+      static uint8_t ElementCount;
+      uint32_t NameHash;
+      void registerElement ();
+      static Protocol *findElement (const char *_Name);
+      uint16_t TagsFound;
+      uint16_t dispatch (JsonObject &_Element);
+
+      // Change-Tracking, every Change gets the next Value of the global Sequence
+      static uint32_t Sequence;
+      uint32_t ConfigSeq;
+      uint32_t DataSeq;
+      uint32_t ValuesSince;
+      JsonArray ValuesTags;
+      TagState DataStates[JCA_FNC_PROTOCOL_MAXDATATAGS];
+      static bool ChangeSignaled;
+      void configChanged ();
+      void signalChange ();
+
+      // Motion-State, set by Elements with moving Hardware, counted over all Elements
+      static uint8_t MotionCount;
+      bool Moving;
+      void setMotion (bool _Active);
+
+      // Scheduler, update() is called by updateAll when the Deadline is reached
+      TaskPriority Priority;
+      uint32_t Period;
+      uint32_t Deadline;
+      uint32_t Budget;
+      uint32_t Runs;
+      uint32_t Misses;
+      uint32_t Overruns;
+      uint32_t MaxRunTime;
+      void setSchedule (uint32_t _Period, TaskPriority _Priority, uint32_t _Budget = JCA_FNC_PROTOCOL_BUDGET);
+      void setPeriod (uint32_t _Period);
+      void setDeadline (uint32_t _Delay);
+      void run (struct tm &_Time);
+      static ProfileCallback Profiler;
+      virtual void trackChanges () = 0;
+
       // Prototypes for Child Elements
       virtual void createConfigValues (JsonObject &_Values) = 0;
       virtual void createDataValues (JsonObject &_Values) = 0;
@@ -27,28 +101,34 @@ namespace JCA {
       virtual void setData (JsonArray _Tags) = 0;
       virtual void setCmd (JsonArray _Tags) = 0;
 
-      virtual void writeSetupConfig (File _SetupFile) = 0;
-      virtual void writeSetupData (File _SetupFile) = 0;
-      virtual void writeSetupCmdInfo (File _SetupFile) = 0;
+      virtual void writeSetupConfig (JCA::SYS::JsonStream &_Setup) = 0;
+      virtual void writeSetupData (JCA::SYS::JsonStream &_Setup) = 0;
+      virtual void writeSetupCmdInfo (JCA::SYS::JsonStream &_Setup) = 0;
 
-      // Get Element-Data by Name
-      JsonVariant findConfig (JsonArray &_Elements);
-      JsonVariant findData (JsonArray &_Elements);
-      JsonVariant findCmd (JsonArray &_Elements);
-      
       // Create Protocol-Structure
-      String createDefaultTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly);
-      String createSetupTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_BtnOnText, const char *_BtnOffText, bool _Value);
-      String createSetupTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, float _Value);
-      String createSetupTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, int16_t _Value);
-      String createSetupTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, uint16_t _Value);
-      String createSetupTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, int32_t _Value);
-      String createSetupTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, uint32_t _Value);
-      String createSetupTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, long _Value);
-      String createSetupTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, String _Value);
-      String createSetupTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Value);
-      String createSetupCmdInfo (const char *_Name, const char *_Text, const char *_Comment, const char *_Type);
-      String createSetupCmdInfo (const char *_Name, const char *_Text, const char *_Comment, const char *_Type, const char *_BtnText);
+      void writeDefaultTag (JCA::SYS::JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly);
+      void writeSetupTag (JCA::SYS::JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_BtnOnText, const char *_BtnOffText, bool _Value);
+      void writeSetupTag (JCA::SYS::JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, float _Value);
+      void writeSetupTag (JCA::SYS::JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, int16_t _Value);
+      void writeSetupTag (JCA::SYS::JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, uint16_t _Value);
+      void writeSetupTag (JCA::SYS::JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, int32_t _Value);
+      void writeSetupTag (JCA::SYS::JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, uint32_t _Value);
+      void writeSetupTag (JCA::SYS::JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, long _Value);
+      void writeSetupTag (JCA::SYS::JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const String &_Value);
+      void writeSetupTag (JCA::SYS::JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Value);
+      void writeSetupCmdTag (JCA::SYS::JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, const char *_Type, const char *_BtnText);
+
+      // Table driven Tag-Handling, see JCA_FNC_Tag.h
+      template <class T, size_t N>
+      bool setTag (T *_Element, const TagDescriptor<T> (&_Table)[N], TagGroup _Group, JsonObject &_Tag);
+      template <class T, size_t N>
+      void setTags (T *_Element, const TagDescriptor<T> (&_Table)[N], TagGroup _Group, JsonArray &_Tags);
+      template <class T, size_t N>
+      void createTagValues (T *_Element, const TagDescriptor<T> (&_Table)[N], TagGroup _Group, JsonObject &_Values);
+      template <class T, size_t N>
+      void trackTags (T *_Element, const TagDescriptor<T> (&_Table)[N]);
+      template <class T, size_t N>
+      void writeSetupTags (T *_Element, const TagDescriptor<T> (&_Table)[N], TagGroup _Group, JCA::SYS::JsonStream &_Setup);
 
     public:
       // Json Tags
@@ -66,16 +146,264 @@ namespace JCA {
       static const char *JsonTagOff;
       static const char *JsonTagType;
       static const char *JsonTagReadOnly;
+      static const char *JsonTagSequence;
+      static const char *JsonTagSubscribe;
+      static const char *JsonTagGroups;
+      static const char *JsonTagTags;
 
       // external Functions
       Protocol (String _Name, String _Comment);
       Protocol (String _Name);
       virtual void update (struct tm &_Time) = 0;
-      void set (JsonArray &_Elements);
+      uint16_t set (JsonArray &_Elements);
+      static void setAll (JsonArray &_Elements);
+      static void updateAll (struct tm &_Time);
+      static void getAllValues (JsonObject &_Elements, uint32_t _Since = 0, JsonObject _Subscription = JsonObject ());
+      static bool matchPatterns (JsonArray _Patterns, const char *_Name);
+      static uint32_t trackAllChanges ();
+      static uint32_t getSequence ();
+      static bool takeChangeSignal ();
+      static bool inMotion ();
+      static bool deferForMotion (uint32_t _LastRun);
+      static void writeAllMetrics (Print &_Out, JsonDocument &_Buffer);
 
-      void getValues (JsonObject &_Elements);
-      void writeSetup (File _SetupFile, bool &_ElementInit);
+      void getValues (JsonObject &_Elements, uint32_t _Since = 0, JsonObject _Subscription = JsonObject ());
+      bool getGroupValues (const char *_Group, JsonObject &_Values);
+      void writeSetup (JCA::SYS::JsonStream &_Setup);
     };
+
+    /**
+     * @brief Set a single Tag from the Descriptor-Table
+     * The incoming Name is hashed once and compared to the precompiled Hashes,
+     * only on a Hash-Match the Name is compared to exclude collisions.
+     * Commands are found in every Group, like a Button inside the Data-Block.
+     * @param _Element Element that owns the Members
+     * @param _Table Descriptor-Table of the Element
+     * @param _Group Block the Tag comes from
+     * @param _Tag Tag to set ({"name":..., "value":...})
+     * @return true Tag found in the Table
+     * @return false unknown Tag
+     */
+    template <class T, size_t N>
+    bool Protocol::setTag (T *_Element, const TagDescriptor<T> (&_Table)[N], TagGroup _Group, JsonObject &_Tag) {
+      const char *TagName = _Tag[JsonTagName].as<const char *> ();
+      if (TagName == nullptr) {
+        return false;
+      }
+      uint32_t Hash = tagHash (TagName);
+      for (size_t i = 0; i < N; i++) {
+        const TagDescriptor<T> &Tag = _Table[i];
+        if (Tag.Hash != Hash || (Tag.Group != _Group && !(_Group == TagGroup::Cmd && Tag.Type == TagType::Cmd)) || strcmp (Tag.Name, TagName) != 0) {
+          continue;
+        }
+        TagsFound++;
+        if (Tag.ReadOnly) {
+          return true;
+        }
+        JsonVariant Value = _Tag[JsonTagValue];
+        switch (Tag.Type) {
+        case TagType::Bool:
+          _Element->*Tag.Member.Bool = Value.as<bool> ();
+          break;
+        case TagType::Float:
+          _Element->*Tag.Member.Float = Value.as<float> ();
+          break;
+        case TagType::Int16:
+          _Element->*Tag.Member.Int16 = Value.as<int16_t> ();
+          break;
+        case TagType::UInt16:
+          _Element->*Tag.Member.UInt16 = Value.as<uint16_t> ();
+          break;
+        case TagType::Int32:
+          _Element->*Tag.Member.Int32 = Value.as<int32_t> ();
+          break;
+        case TagType::UInt32:
+          _Element->*Tag.Member.UInt32 = Value.as<uint32_t> ();
+          break;
+        case TagType::Text:
+          _Element->*Tag.Member.Text = Value.as<String> ();
+          break;
+        case TagType::Cmd:
+          (_Element->*Tag.Member.Cmd) (Value);
+          break;
+        }
+        if (Tag.OnSet != nullptr) {
+          (_Element->*Tag.OnSet) ();
+        }
+        JCA::SYS::DEBUGOUT_FLAGS Flag = _Group == TagGroup::Config ? JCA::SYS::FLAG_CONFIG : JCA::SYS::FLAG_LOOP;
+        if (JCA_DEBUG_PRINT (Flag, false, Name, __func__, Tag.Name)) {
+          JCA_DEBUG_PRINT (Flag, false, Name, __func__, DebugSeparator);
+          JCA_DEBUG_PRINTLN (Flag, false, Name, __func__, Value.as<String> ());
+        }
+        return true;
+      }
+      return false;
+    }
+
+    /**
+     * @brief Set all Tags of an Array from the Descriptor-Table
+     * Only existing Tags will be updated
+     * @param _Element Element that owns the Members
+     * @param _Table Descriptor-Table of the Element
+     * @param _Group Block the Tags come from
+     * @param _Tags Array of Tags like Data ("data": []) or Config
+     */
+    template <class T, size_t N>
+    void Protocol::setTags (T *_Element, const TagDescriptor<T> (&_Table)[N], TagGroup _Group, JsonArray &_Tags) {
+      for (JsonObject Tag : _Tags) {
+        setTag (_Element, _Table, _Group, Tag);
+      }
+    }
+
+    /**
+     * @brief Add the current Values of a Block to the Object
+     * Commands inside the Data-Block are reported as false.
+     * Data-Tags that are not changed since ValuesSince are skipped (ValuesSince = 0 adds all),
+     * also Data-Tags that don't match the Patterns of ValuesTags (null adds all).
+     * @param _Element Element that owns the Members
+     * @param _Table Descriptor-Table of the Element
+     * @param _Group Block to add
+     * @param _Values Object the Values have to add
+     */
+    template <class T, size_t N>
+    void Protocol::createTagValues (T *_Element, const TagDescriptor<T> (&_Table)[N], TagGroup _Group, JsonObject &_Values) {
+      uint8_t DataPos = 0;
+      for (size_t i = 0; i < N; i++) {
+        const TagDescriptor<T> &Tag = _Table[i];
+        if (Tag.Group != _Group) {
+          continue;
+        }
+        if (_Group == TagGroup::Data) {
+          if (ValuesSince > 0 && DataPos < JCA_FNC_PROTOCOL_MAXDATATAGS && DataStates[DataPos].Sequence <= ValuesSince) {
+            DataPos++;
+            continue;
+          }
+          DataPos++;
+          if (!matchPatterns (ValuesTags, Tag.Name)) {
+            continue;
+          }
+        }
+        switch (Tag.Type) {
+        case TagType::Bool:
+          _Values[Tag.Name] = _Element->*Tag.Member.Bool;
+          break;
+        case TagType::Float:
+          _Values[Tag.Name] = _Element->*Tag.Member.Float;
+          break;
+        case TagType::Int16:
+          _Values[Tag.Name] = _Element->*Tag.Member.Int16;
+          break;
+        case TagType::UInt16:
+          _Values[Tag.Name] = _Element->*Tag.Member.UInt16;
+          break;
+        case TagType::Int32:
+          _Values[Tag.Name] = _Element->*Tag.Member.Int32;
+          break;
+        case TagType::UInt32:
+          _Values[Tag.Name] = _Element->*Tag.Member.UInt32;
+          break;
+        case TagType::Text:
+          _Values[Tag.Name] = _Element->*Tag.Member.Text;
+          break;
+        case TagType::Cmd:
+          _Values[Tag.Name] = false;
+          break;
+        }
+      }
+    }
+
+    /**
+     * @brief Compare the Data-Tags with the last Tracking-Pass
+     * Every changed Tag gets the next Sequence, Commands are never changed.
+     * @param _Element Element that owns the Members
+     * @param _Table Descriptor-Table of the Element
+     */
+    template <class T, size_t N>
+    void Protocol::trackTags (T *_Element, const TagDescriptor<T> (&_Table)[N]) {
+      uint8_t DataPos = 0;
+      for (size_t i = 0; i < N && DataPos < JCA_FNC_PROTOCOL_MAXDATATAGS; i++) {
+        const TagDescriptor<T> &Tag = _Table[i];
+        if (Tag.Group != TagGroup::Data) {
+          continue;
+        }
+        uint32_t Fingerprint = 0;
+        switch (Tag.Type) {
+        case TagType::Bool:
+          Fingerprint = (_Element->*Tag.Member.Bool) ? 1 : 0;
+          break;
+        case TagType::Float:
+          memcpy (&Fingerprint, &(_Element->*Tag.Member.Float), sizeof (Fingerprint));
+          break;
+        case TagType::Int16:
+          Fingerprint = (uint32_t)(_Element->*Tag.Member.Int16);
+          break;
+        case TagType::UInt16:
+          Fingerprint = _Element->*Tag.Member.UInt16;
+          break;
+        case TagType::Int32:
+          Fingerprint = (uint32_t)(_Element->*Tag.Member.Int32);
+          break;
+        case TagType::UInt32:
+          Fingerprint = _Element->*Tag.Member.UInt32;
+          break;
+        case TagType::Text:
+          Fingerprint = tagHash ((_Element->*Tag.Member.Text).c_str ());
+          break;
+        case TagType::Cmd:
+          break;
+        }
+        TagState &State = DataStates[DataPos++];
+        if (State.Fingerprint != Fingerprint) {
+          State.Fingerprint = Fingerprint;
+          State.Sequence = ++Sequence;
+          DataSeq = Sequence;
+        }
+      }
+    }
+
+    /**
+     * @brief Write the Setup-Tags of a Block
+     * Only the Tags are written, the Element opens and closes the surrounding Array
+     * @param _Element Element that owns the Members
+     * @param _Table Descriptor-Table of the Element
+     * @param _Group Block to write
+     * @param _Setup Writer inside the Tag-Array
+     */
+    template <class T, size_t N>
+    void Protocol::writeSetupTags (T *_Element, const TagDescriptor<T> (&_Table)[N], TagGroup _Group, JCA::SYS::JsonStream &_Setup) {
+      for (size_t i = 0; i < N; i++) {
+        const TagDescriptor<T> &Tag = _Table[i];
+        if (Tag.Group != _Group) {
+          continue;
+        }
+        switch (Tag.Type) {
+        case TagType::Bool:
+          writeSetupTag (_Setup, Tag.Name, Tag.Text, Tag.Comment, Tag.ReadOnly, Tag.Unit, Tag.BtnText, _Element->*Tag.Member.Bool);
+          break;
+        case TagType::Float:
+          writeSetupTag (_Setup, Tag.Name, Tag.Text, Tag.Comment, Tag.ReadOnly, Tag.Unit, _Element->*Tag.Member.Float);
+          break;
+        case TagType::Int16:
+          writeSetupTag (_Setup, Tag.Name, Tag.Text, Tag.Comment, Tag.ReadOnly, Tag.Unit, _Element->*Tag.Member.Int16);
+          break;
+        case TagType::UInt16:
+          writeSetupTag (_Setup, Tag.Name, Tag.Text, Tag.Comment, Tag.ReadOnly, Tag.Unit, _Element->*Tag.Member.UInt16);
+          break;
+        case TagType::Int32:
+          writeSetupTag (_Setup, Tag.Name, Tag.Text, Tag.Comment, Tag.ReadOnly, Tag.Unit, _Element->*Tag.Member.Int32);
+          break;
+        case TagType::UInt32:
+          writeSetupTag (_Setup, Tag.Name, Tag.Text, Tag.Comment, Tag.ReadOnly, Tag.Unit, _Element->*Tag.Member.UInt32);
+          break;
+        case TagType::Text:
+          writeSetupTag (_Setup, Tag.Name, Tag.Text, Tag.Comment, Tag.ReadOnly, _Element->*Tag.Member.Text);
+          break;
+        case TagType::Cmd:
+          writeSetupCmdTag (_Setup, Tag.Name, Tag.Text, Tag.Comment, Tag.Unit, Tag.BtnText);
+          break;
+        }
+      }
+    }
   }
 }
 
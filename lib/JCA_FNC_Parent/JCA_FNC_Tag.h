@@ -0,0 +1,126 @@
+#ifndef _JCA_FNC_TAG_
+#define _JCA_FNC_TAG_
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// FNV-1a Parameters for the Tag-Name Hash
+#define JCA_FNC_TAG_HASH_BASIS 2166136261UL
+#define JCA_FNC_TAG_HASH_PRIME 16777619UL
+
+namespace JCA {
+  namespace FNC {
+    /**
+     * @brief
+     * Block of the Protocol the Tag belongs to
+     */
+    enum class TagGroup : uint8_t {
+      Config, ///< "config": []
+      Data,   ///< "data": []
+      Cmd     ///< "cmd": [] and "cmdInfo": []
+    };
+
+    /**
+     * @brief
+     * Type of the Member the Tag is linked to
+     */
+    enum class TagType : uint8_t {
+      Bool,
+      Float,
+      Int16,
+      UInt16,
+      Int32,
+      UInt32,
+      Text,
+      Cmd
+    };
+
+    /**
+     * @brief Hash of a Tag-Name (FNV-1a)
+     * Used at compile-time for the Descriptor-Tables and at run-time for incoming Tags
+     * @param _Name Tag-Name
+     * @param _Hash Hash of the previous Chars
+     * @return constexpr uint32_t Hash of the Name
+     */
+    constexpr uint32_t tagHash (const char *_Name, uint32_t _Hash = JCA_FNC_TAG_HASH_BASIS) {
+      return (*_Name == '\0') ? _Hash : tagHash (_Name + 1, (uint32_t)((_Hash ^ (uint8_t)*_Name) * JCA_FNC_TAG_HASH_PRIME));
+    }
+
+    /**
+     * @brief
+     * Pointer to the Element-Member of a Tag, the Type is stored in the Descriptor
+     */
+    template <class T>
+    union TagMember {
+      bool T::*Bool;
+      float T::*Float;
+      int16_t T::*Int16;
+      uint16_t T::*UInt16;
+      int32_t T::*Int32;
+      uint32_t T::*UInt32;
+      String T::*Text;
+      void (T::*Cmd) (JsonVariant _Value);
+
+      constexpr TagMember (bool T::*_Member) : Bool (_Member) {}
+      constexpr TagMember (float T::*_Member) : Float (_Member) {}
+      constexpr TagMember (int16_t T::*_Member) : Int16 (_Member) {}
+      constexpr TagMember (uint16_t T::*_Member) : UInt16 (_Member) {}
+      constexpr TagMember (int32_t T::*_Member) : Int32 (_Member) {}
+      constexpr TagMember (uint32_t T::*_Member) : UInt32 (_Member) {}
+      constexpr TagMember (String T::*_Member) : Text (_Member) {}
+      constexpr TagMember (void (T::*_Member) (JsonVariant _Value)) : Cmd (_Member) {}
+    };
+
+    /**
+     * @brief
+     * Change-Tracking of one Tag, the Fingerprint is compared on every Tracking-Pass
+     */
+    struct TagState {
+      uint32_t Fingerprint; ///< Raw Bits of the last Value, Hash for Strings
+      uint32_t Sequence;    ///< Change-Sequence of the last Change
+    };
+
+    /**
+     * @brief
+     * Description of one Tag of an Element, the Table of all Tags drives set, get and Setup-Generation.
+     * The Constructors follow the Parameters of Protocol::writeSetupTag and Protocol::writeSetupCmdTag.
+     */
+    template <class T>
+    struct TagDescriptor {
+      TagGroup Group;
+      TagType Type;
+      uint32_t Hash;           ///< tagHash of the Name
+      const char *Name;        ///< Name of the Tag inside the Communication
+      const char *Text;        ///< Text for Website Lable
+      const char *Comment;     ///< Comment, nullptr if not used
+      bool ReadOnly;           ///< Disable Input on Website, ignore on set
+      const char *Unit;        ///< Unit, Buttontext On for Bool, Type for Commands
+      const char *BtnText;     ///< Buttontext Off for Bool, Buttontext for Commands
+      TagMember<T> Member;     ///< Linked Member or Command-Function
+      void (T::*OnSet) ();     ///< Called after the Member is set, nullptr if not used
+
+      // Bool-/Button-Tag
+      constexpr TagDescriptor (TagGroup _Group, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_BtnOnText, const char *_BtnOffText, bool T::*_Member, void (T::*_OnSet) () = nullptr)
+          : Group (_Group), Type (TagType::Bool), Hash (tagHash (_Name)), Name (_Name), Text (_Text), Comment (_Comment), ReadOnly (_ReadOnly), Unit (_BtnOnText), BtnText (_BtnOffText), Member (_Member), OnSet (_OnSet) {}
+      // Value-Tags
+      constexpr TagDescriptor (TagGroup _Group, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, float T::*_Member, void (T::*_OnSet) () = nullptr)
+          : Group (_Group), Type (TagType::Float), Hash (tagHash (_Name)), Name (_Name), Text (_Text), Comment (_Comment), ReadOnly (_ReadOnly), Unit (_Unit), BtnText (nullptr), Member (_Member), OnSet (_OnSet) {}
+      constexpr TagDescriptor (TagGroup _Group, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, int16_t T::*_Member, void (T::*_OnSet) () = nullptr)
+          : Group (_Group), Type (TagType::Int16), Hash (tagHash (_Name)), Name (_Name), Text (_Text), Comment (_Comment), ReadOnly (_ReadOnly), Unit (_Unit), BtnText (nullptr), Member (_Member), OnSet (_OnSet) {}
+      constexpr TagDescriptor (TagGroup _Group, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, uint16_t T::*_Member, void (T::*_OnSet) () = nullptr)
+          : Group (_Group), Type (TagType::UInt16), Hash (tagHash (_Name)), Name (_Name), Text (_Text), Comment (_Comment), ReadOnly (_ReadOnly), Unit (_Unit), BtnText (nullptr), Member (_Member), OnSet (_OnSet) {}
+      constexpr TagDescriptor (TagGroup _Group, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, int32_t T::*_Member, void (T::*_OnSet) () = nullptr)
+          : Group (_Group), Type (TagType::Int32), Hash (tagHash (_Name)), Name (_Name), Text (_Text), Comment (_Comment), ReadOnly (_ReadOnly), Unit (_Unit), BtnText (nullptr), Member (_Member), OnSet (_OnSet) {}
+      constexpr TagDescriptor (TagGroup _Group, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, uint32_t T::*_Member, void (T::*_OnSet) () = nullptr)
+          : Group (_Group), Type (TagType::UInt32), Hash (tagHash (_Name)), Name (_Name), Text (_Text), Comment (_Comment), ReadOnly (_ReadOnly), Unit (_Unit), BtnText (nullptr), Member (_Member), OnSet (_OnSet) {}
+      // String-Tag
+      constexpr TagDescriptor (TagGroup _Group, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, String T::*_Member, void (T::*_OnSet) () = nullptr)
+          : Group (_Group), Type (TagType::Text), Hash (tagHash (_Name)), Name (_Name), Text (_Text), Comment (_Comment), ReadOnly (_ReadOnly), Unit (nullptr), BtnText (nullptr), Member (_Member), OnSet (_OnSet) {}
+      // Command, the Function gets the Value of the Command
+      constexpr TagDescriptor (TagGroup _Group, const char *_Name, const char *_Text, const char *_Comment, const char *_Type, const char *_BtnText, void (T::*_Member) (JsonVariant _Value))
+          : Group (_Group), Type (TagType::Cmd), Hash (tagHash (_Name)), Name (_Name), Text (_Text), Comment (_Comment), ReadOnly (false), Unit (_Type), BtnText (_BtnText), Member (_Member), OnSet (nullptr) {}
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,281 @@
+#include <JCA_FNC_Perf.h>
+using namespace JCA::SYS;
+
+namespace JCA {
+  namespace FNC {
+    const char *Perf::Min_Name = "Min";
+    const char *Perf::Max_Name = "Max";
+    const char *Perf::Mean_Name = "Mean";
+    const char *Perf::Count_Name = "Count";
+    const char *Perf::Hist_Name = "Hist";
+    const uint32_t Perf::Bounds[JCA_FNC_PERF_BOUNDS] = {2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192, 16384, 32768, 65536};
+    Perf *Perf::Instance = nullptr;
+    const TagDescriptor<Perf> Perf::Tags[] = {
+      {TagGroup::Config, "Period", "Aktualisierung", "Intervall der Statistik-Ausgabe", false, "ms", &Perf::Period, &Perf::onPeriodChanged},
+      {TagGroup::Cmd, "reset", "Statistik zurücksetzen", nullptr, "bool", "RESET", &Perf::doReset}};
+
+    /**
+     * @brief Construct a new Perf::Perf object
+     * The Element registers itself as Profiler of the Scheduler, so every update() of an Element is measured.
+     * The Slot "loop" contains the Time between two Calls of loop().
+     * @param _Name Element Name inside the Communication
+     */
+    Perf::Perf (const char *_Name)
+        : Protocol (_Name) {
+      Period = JCA_FNC_PERF_PERIOD;
+      SlotCount = 0;
+      LastLoop = 0;
+      LoopStarted = false;
+      LoopSlot = addSlot ("loop");
+      Instance = this;
+      Profiler = onProfile;
+      setSchedule (Period, TaskPriority::Low);
+    }
+
+    /**
+     * @brief Period changed, the Scheduler uses it as Period
+     */
+    void Perf::onPeriodChanged () {
+      setPeriod (Period);
+    }
+
+    /**
+     * @brief Set the Element Config
+     * Only existing Tags will be updated
+     * @param _Tags Array of Config-Tags ("config": [])
+     */
+    void Perf::setConfig (JsonArray _Tags) {
+      JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, Name, __func__, "Set");
+      setTags (this, Tags, TagGroup::Config, _Tags);
+    }
+
+    /**
+     * @brief Set the Element Data
+     * currently not used
+     * @param _Tags Array of Data-Tags ("data": [])
+     */
+    void Perf::setData (JsonArray _Tags) {
+    }
+
+    /**
+     * @brief Execute the Commands
+     *
+     * @param _Tags Array of Commands ("cmd": [])
+     */
+    void Perf::setCmd (JsonArray _Tags) {
+      JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, Name, __func__, "Set");
+      setTags (this, Tags, TagGroup::Cmd, _Tags);
+    }
+
+    /**
+     * @brief Command to clear the Statistic of all Slots
+     *
+     * @param _Value true resets the Statistic
+     */
+    void Perf::doReset (JsonVariant _Value) {
+      if (_Value.as<bool> ()) {
+        reset ();
+      }
+    }
+
+    /**
+     * @brief Create a list of Config-Tags containing the current Value
+     *
+     * @param _Setup Writer inside the Element
+     */
+    void Perf::writeSetupConfig (JsonStream &_Setup) {
+      JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, Name, __func__, "Get");
+      _Setup.beginArray (JsonTagConfig);
+      writeSetupTags (this, Tags, TagGroup::Config, _Setup);
+      _Setup.endArray ();
+    }
+
+    /**
+     * @brief Create a list of Data-Tags containing the current Value
+     * Every Slot gets the Tags <Slot>Min, <Slot>Max, <Slot>Mean, <Slot>Count and <Slot>Hist
+     * @param _Setup Writer inside the Element
+     */
+    void Perf::writeSetupData (JsonStream &_Setup) {
+      JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, Name, __func__, "Get");
+      _Setup.beginArray (JsonTagData);
+      char SlotTag[JCA_FNC_PERF_TAGLENGTH];
+      char SlotText[JCA_FNC_PERF_TAGLENGTH];
+      char Hist[JCA_FNC_PERF_BOUNDS * 12];
+      for (uint8_t i = 0; i < SlotCount; i++) {
+        Histogram &Time = Slots[i].Time;
+        getSlotTag (SlotTag, i, Min_Name);
+        snprintf (SlotText, sizeof (SlotText), "%s min.", Slots[i].Name);
+        writeSetupTag (_Setup, SlotTag, SlotText, nullptr, true, "us", Time.min ());
+        getSlotTag (SlotTag, i, Max_Name);
+        snprintf (SlotText, sizeof (SlotText), "%s max.", Slots[i].Name);
+        writeSetupTag (_Setup, SlotTag, SlotText, nullptr, true, "us", Time.max ());
+        getSlotTag (SlotTag, i, Mean_Name);
+        snprintf (SlotText, sizeof (SlotText), "%s Mittel", Slots[i].Name);
+        writeSetupTag (_Setup, SlotTag, SlotText, nullptr, true, "us", Time.mean ());
+        getSlotTag (SlotTag, i, Count_Name);
+        snprintf (SlotText, sizeof (SlotText), "%s Anzahl", Slots[i].Name);
+        writeSetupTag (_Setup, SlotTag, SlotText, nullptr, true, "#", Time.count ());
+        getSlotTag (SlotTag, i, Hist_Name);
+        snprintf (SlotText, sizeof (SlotText), "%s Verteilung", Slots[i].Name);
+        Time.printBuckets (Hist, sizeof (Hist));
+        writeSetupTag (_Setup, SlotTag, SlotText, "Obergrenze in us : Anzahl", true, Hist);
+      }
+      _Setup.endArray ();
+    }
+
+    /**
+     * @brief Create a list of Command-Informations
+     *
+     * @param _Setup Writer inside the Element
+     */
+    void Perf::writeSetupCmdInfo (JsonStream &_Setup) {
+      JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, Name, __func__, "Get");
+      _Setup.beginArray (JsonTagCmdInfo);
+      writeSetupTags (this, Tags, TagGroup::Cmd, _Setup);
+      _Setup.endArray ();
+    }
+
+    void Perf::createConfigValues (JsonObject &_Values) {
+      createTagValues (this, Tags, TagGroup::Config, _Values);
+    }
+
+    void Perf::createDataValues (JsonObject &_Values) {
+      // Non-const Names are copied by ArduinoJson
+      char SlotTag[JCA_FNC_PERF_TAGLENGTH];
+      char Hist[JCA_FNC_PERF_BOUNDS * 12];
+      for (uint8_t i = 0; i < SlotCount; i++) {
+        Histogram &Time = Slots[i].Time;
+        getSlotTag (SlotTag, i, Min_Name);
+        if (matchPatterns (ValuesTags, SlotTag)) {
+          _Values[SlotTag] = Time.min ();
+        }
+        getSlotTag (SlotTag, i, Max_Name);
+        if (matchPatterns (ValuesTags, SlotTag)) {
+          _Values[SlotTag] = Time.max ();
+        }
+        getSlotTag (SlotTag, i, Mean_Name);
+        if (matchPatterns (ValuesTags, SlotTag)) {
+          _Values[SlotTag] = Time.mean ();
+        }
+        getSlotTag (SlotTag, i, Count_Name);
+        if (matchPatterns (ValuesTags, SlotTag)) {
+          _Values[SlotTag] = Time.count ();
+        }
+        getSlotTag (SlotTag, i, Hist_Name);
+        if (matchPatterns (ValuesTags, SlotTag)) {
+          Time.printBuckets (Hist, sizeof (Hist));
+          _Values[SlotTag] = (char *)Hist;
+        }
+      }
+    }
+
+    /**
+     * @brief The Statistic changes with every Measurement,
+     * the Values are published by update() once per Period instead
+     */
+    void Perf::trackChanges () {
+    }
+
+    /**
+     * @brief Publish the Statistic
+     * Called by the Scheduler every Period, all Data-Tags get the next Sequence
+     * @param _Time Current Time
+     */
+    void Perf::update (struct tm &_Time) {
+      DataSeq = ++Sequence;
+    }
+
+    /**
+     * @brief Add a measured Function
+     * Slots are never removed, the Statistic lives in fixed RAM
+     * @param _Name Name of the Slot, has to stay valid (String-Literal)
+     * @return uint8_t Index of the Slot, JCA_FNC_PERF_SLOTS if no Slot is free
+     */
+    uint8_t Perf::addSlot (const char *_Name) {
+      for (uint8_t i = 0; i < SlotCount; i++) {
+        if (Slots[i].Name == _Name) {
+          return i;
+        }
+      }
+      if (SlotCount >= JCA_FNC_PERF_SLOTS) {
+        JCA_DEBUG_PRINTLN (FLAG_ERROR, false, Name, __func__, "No free Slot");
+        return JCA_FNC_PERF_SLOTS;
+      }
+      PerfSlot &Slot = Slots[SlotCount];
+      Slot.Name = _Name;
+      Slot.Time.setBounds (Bounds, JCA_FNC_PERF_BOUNDS);
+      return SlotCount++;
+    }
+
+    /**
+     * @brief Add a Measurement to a Slot
+     *
+     * @param _Slot Index of the Slot (addSlot)
+     * @param _Cycles Run-Time in CPU-Cycles
+     */
+    void Perf::add (uint8_t _Slot, uint32_t _Cycles) {
+      if (_Slot < SlotCount) {
+        Slots[_Slot].Time.add (_Cycles / ESP.getCpuFreqMHz ());
+      }
+    }
+
+    /**
+     * @brief Add the Time since the Start of a measured Function
+     *
+     * @param _Slot Index of the Slot (addSlot)
+     * @param _StartCycles ESP.getCycleCount () at the Start of the Function
+     */
+    void Perf::measure (uint8_t _Slot, uint32_t _StartCycles) {
+      add (_Slot, ESP.getCycleCount () - _StartCycles);
+    }
+
+    /**
+     * @brief Measure the Cycle-Time of the Main-Loop
+     * Has to be called once at the Start of loop()
+     */
+    void Perf::loop () {
+      uint32_t Cycles = ESP.getCycleCount ();
+      if (LoopStarted) {
+        add (LoopSlot, Cycles - LastLoop);
+      }
+      LastLoop = Cycles;
+      LoopStarted = true;
+    }
+
+    /**
+     * @brief Clear the Statistic of all Slots
+     * The Slots stay registered
+     */
+    void Perf::reset () {
+      JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, Name, __func__, "Reset");
+      for (uint8_t i = 0; i < SlotCount; i++) {
+        Slots[i].Time.reset ();
+      }
+      LoopStarted = false;
+      DataSeq = ++Sequence;
+    }
+
+    /**
+     * @brief Profiler-Callback of the Scheduler
+     * The Slot of an Element is created with the first Measurement
+     * @param _Name Name of the Element
+     * @param _Cycles Run-Time of update() in CPU-Cycles
+     */
+    void Perf::onProfile (const char *_Name, uint32_t _Cycles) {
+      if (Instance != nullptr) {
+        Instance->add (Instance->addSlot (_Name), _Cycles);
+      }
+    }
+
+    /**
+     * @brief Create the Tag-Name of a Slot-Field
+     *
+     * @param _Buffer Buffer for the Name (JCA_FNC_PERF_TAGLENGTH)
+     * @param _Slot Slot-Index (0 based)
+     * @param _Field Field-Name, like "Max"
+     */
+    void Perf::getSlotTag (char *_Buffer, uint8_t _Slot, const char *_Field) {
+      snprintf (_Buffer, JCA_FNC_PERF_TAGLENGTH, "%s%s", Slots[_Slot].Name, _Field);
+    }
+  }
+}
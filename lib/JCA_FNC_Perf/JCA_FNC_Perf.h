@@ -0,0 +1,81 @@
+#ifndef _JCA_FNC_PERF_
+#define _JCA_FNC_PERF_
+
+#include <ArduinoJson.h>
+#include <time.h>
+
+#include <JCA_FNC_Parent.h>
+#include <JCA_SYS_DebugOut.h>
+#include <JCA_SYS_Histogram.h>
+
+// Number of measured Slots (Elements, handle, loop)
+#define JCA_FNC_PERF_SLOTS 8
+// Number of Histogram-Bounds, Powers of 2 from 2 us
+#define JCA_FNC_PERF_BOUNDS 16
+// Default Publish-Period of the Statistic (ms)
+#define JCA_FNC_PERF_PERIOD 5000
+#define JCA_FNC_PERF_TAGLENGTH 40
+
+namespace JCA {
+  namespace FNC {
+    /**
+     * @brief
+     * Run-Time Statistic of one measured Function
+     */
+    struct PerfSlot {
+      const char *Name;            ///< Name of the Slot, compared by Pointer
+      JCA::SYS::Histogram Time;    ///< Run-Times in us
+    };
+
+    class Perf : public Protocol {
+    private:
+      // Datapoint description
+      static const TagDescriptor<Perf> Tags[];
+      static const uint32_t Bounds[JCA_FNC_PERF_BOUNDS];
+      static const char *Min_Name;
+      static const char *Max_Name;
+      static const char *Mean_Name;
+      static const char *Count_Name;
+      static const char *Hist_Name;
+      static Perf *Instance;
+
+      // Protocol Functions
+      void createConfigValues (JsonObject &_Values);
+      void createDataValues (JsonObject &_Values);
+      void trackChanges ();
+      void setConfig (JsonArray _Tags);
+      void setData (JsonArray _Tags);
+      void setCmd (JsonArray _Tags);
+
+      void writeSetupConfig (JCA::SYS::JsonStream &_Setup);
+      void writeSetupData (JCA::SYS::JsonStream &_Setup);
+      void writeSetupCmdInfo (JCA::SYS::JsonStream &_Setup);
+
+      // Konfig
+      uint32_t Period;
+
+      // Daten
+      PerfSlot Slots[JCA_FNC_PERF_SLOTS];
+      uint8_t SlotCount;
+      uint8_t LoopSlot;
+      uint32_t LastLoop;
+      bool LoopStarted;
+
+      void onPeriodChanged ();
+      void doReset (JsonVariant _Value);
+      void getSlotTag (char *_Buffer, uint8_t _Slot, const char *_Field);
+      static void onProfile (const char *_Name, uint32_t _Cycles);
+
+    public:
+      Perf (const char *_Name);
+      void update (struct tm &_Time);
+      uint8_t addSlot (const char *_Name);
+      void add (uint8_t _Slot, uint32_t _Cycles);
+      void measure (uint8_t _Slot, uint32_t _StartCycles);
+      void loop ();
+      void reset ();
+    };
+  }
+}
+
+#endif
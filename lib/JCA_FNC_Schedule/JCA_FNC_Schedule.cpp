@@ -0,0 +1,71 @@
+#include <JCA_FNC_Schedule.h>
+
+namespace JCA {
+  namespace FNC {
+    Schedule::Schedule () {
+      Count = 0;
+    }
+
+    /**
+     * @brief Sort the active Slots by Time of Day
+     * Slots with invalid Time or without Weekday are skipped.
+     * @param _Slots JCA_FNC_FEEDER_SLOTS Slots of the Feeder
+     */
+    void Schedule::compile (const FeedingSlot *_Slots) {
+      Count = 0;
+      for (uint8_t i = 0; i < JCA_FNC_FEEDER_SLOTS; i++) {
+        const FeedingSlot &Slot = _Slots[i];
+        if (Slot.Hour < 0 || Slot.Hour > 23 || Slot.Minute < 0 || Slot.Minute > 59 || Slot.Days == 0) {
+          continue;
+        }
+        // Insertion Sort, Minute of Day
+        int16_t SlotMinute = Slot.Hour * 60 + Slot.Minute;
+        uint8_t Pos = Count;
+        while (Pos > 0 && _Slots[Order[Pos - 1]].Hour * 60 + _Slots[Order[Pos - 1]].Minute > SlotMinute) {
+          Order[Pos] = Order[Pos - 1];
+          Pos--;
+        }
+        Order[Pos] = i;
+        Count++;
+      }
+    }
+
+    /**
+     * @brief Search the next due Slot
+     * Search the sorted Slots of today and the next 7 Days for the first Time after _Time.
+     * @param _Slots Slots of the Feeder, the same as on compile()
+     * @param _Time Current local Time
+     * @param _Delta Seconds until the Slot is due
+     * @param _Slot Index of the due Slot
+     * @return true a Slot was found
+     * @return false no active Slot
+     */
+    bool Schedule::next (const FeedingSlot *_Slots, const struct tm &_Time, int32_t &_Delta, uint8_t &_Slot) {
+      int32_t DaySeconds = _Time.tm_hour * 3600L + _Time.tm_min * 60L + _Time.tm_sec;
+      for (uint8_t Day = 0; Day <= 7 && Count > 0; Day++) {
+        uint8_t WeekDay = (_Time.tm_wday + Day) % 7;
+        for (uint8_t i = 0; i < Count; i++) {
+          const FeedingSlot &Slot = _Slots[Order[i]];
+          if ((Slot.Days & (1 << WeekDay)) == 0) {
+            continue;
+          }
+          int32_t Delta = Day * 86400L + Slot.Hour * 3600L + Slot.Minute * 60L - DaySeconds;
+          if (Delta > 0) {
+            _Delta = Delta;
+            _Slot = Order[i];
+            return true;
+          }
+        }
+      }
+      return false;
+    }
+
+    uint8_t Schedule::size () {
+      return Count;
+    }
+
+    uint8_t Schedule::slot (uint8_t _Index) {
+      return _Index < Count ? Order[_Index] : 0;
+    }
+  }
+}
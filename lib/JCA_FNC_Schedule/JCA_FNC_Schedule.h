@@ -0,0 +1,40 @@
+#ifndef _JCA_FNC_SCHEDULE_
+#define _JCA_FNC_SCHEDULE_
+
+#include <Arduino.h>
+#include <time.h>
+
+// Number of Feeding-Slots per Day
+#define JCA_FNC_FEEDER_SLOTS 4
+// Weekday-Mask (Bit 0 = Sunday, like tm_wday)
+#define JCA_FNC_FEEDER_DAYS_ALL 0x7F
+
+namespace JCA {
+  namespace FNC {
+    struct FeedingSlot {
+      int16_t Hour;   ///< Hour of the Feeding, -1 = Slot disabled
+      int16_t Minute; ///< Minute of the Feeding
+      uint8_t Days;   ///< Weekday-Mask (Bit 0 = Sunday)
+      float Dose;     ///< Rotations, 0 = use FeedingRotations
+    };
+
+    /**
+     * @brief
+     * Weekly Plan of the Feeding-Slots, the active Slots are sorted by Time of Day
+     */
+    class Schedule {
+    private:
+      uint8_t Order[JCA_FNC_FEEDER_SLOTS];
+      uint8_t Count;
+
+    public:
+      Schedule ();
+      void compile (const FeedingSlot *_Slots);
+      bool next (const FeedingSlot *_Slots, const struct tm &_Time, int32_t &_Delta, uint8_t &_Slot);
+      uint8_t size ();
+      uint8_t slot (uint8_t _Index);
+    };
+  }
+}
+
+#endif
@@ -14,7 +14,15 @@
  *     - Reset the controller
  * - Style Sheet
  * - Navigation and Logo Icons
+ * - Metrics [/metrics], Prometheus Text-Format
+ * - Admission-Control, Token-Bucket per Client-IP and Route for RestAPI and WebSocket-Messages
+ *   - Limited Requests are answered with 429 before the Body is parsed, the Limits are tightened while an Element is moving
  * - RestAPI
+ *   - /api/elements/<Element>[/<data|config|cmd>[/<Tag>]], direct Access to one Element
+ * - Server-Sent Events [/events], read only Updates serialized once in the Snapshots
+ *   - Resume with Last-Event-ID, a complete Update is sent periodically
+ * - Motion-Priority, while an Element is moving (Protocol::inMotion) Updates and Background-Jobs are deferred,
+ *   at most for JCA_FNC_PROTOCOL_MOTIONHOLD, then they run once and are deferred again
  * - WebSocket
  *   - Websockt use RestAPI Callback-Functions for Events if no other is defined
  *     - onWsEvent : Default = onRestApiPost
@@ -55,7 +63,10 @@
 #include <JCA_IOT_Webserver_SVGs.h>
 #include <JCA_IOT_Webserver_Sites.h>
 #include <JCA_IOT_WiFiConnect.h>
+#include <JCA_SYS_BufferPool.h>
 #include <JCA_SYS_DebugOut.h>
+#include <JCA_SYS_Histogram.h>
+#include <JCA_SYS_JsonPool.h>
 
 // Manual setting Firmware withpout Git
 #ifndef AUTO_VERSION
@@ -82,6 +93,73 @@
 #define JCA_IOT_WEBSERVER_CONFKEY_PORT "port"
 // JSON Keys for Web-Socket Config
 #define JCA_IOT_WEBSERVER_CONFKEY_SOCKETUPDATE "wsUpdate"
+// Number of WebSocket-Clients with own Change-Sequence, more Clients are rejected
+#define JCA_IOT_WEBSERVER_WS_MAXCLIENTS 8
+// Text of the per-Client Statistics, built only for full Requests
+#define JCA_IOT_WEBSERVER_CLIENTINFO_LENGTH 256
+// Connection-Manager, Clients are pinged periodically and closed if unresponsive or idle
+#define JCA_IOT_WEBSERVER_WS_MANAGECYCLE 1000
+#define JCA_IOT_WEBSERVER_WS_PINGINTERVAL 15000
+#define JCA_IOT_WEBSERVER_WS_PINGTIMEOUT 10000
+#define JCA_IOT_WEBSERVER_WS_IDLETIMEOUT 3600
+#define JCA_IOT_WEBSERVER_WS_CLOSE_TRYAGAIN 1013
+// Subscription of a WebSocket-Client ({"subscribe": {"elements": [], "groups": [], "tags": [], "rate": ...}}), stored as JSON-Text
+#define JCA_IOT_WEBSERVER_WS_SUBSCRIPTION_MAXSIZE 128
+#define JCA_IOT_WEBSERVER_WS_SUBSCRIPTION_DOCSIZE 384
+// Rate-Classes of the Subscription in ms, "normal" uses the Update-Cycle
+#define JCA_IOT_WEBSERVER_WS_KEY_RATE "rate"
+#define JCA_IOT_WEBSERVER_WS_RATE_FAST 200
+#define JCA_IOT_WEBSERVER_WS_RATE_SLOW 5000
+// Signaled Changes are pushed coalesced with this minimum Interval, Clients without Changes get a Heartbeat
+#define JCA_IOT_WEBSERVER_WS_MININTERVAL 50
+#define JCA_IOT_WEBSERVER_WS_HEARTBEAT 30000
+// Command-Replies waiting per Client while its Send-Queue is full, Updates are merged instead of queued
+#define JCA_IOT_WEBSERVER_WS_QUEUESIZE 2
+// Sent Messages, the Buffers are deleted when the Clients are done with them
+#define JCA_IOT_WEBSERVER_WS_SENTBUFFERS (JCA_IOT_WEBSERVER_WS_MAXCLIENTS * JCA_IOT_WEBSERVER_WS_QUEUESIZE)
+// Pools of reusable JSON-Documents for incoming Messages and Responses
+#define JCA_IOT_WEBSERVER_DOCPOOL_IN_COUNT 2
+#define JCA_IOT_WEBSERVER_DOCPOOL_IN_CAPACITY 1000
+#define JCA_IOT_WEBSERVER_DOCPOOL_OUT_COUNT 2
+#define JCA_IOT_WEBSERVER_DOCPOOL_OUT_CAPACITY 10000
+// Pool of Buffers to collect incoming WebSocket-Messages and RestAPI-Bodies, longer Messages are rejected
+#define JCA_IOT_WEBSERVER_MSGPOOL_COUNT 4
+#define JCA_IOT_WEBSERVER_MSG_MAXSIZE 1024
+// Number of shared Update-Messages (Sequence and Format) per Change
+#define JCA_IOT_WEBSERVER_SNAPSHOTS 6
+// Header for the Change-Sequence of the RestAPI
+#define JCA_IOT_WEBSERVER_HEADER_ETAG "ETag"
+#define JCA_IOT_WEBSERVER_HEADER_IFNONEMATCH "If-None-Match"
+// MessagePack instead of JSON-Text, requested by Accept-Header (RestAPI) or Subprotocol (WebSocket)
+#define JCA_IOT_WEBSERVER_HEADER_ACCEPT "Accept"
+#define JCA_IOT_WEBSERVER_HEADER_WSPROTOCOL "Sec-WebSocket-Protocol"
+#define JCA_IOT_WEBSERVER_CONTENTTYPE_JSON "application/json"
+#define JCA_IOT_WEBSERVER_CONTENTTYPE_MSGPACK "application/msgpack"
+#define JCA_IOT_WEBSERVER_WS_PROTOCOL_MSGPACK "msgpack"
+// RestAPI, Routes of single Elements
+#define JCA_IOT_WEBSERVER_PATH_API "/api"
+#define JCA_IOT_WEBSERVER_PATH_API_ELEMENTS "/api/elements"
+#define JCA_IOT_WEBSERVER_PATH_API_MAXLENGTH 96
+// Server-Sent Events, Updates in the Update-Cycle, all Values in the Full-Cycle
+#define JCA_IOT_WEBSERVER_PATH_EVENTS "/events"
+#define JCA_IOT_WEBSERVER_EVENTS_MAXCLIENTS 12
+#define JCA_IOT_WEBSERVER_EVENTS_FULLCYCLE 60000
+#define JCA_IOT_WEBSERVER_EVENTS_NAME "update"
+// Metrics, Latency-Buckets of the Routes in us
+#define JCA_IOT_WEBSERVER_PATH_METRICS "/metrics"
+#define JCA_IOT_WEBSERVER_CONTENTTYPE_METRICS "text/plain; version=0.0.4"
+#define JCA_IOT_WEBSERVER_METRICS_BUCKETS 10
+// Admission-Control, Token-Bucket per Client-IP and Route, Rate in Requests per Second (0 = unlimited)
+#define JCA_IOT_WEBSERVER_ADMISSION_SLOTS 16
+#define JCA_IOT_WEBSERVER_ADMISSION_API_RATE 10
+#define JCA_IOT_WEBSERVER_ADMISSION_WS_RATE 20
+#define JCA_IOT_WEBSERVER_ADMISSION_BURST 5
+// While an Element is moving the Rate is divided and the Burst is limited to one Request
+#define JCA_IOT_WEBSERVER_ADMISSION_MOTIONDIVIDER 4
+#define JCA_IOT_WEBSERVER_HEADER_RETRYAFTER "Retry-After"
+// Background-Jobs like saving the Config, deferred while an Element is moving, Jobs with the same Key are queued once
+#define JCA_IOT_WEBSERVER_JOBS 4
+#define JCA_IOT_WEBSERVER_JOB_SAVECONFIG "saveConfig"
 // Website Config
 #define JCA_IOT_WEBSERVER_PATH_CONNECT "/connect"
 #define JCA_IOT_WEBSERVER_PATH_SYS "/sys"
@@ -101,30 +179,109 @@ namespace JCA {
     typedef std::function<void (JsonVariant &_In, JsonVariant &_Out)> JsonVariantCallback;
     typedef std::function<void (void)> SimpleCallback;
 
+    /**
+     * @brief
+     * Routes with own Request-Statistics
+     */
+    enum WEBSERVER_ROUTES : uint8_t {
+      ROUTE_API,     ///< RestAPI [/api]
+      ROUTE_WS,      ///< Messages of the WebSocket [/ws]
+      ROUTE_SYS,     ///< System- and Connect-Pages [/sys, /connect]
+      ROUTE_WEB,     ///< Custom Pages [/, /home.htm, /config.htm]
+      ROUTE_STATIC,  ///< Files of the Filesystem, until the Response is started
+      ROUTE_METRICS, ///< Metrics [/metrics]
+      ROUTE_COUNT
+    };
+
+    /**
+     * @brief
+     * Pass the Requests to another Handler and measure the Latency, like Webserver::measureRoute() for Handlers without Callback
+     */
+    class MeasuredWebHandler : public AsyncWebHandler {
+    private:
+      AsyncWebHandler *Handler;
+      JCA::SYS::Histogram &Latency;
+
+    public:
+      MeasuredWebHandler (AsyncWebHandler *_Handler, JCA::SYS::Histogram &_Latency);
+      bool canHandle (AsyncWebServerRequest *_Request) override;
+      void handleRequest (AsyncWebServerRequest *_Request) override;
+      bool isRequestHandlerTrivial () override;
+    };
+
+    /**
+     * @brief
+     * Token-Bucket of one Client-IP and Route, the least recently used Bucket is reused for new Clients
+     */
+    struct AdmissionBucket {
+      uint32_t Ip;             ///< IP of the Client, 0 if unused
+      WEBSERVER_ROUTES Route;  ///< Limited Route
+      uint32_t Tokens;         ///< Available Requests in 1/1000
+      uint32_t LastRefill;     ///< millis() of the last Request
+    };
+
+    /**
+     * @brief
+     * Serialized Command-Reply waiting for a busy Client
+     */
+    struct WsQueuedMessage {
+      AsyncWebSocketMessageBuffer *Buffer; ///< Message, passed to the Client without Copy
+      uint32_t Since;                      ///< Sequence of the Client before the Message, restored if the Message is dropped
+      bool Update;                         ///< Update like the Heartbeat, merged into the next Update if a Command-Reply needs the Place
+    };
+
+    /**
+     * @brief
+     * Last Change-Sequence sent to a WebSocket-Client, the Client gets only Changes after it
+     */
+    struct WsClientState {
+      uint32_t Id;  ///< Id of the WebSocket-Client, 0 if unused
+      uint32_t Seq; ///< Sequence of the last Update, 0 requests all Values
+      bool Binary;  ///< Messages as MessagePack instead of JSON-Text
+      uint8_t *Buffer; ///< Message-Buffer while a Message is collected, nullptr if not used
+      uint32_t Interval;   ///< Update-Interval of the Rate-Class in ms, 0 for the Update-Cycle
+      uint32_t LastUpdate; ///< millis() of the last Update
+      uint32_t LastSent;   ///< millis() of the last Message, for the Heartbeat
+      char Subscription[JCA_IOT_WEBSERVER_WS_SUBSCRIPTION_MAXSIZE]; ///< Subscribed Elements, Groups and Tags, empty for all Values
+      WsQueuedMessage Queue[JCA_IOT_WEBSERVER_WS_QUEUESIZE]; ///< Command-Replies and Heartbeats, sent before Updates
+      uint8_t Queued;     ///< Number of Messages in the Queue
+      bool UpdatePending; ///< Update was due while the Client was busy
+      uint32_t Dropped;   ///< Command-Replies dropped because the Queue was full
+      uint32_t Coalesced; ///< Updates merged into the next one because the Client was busy
+      uint32_t LastSeen;  ///< millis() of the last Message or Pong from the Client
+      uint32_t PingSent;  ///< millis() of the last Ping
+      bool PingPending;   ///< Ping sent, Pong not received
+      uint32_t Rtt;       ///< Round-Trip-Time of the last Ping in ms
+    };
+
+    /**
+     * @brief
+     * Serialized Update, shared by all Clients with the same Sequence and Format until the next Change
+     */
+    struct Snapshot {
+      uint32_t Since;                      ///< Contains the Changes after this Sequence, 0 for all Values
+      uint32_t Filter;                     ///< Hash of the Subscription, 0 for all Values
+      uint32_t Seq;                        ///< Sequence of the Update, 0 if the Callback doesn't support Change-Tracking
+      bool Binary;                         ///< MessagePack instead of JSON-Text
+      bool Current;                        ///< No Change since the Snapshot is created
+      uint32_t LastUsed;                   ///< millis() of the last Request, the least recently used Snapshot is replaced
+      AsyncWebSocketMessageBuffer *Buffer; ///< Message, nullptr if nothing changed after Since
+    };
+
     class Webserver : public JCA::FNC::Protocol {
     private:
       // ...Webserver_System.cpp
       static const char *ElementName;
-      static const char *Hostname_Name;
-      static const char *Hostname_Text;
-      static const char *Hostname_Comment;
-      static const char *WsUpdateCycle_Name;
-      static const char *WsUpdateCycle_Text;
-      static const char *WsUpdateCycle_Unit;
-      static const char *WsUpdateCycle_Comment;
-      static const char *TimeSync_Name;
-      static const char *TimeSync_Text;
-      static const char *TimeSync_Type;
-      static const char *TimeSync_Comment;
-      static const char *SaveConfig_Name;
-      static const char *SaveConfig_Text;
-      static const char *SaveConfig_Type;
-      static const char *SaveConfig_Comment;
-      static const char *SaveConfig_BtnText;
       static const char *Time_Name;
       static const char *Time_Text;
-      static const char *Time_Comment;
-      char Hostname[80];
+      static const char *Rtt_Name;
+      static const char *Rtt_Text;
+      static const char *Rtt_Comment;
+      static const char *Clients_Name;
+      static const char *Clients_Text;
+      static const char *Clients_Comment;
+      static const JCA::FNC::TagDescriptor<Webserver> Tags[];
+      String Hostname;
       char ConfUser[80];
       char ConfPassword[80];
       char Firmware[80];
@@ -138,17 +295,45 @@ namespace JCA {
       SimpleCallback onSystemResetCB;
       SimpleCallback onSaveConfigCB;
       bool readConfig ();
+      void getClientInfo (char *_Buffer, size_t _Size);
+      uint32_t DocsMaxUsed;
+      uint32_t DocsMaxMemory;
+      uint32_t DocsBusy;
+      JCA::SYS::JsonPool InDocs;
+      JCA::SYS::JsonPool OutDocs;
+      uint32_t MsgOversize;
+      uint32_t MsgBusy;
+      JCA::SYS::BufferPool MsgBuffers;
+      uint32_t WsQueued;
+      uint32_t WsDropped;
+      uint32_t WsCoalesced;
+      uint32_t WsConnected;
+      uint32_t WsRtt;
+      uint32_t WsRejected;
+      uint32_t WsEvicted;
+      uint32_t AdmitLimited;
+      SimpleCallback Jobs[JCA_IOT_WEBSERVER_JOBS];
+      const char *JobKeys[JCA_IOT_WEBSERVER_JOBS];
+      uint16_t JobCount;
+      bool MotionActive;
+      uint32_t MotionLastRun;
+      uint32_t UpdatesDeferred;
+      uint32_t DebugHeld;
+      uint32_t DebugDropped;
+      void doTimeSync (JsonVariant _Value);
+      void doSaveConfig (JsonVariant _Value);
 
       // Protocol Functions
       void createConfigValues (JsonObject &_Values);
       void createDataValues (JsonObject &_Values);
+      void trackChanges ();
       void setConfig (JsonArray _Tags);
       void setData (JsonArray _Tags);
       void setCmd (JsonArray _Tags);
 
-      void writeSetupConfig (File _SetupFile);
-      void writeSetupData (File _SetupFile);
-      void writeSetupCmdInfo (File _SetupFile);
+      void writeSetupConfig (JCA::SYS::JsonStream &_Setup);
+      void writeSetupData (JCA::SYS::JsonStream &_Setup);
+      void writeSetupCmdInfo (JCA::SYS::JsonStream &_Setup);
 
       // ...Webserver_Web.cpp
       AwsTemplateProcessor replaceHomeWildcardsCB;
@@ -174,16 +359,73 @@ namespace JCA {
       JsonVariantCallback restApiPutCB;
       JsonVariantCallback restApiPatchCB;
       JsonVariantCallback restApiDeleteCB;
+      void onRestApiData (AsyncWebServerRequest *_Request, uint8_t *_Data, size_t _Len, size_t _Index, size_t _Total);
+      void onRestApiReceived (AsyncWebServerRequest *_Request);
+      void releaseRestApiBuffer (AsyncWebServerRequest *_Request);
       void onRestApiRequest (AsyncWebServerRequest *_Request, JsonVariant &_Json);
+      void onRestApiElement (AsyncWebServerRequest *_Request);
+      void sendRestApiResponse (AsyncWebServerRequest *_Request, JsonVariant &_Data, bool _Binary, bool _ETag);
+      bool sendSnapshot (AsyncWebServerRequest *_Request, uint32_t _Since, bool _Binary);
+
+      // ...Webserver_Snapshot.cpp
+      Snapshot Snapshots[JCA_IOT_WEBSERVER_SNAPSHOTS];
+      uint32_t SnapshotSeq;
+      bool createUpdate (uint32_t _Since, const char *_Subscription, JsonDocument &_Doc, uint32_t &_Seq);
+      uint32_t updateSnapshots ();
+      Snapshot *getSnapshot (uint32_t _Since, bool _Binary, const char *_Subscription = nullptr);
+
+      // ...Webserver_Events.cpp
+      AsyncEventSource Events;
+      uint32_t EventsSeq;
+      uint32_t EventsLastUpdate;
+      uint32_t EventsLastFull;
+      uint32_t EventsConnected;
+      volatile bool EventsJoined;
+      volatile uint32_t EventsJoinedSince;
+      void onEventsConnect (AsyncEventSourceClient *_Client);
+      void doEventsUpdate (bool _Force);
+
+      // ...Webserver_Admission.cpp
+      AdmissionBucket Buckets[JCA_IOT_WEBSERVER_ADMISSION_SLOTS];
+      uint16_t AdmitApiRate;
+      uint16_t AdmitWsRate;
+      uint16_t AdmitBurst;
+      uint16_t AdmitMotionDivider;
+      uint32_t RouteLimited[ROUTE_COUNT];
+      bool admit (uint32_t _Ip, WEBSERVER_ROUTES _Route, bool _Consume);
+      ArRequestHandlerFunction admitRoute (WEBSERVER_ROUTES _Route, ArRequestHandlerFunction _Handler);
+
+      // ...Webserver_Metrics.cpp
+      static const uint32_t LatencyBounds[JCA_IOT_WEBSERVER_METRICS_BUCKETS];
+      static const char *RouteNames[ROUTE_COUNT];
+      JCA::SYS::Histogram RouteLatency[ROUTE_COUNT];
+      ArRequestHandlerFunction measureRoute (WEBSERVER_ROUTES _Route, ArRequestHandlerFunction _Handler);
+      void onWebMetricsGet (AsyncWebServerRequest *_Request);
 
       // ...Webserver_Socket.cpp
       uint32_t WsUpdateCycle;
       uint32_t WsLastUpdate;
+      uint32_t WsMinInterval;
+      uint32_t WsHeartbeat;
+      uint32_t WsLastPush;
+      uint32_t WsLastManage;
+      uint32_t WsIdleTimeout;
       JsonVariantCallback wsDataCB;
       JsonVariantCallback wsUpdateCB;
+      WsClientState WsClients[JCA_IOT_WEBSERVER_WS_MAXCLIENTS];
+      AsyncWebSocketMessageBuffer *WsSent[JCA_IOT_WEBSERVER_WS_SENTBUFFERS];
+      uint8_t WsSentCount;
+      bool releaseWsBuffers ();
+      WsClientState *getWsClient (uint32_t _Id, bool _Create);
+      void releaseWsClient (WsClientState *_State);
+      void wsSend (AsyncWebSocketClient *_Client, WsClientState *_State, JsonVariant &_Data, uint32_t _Since, bool _Update = false);
+      bool wsFlush (AsyncWebSocketClient *_Client, WsClientState *_State);
+      void manageWsClients ();
       void onWsEvent (AsyncWebSocket *_Server, AsyncWebSocketClient *_Client, AwsEventType _Type, void *_Arg, uint8_t *_Data, size_t _Len);
       void wsHandleData (AsyncWebSocketClient *_Client, void *_Arg, uint8_t *_Data, size_t _Len);
-      bool doWsUpdate (AsyncWebSocketClient *_Client);
+      void wsHandleMessage (AsyncWebSocketClient *_Client, WsClientState *_State, bool _Binary, size_t _Len);
+      bool wsSubscribe (WsClientState *_State, JsonObject _Subscription);
+      bool doWsUpdate (AsyncWebSocketClient *_Client, bool _Force, bool _Signaled = false);
 
     public:
       // ...Webserver_System.cpp
@@ -198,6 +440,7 @@ namespace JCA {
       void update (struct tm &_Time);
       void onSystemReset (SimpleCallback _CB);
       void onSaveConfig (SimpleCallback _CB);
+      bool runJob (SimpleCallback _Job, const char *_Key = nullptr);
       void setTime (unsigned long _Epoch = 1609459200, int _Millis = 0); // default (1609459200) = 1st Jan 2021
       void setTime (int _Second, int _Minute, int _Hour, int _Day, int _Month, int _Year, int _Millis = 0);
       void setTimeStruct (tm _Time);
@@ -0,0 +1,103 @@
+/**
+ * @file JCA_IOT_Webserver_Admission.cpp
+ * @author JCA (https://github.com/ichok)
+ * @brief Admission-Control of the Webserver
+ * Every Client-IP gets a Token-Bucket per limited Route, a Request takes one Token.
+ * Limited Requests are rejected before a Buffer or Document is taken, so they cost nearly nothing.
+ * While an Element is moving (Protocol::inMotion) the Rate is divided and the Burst is limited to one Request.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Copyright Jochen Cabrera 2022
+ * Apache License
+ *
+ */
+#include <JCA_IOT_Webserver.h>
+using namespace JCA::SYS;
+
+namespace JCA {
+  namespace IOT {
+    /**
+     * @brief Check the Token-Bucket of a Client and take a Token
+     * The Bucket is refilled with the Rate of the Route since the last Request,
+     * unknown Clients replace the least recently used Bucket and start with a full Bucket.
+     * @param _Ip IP of the Client
+     * @param _Route Route of the Request
+     * @param _Consume Take the Token, false only checks if a Token is available
+     * @return true Request is admitted
+     * @return false Client is limited
+     */
+    bool Webserver::admit (uint32_t _Ip, WEBSERVER_ROUTES _Route, bool _Consume) {
+      uint32_t Rate = 0;
+      if (_Route == ROUTE_API) {
+        Rate = AdmitApiRate;
+      } else if (_Route == ROUTE_WS) {
+        Rate = AdmitWsRate;
+      }
+      if (Rate == 0) {
+        return true;
+      }
+      uint32_t Burst = AdmitBurst > 0 ? AdmitBurst : 1;
+      if (inMotion () && AdmitMotionDivider > 1) {
+        Rate = Rate > AdmitMotionDivider ? Rate / AdmitMotionDivider : 1;
+        Burst = 1;
+      }
+      uint32_t Capacity = Burst * 1000;
+
+      // Find the Bucket of the Client, else reuse the least recently used one
+      uint32_t ActMillis = millis ();
+      AdmissionBucket *Bucket = nullptr;
+      AdmissionBucket *Oldest = &Buckets[0];
+      for (uint8_t i = 0; i < JCA_IOT_WEBSERVER_ADMISSION_SLOTS; i++) {
+        AdmissionBucket &Entry = Buckets[i];
+        if (Entry.Ip == _Ip && Entry.Route == _Route && Entry.Ip != 0) {
+          Bucket = &Entry;
+          break;
+        }
+        if (Oldest->Ip != 0 && (Entry.Ip == 0 || ActMillis - Entry.LastRefill > ActMillis - Oldest->LastRefill)) {
+          Oldest = &Entry;
+        }
+      }
+      if (Bucket == nullptr) {
+        Bucket = Oldest;
+        Bucket->Ip = _Ip;
+        Bucket->Route = _Route;
+        Bucket->Tokens = Capacity;
+      } else {
+        uint64_t Tokens = (uint64_t)Bucket->Tokens + (uint64_t)(ActMillis - Bucket->LastRefill) * Rate;
+        Bucket->Tokens = Tokens > Capacity ? Capacity : (uint32_t)Tokens;
+      }
+      Bucket->LastRefill = ActMillis;
+
+      if (Bucket->Tokens < 1000) {
+        return false;
+      }
+      if (_Consume) {
+        Bucket->Tokens -= 1000;
+      }
+      return true;
+    }
+
+    /**
+     * @brief Wrap a Request-Handler with the Admission-Control
+     * Limited Requests are answered with 429, a collected Body is given back to the Pool unparsed
+     * @param _Route Route of the Token-Bucket
+     * @param _Handler Request-Handler
+     * @return ArRequestHandlerFunction Handler for Server.on()
+     */
+    ArRequestHandlerFunction Webserver::admitRoute (WEBSERVER_ROUTES _Route, ArRequestHandlerFunction _Handler) {
+      return [this, _Route, _Handler] (AsyncWebServerRequest *_Request) {
+        if (this->admit ((uint32_t)_Request->client ()->remoteIP (), _Route, true)) {
+          _Handler (_Request);
+          return;
+        }
+        this->RouteLimited[_Route]++;
+        this->releaseRestApiBuffer (_Request);
+        JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, this->ObjectName, __func__, "+ Too Many Requests");
+        AsyncWebServerResponse *Response = _Request->beginResponse (429, "text/plain", "Too Many Requests");
+        Response->addHeader (JCA_IOT_WEBSERVER_HEADER_RETRYAFTER, "1");
+        _Request->send (Response);
+      };
+    }
+  }
+}
@@ -0,0 +1,84 @@
+/**
+ * @file JCA_IOT_Webserver_Events.cpp
+ * @author JCA (https://github.com/ichok)
+ * @brief Server-Sent Events of the Webserver
+ * Read only Channel for Displays, the Updates are serialized once in the JSON-Snapshots of the WebSocket
+ * (the Library copies the Message for every Client).
+ * The Event-Id is the Change-Sequence, so a reconnecting Client resumes with Last-Event-ID.
+ * All Snapshots are created in the Loop, the Connect-Callback only marks the Update as due.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Copyright Jochen Cabrera 2022
+ * Apache License
+ *
+ */
+#include <JCA_IOT_Webserver.h>
+using namespace JCA::SYS;
+
+namespace JCA {
+  namespace IOT {
+    /**
+     * @brief Register a new Client, it gets the Changes after Last-Event-ID with the next doEventsUpdate()
+     * Runs in the Callback of the TCP-Stack, so the Snapshots are not touched here.
+     * Clients without Last-Event-ID request all Values, Clients above the Limit are closed
+     * @param _Client Connected Client
+     */
+    void Webserver::onEventsConnect (AsyncEventSourceClient *_Client) {
+      if (Events.count () > JCA_IOT_WEBSERVER_EVENTS_MAXCLIENTS) {
+        JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "+ too many Clients, rejected");
+        _Client->close ();
+        return;
+      }
+      if (JCA_DEBUG_PRINT (FLAG_TRAFFIC, true, ObjectName, __func__, "+ Last-Event-ID: ")) {
+        JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, _Client->lastId ());
+      }
+      uint32_t LastId = _Client->lastId ();
+      if (!EventsJoined || LastId < EventsJoinedSince) {
+        EventsJoinedSince = LastId;
+      }
+      EventsJoined = true;
+    }
+
+    /**
+     * @brief Send the Changes to all Event-Clients
+     * All Clients get the same Message, Clients that missed a Message are corrected by the periodic complete Update.
+     * New Clients are served immediately with the Changes after the oldest Last-Event-ID.
+     * @param _Force Ignore the Update-Cycle
+     */
+    void Webserver::doEventsUpdate (bool _Force) {
+      uint32_t ActMillis = millis ();
+      if (Events.count () == 0) {
+        return;
+      }
+      bool Joined = EventsJoined;
+      if (!Joined && !_Force && (WsUpdateCycle == 0 || ActMillis - EventsLastUpdate < WsUpdateCycle)) {
+        return;
+      }
+      EventsLastUpdate = ActMillis;
+      bool Full = ActMillis - EventsLastFull >= JCA_IOT_WEBSERVER_EVENTS_FULLCYCLE;
+      uint32_t Since = Full ? 0 : EventsSeq;
+      if (Joined) {
+        Since = min (Since, (uint32_t)EventsJoinedSince);
+      }
+      updateSnapshots ();
+      Snapshot *Snap = getSnapshot (Since, false);
+      if (Snap == nullptr) {
+        // no Snapshot available, the new Clients are served with the next Call
+        return;
+      }
+      if (Joined) {
+        EventsJoined = false;
+      }
+      if (Snap->Buffer == nullptr) {
+        return;
+      }
+      Full = Full || Since == 0;
+      Events.send ((const char *)Snap->Buffer->get (), JCA_IOT_WEBSERVER_EVENTS_NAME, Snap->Seq);
+      EventsSeq = Snap->Seq;
+      if (Full) {
+        EventsLastFull = ActMillis;
+      }
+    }
+  }
+}
@@ -0,0 +1,119 @@
+/**
+ * @file JCA_IOT_Webserver_Metrics.cpp
+ * @author JCA (https://github.com/ichok)
+ * @brief Metrics of the Webserver in the Prometheus Text-Format
+ * Contains the numeric Data-Tags of all Elements, Request-Statistics per Route and Memory-Usage.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Copyright Jochen Cabrera 2022
+ * Apache License
+ *
+ */
+#include <JCA_IOT_Webserver.h>
+using namespace JCA::SYS;
+
+namespace JCA {
+  namespace IOT {
+    const uint32_t Webserver::LatencyBounds[JCA_IOT_WEBSERVER_METRICS_BUCKETS] = {1000, 2000, 5000, 10000, 20000, 50000, 100000, 250000, 500000, 1000000};
+    const char *Webserver::RouteNames[ROUTE_COUNT] = {"api", "ws", "sys", "web", "static", "metrics"};
+
+    /**
+     * @brief Construct a new MeasuredWebHandler object
+     *
+     * @param _Handler Handler of the Requests, like the Handler of the static Files
+     * @param _Latency Statistic of the Route
+     */
+    MeasuredWebHandler::MeasuredWebHandler (AsyncWebHandler *_Handler, Histogram &_Latency) : Latency (_Latency) {
+      Handler = _Handler;
+    }
+
+    bool MeasuredWebHandler::canHandle (AsyncWebServerRequest *_Request) {
+      return Handler->filter (_Request) && Handler->canHandle (_Request);
+    }
+
+    /**
+     * @brief Pass the Request to the Handler and measure the Time until the Response is started
+     * Files are sent asynchronous after the Handler returns, like the Responses of the other Routes
+     * @param _Request Request of the Client
+     */
+    void MeasuredWebHandler::handleRequest (AsyncWebServerRequest *_Request) {
+      uint32_t Start = micros ();
+      Handler->handleRequest (_Request);
+      Latency.add (micros () - Start);
+    }
+
+    bool MeasuredWebHandler::isRequestHandlerTrivial () {
+      return Handler->isRequestHandlerTrivial ();
+    }
+
+    /**
+     * @brief Wrap a Request-Handler to count the Requests and measure the Latency
+     *
+     * @param _Route Route of the Statistics
+     * @param _Handler Request-Handler
+     * @return ArRequestHandlerFunction Handler for Server.on()
+     */
+    ArRequestHandlerFunction Webserver::measureRoute (WEBSERVER_ROUTES _Route, ArRequestHandlerFunction _Handler) {
+      return [this, _Route, _Handler] (AsyncWebServerRequest *_Request) {
+        uint32_t Start = micros ();
+        _Handler (_Request);
+        this->RouteLatency[_Route].add (micros () - Start);
+      };
+    }
+
+    /**
+     * @brief Send the Metrics
+     * The Response is streamed, only the Values of one Element are in a Document at the same Time
+     * @param _Request Request of the Client
+     */
+    void Webserver::onWebMetricsGet (AsyncWebServerRequest *_Request) {
+      JsonPoolDoc Lease (OutDocs);
+      if (!Lease) {
+        _Request->send (503, "text/plain", "Busy");
+        return;
+      }
+      AsyncResponseStream *Stream = _Request->beginResponseStream (JCA_IOT_WEBSERVER_CONTENTTYPE_METRICS);
+
+      // Data-Tags of all Elements
+      trackAllChanges ();
+      writeAllMetrics (*Stream, *Lease);
+
+      // Requests per Route
+      Stream->print ("# TYPE jca_http_request_duration_seconds histogram\n");
+      for (uint8_t i = 0; i < ROUTE_COUNT; i++) {
+        Histogram &Latency = RouteLatency[i];
+        uint32_t Cumulative = 0;
+        for (uint8_t b = 0; b < Latency.size (); b++) {
+          Cumulative += Latency.bucket (b);
+          Stream->printf ("jca_http_request_duration_seconds_bucket{route=\"%s\",le=\"", RouteNames[i]);
+          if (Latency.bound (b) == UINT32_MAX) {
+            Stream->print ("+Inf");
+          } else {
+            Stream->print ((float)Latency.bound (b) / 1000000.0, 3);
+          }
+          Stream->printf ("\"} %u\n", Cumulative);
+        }
+        Stream->printf ("jca_http_request_duration_seconds_sum{route=\"%s\"} ", RouteNames[i]);
+        Stream->print ((double)Latency.sum () / 1000000.0, 6);
+        Stream->printf ("\njca_http_request_duration_seconds_count{route=\"%s\"} %u\n", RouteNames[i], Latency.count ());
+      }
+      Stream->print ("# TYPE jca_http_limited_total counter\n");
+      for (uint8_t i = 0; i < ROUTE_COUNT; i++) {
+        Stream->printf ("jca_http_limited_total{route=\"%s\"} %u\n", RouteNames[i], RouteLimited[i]);
+      }
+
+      // Memory
+      Stream->print ("# TYPE jca_json_memory_usage_max_bytes gauge\n");
+      Stream->printf ("jca_json_memory_usage_max_bytes{pool=\"in\"} %u\n", InDocs.maxMemory ());
+      Stream->printf ("jca_json_memory_usage_max_bytes{pool=\"out\"} %u\n", OutDocs.maxMemory ());
+      Stream->print ("# TYPE jca_heap_free_bytes gauge\n");
+      Stream->printf ("jca_heap_free_bytes %u\n", ESP.getFreeHeap ());
+      Stream->print ("# TYPE jca_heap_max_block_bytes gauge\n");
+      Stream->printf ("jca_heap_max_block_bytes %u\n", ESP.getMaxFreeBlockSize ());
+      Stream->print ("# TYPE jca_uptime_seconds counter\n");
+      Stream->printf ("jca_uptime_seconds %lu\n", millis () / 1000);
+      _Request->send (Stream);
+    }
+  }
+}
@@ -14,15 +14,146 @@ using namespace JCA::SYS;
 
 namespace JCA {
   namespace IOT {
+    /**
+     * @brief Collect the Body of a RestAPI-Request
+     * The Body is collected in a Buffer from the Pool, Bodies longer than JCA_IOT_WEBSERVER_MSG_MAXSIZE are rejected.
+     * Bodies of limited Clients are not collected, the Request is answered with 429 by the Admission-Control.
+     * @param _Request Request of the Client
+     * @param _Data Part of the Body
+     * @param _Len Length of the Part
+     * @param _Index Position of the Part inside the Body
+     * @param _Total Length of the Body
+     */
+    void Webserver::onRestApiData (AsyncWebServerRequest *_Request, uint8_t *_Data, size_t _Len, size_t _Index, size_t _Total) {
+      JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, "Data");
+      if (_Index == 0) {
+        if (!admit ((uint32_t)_Request->client ()->remoteIP (), ROUTE_API, false)) {
+          return;
+        }
+        if (_Total >= MsgBuffers.size ()) {
+          MsgOversize++;
+          JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "+ Body too long");
+          return;
+        }
+        uint8_t *Buffer = MsgBuffers.take ();
+        if (Buffer == nullptr) {
+          JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "+ no free Message-Buffer");
+          return;
+        }
+        // The Request frees _tempObject on Destruction, so the Buffer has to be back in the Pool before
+        _Request->_tempObject = Buffer;
+        _Request->onDisconnect ([this, _Request] () { this->releaseRestApiBuffer (_Request); });
+      }
+      if (_Request->_tempObject != nullptr && _Index + _Len <= _Total) {
+        memcpy ((uint8_t *)(_Request->_tempObject) + _Index, _Data, _Len);
+      }
+    }
+
+    /**
+     * @brief Give the Body-Buffer of a Request back to the Pool
+     *
+     * @param _Request Request of the Client
+     */
+    void Webserver::releaseRestApiBuffer (AsyncWebServerRequest *_Request) {
+      MsgBuffers.give ((uint8_t *)(_Request->_tempObject));
+      _Request->_tempObject = nullptr;
+    }
+
+    /**
+     * @brief Parse the complete RestAPI-Request
+     * Rejected Bodies are answered with 413 (too long) or 503 (no Buffer or Document free)
+     * @param _Request Request of the Client
+     */
+    void Webserver::onRestApiReceived (AsyncWebServerRequest *_Request) {
+      JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, "Request");
+      size_t Length = _Request->contentLength ();
+      if (Length >= MsgBuffers.size ()) {
+        _Request->send (413, "text/plain", "Payload Too Large");
+        return;
+      }
+      if (Length > 0 && _Request->_tempObject == nullptr) {
+        _Request->send (503, "text/plain", "Busy");
+        return;
+      }
+      // Fast Path without Body, nothing to parse
+      if (Length == 0) {
+        JsonVariant Empty;
+        onRestApiRequest (_Request, Empty);
+        return;
+      }
+      JsonPoolDoc InLease (InDocs);
+      if (!InLease) {
+        releaseRestApiBuffer (_Request);
+        _Request->send (503, "text/plain", "Busy");
+        return;
+      }
+      JsonDocument &JBuffer = *InLease;
+      JsonVariant InData;
+
+      if (_Request->_tempObject != nullptr) {
+        char *Body = (char *)(_Request->_tempObject);
+        Body[Length] = 0;
+        DeserializationError Error;
+        if (_Request->contentType () == JCA_IOT_WEBSERVER_CONTENTTYPE_MSGPACK) {
+          Error = deserializeMsgPack (JBuffer, (const char *)Body, Length);
+        } else {
+          Error = deserializeJson (JBuffer, Body);
+        }
+        if (Error) {
+          if (JCA_DEBUG_PRINT (FLAG_ERROR, true, ObjectName, __func__, "+ deserialize failed: ")) {
+            JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, Error.c_str ());
+            JCA_DEBUG_PRINT (FLAG_ERROR, true, ObjectName, __func__, "+ Body:");
+            JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, Body);
+          }
+          JBuffer.clear ();
+        }
+      }
+      InData = JBuffer.as<JsonVariant> ();
+      onRestApiRequest (_Request, InData);
+      releaseRestApiBuffer (_Request);
+    }
+
+    /**
+     * @brief Handle a Request to the RestAPI
+     * GET-Responses contain the current Change-Sequence as ETag,
+     * a Request with the same Sequence in If-None-Match is answered with 304 without creating the Values.
+     * GET-Requests without other Parameters than the Sequence (Body or Query-String) are answered from the shared Snapshot.
+     * @param _Request Request of the Client
+     * @param _Json Body of the Request
+     */
     void Webserver::onRestApiRequest (AsyncWebServerRequest *_Request, JsonVariant &_Json) {
-      DynamicJsonDocument JsonDoc(10000);
+      bool Binary = _Request->hasHeader (JCA_IOT_WEBSERVER_HEADER_ACCEPT) && _Request->getHeader (JCA_IOT_WEBSERVER_HEADER_ACCEPT)->value ().indexOf (JCA_IOT_WEBSERVER_CONTENTTYPE_MSGPACK) >= 0;
+      if (_Request->method () == HTTP_GET) {
+        String ETag = "\"" + String (updateSnapshots ()) + "\"";
+        if (_Request->hasHeader (JCA_IOT_WEBSERVER_HEADER_IFNONEMATCH) && _Request->getHeader (JCA_IOT_WEBSERVER_HEADER_IFNONEMATCH)->value () == ETag) {
+          JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, "+ Not Modified");
+          _Request->send (304);
+          return;
+        }
+        // the Sequence is read from the Body or from the Query-String (GET /api?seq=123)
+        uint32_t Since = _Json[JsonTagSequence].as<uint32_t> ();
+        if (!_Json.containsKey (JsonTagSequence) && _Request->hasParam (JsonTagSequence)) {
+          Since = strtoul (_Request->getParam (JsonTagSequence)->value ().c_str (), nullptr, 10);
+        }
+        if (_Json.size () == (_Json.containsKey (JsonTagSequence) ? 1 : 0) && sendSnapshot (_Request, Since, Binary)) {
+          return;
+        }
+      }
+
+      JsonPoolDoc OutLease (OutDocs);
+      if (!OutLease) {
+        JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "+ no free JSON-Document");
+        _Request->send (503, "text/plain", "Busy");
+        return;
+      }
+      JsonDocument &JsonDoc = *OutLease;
       JsonVariant OutData = JsonDoc.as<JsonVariant>();
 
-      if (Debug.println (FLAG_TRAFFIC, true, ObjectName, __func__, _Request->methodToString ())) {
-        Debug.print (FLAG_TRAFFIC, true, ObjectName, __func__, "+ Body:");
+      if (JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, _Request->methodToString ())) {
+        JCA_DEBUG_PRINT (FLAG_TRAFFIC, true, ObjectName, __func__, "+ Body:");
         String JsonBody;
         serializeJson (_Json, JsonBody);
-        Debug.println (FLAG_TRAFFIC, true, ObjectName, __func__, JsonBody);
+        JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, JsonBody);
       }
 
       // Call externak datahandling Functions
@@ -64,12 +195,204 @@ namespace JCA {
       // Add System Informations
       OutData["used"] = JsonDoc.memoryUsage();
 
-      // Create Response
-      String response;
-      serializeJson (OutData, response);
-      Debug.print (FLAG_TRAFFIC, true, ObjectName, __func__, "+ Response:");
-      Debug.println (FLAG_TRAFFIC, true, ObjectName, __func__, response);
-      _Request->send (200, "application/json", response);
+      sendRestApiResponse (_Request, OutData, Binary, _Request->method () == HTTP_GET);
+    }
+
+    /**
+     * @brief Send the Response of a RestAPI-Request
+     *
+     * @param _Request Request of the Client
+     * @param _Data Body of the Response
+     * @param _Binary MessagePack instead of JSON-Text
+     * @param _ETag Add the current Change-Sequence as ETag
+     */
+    void Webserver::sendRestApiResponse (AsyncWebServerRequest *_Request, JsonVariant &_Data, bool _Binary, bool _ETag) {
+      AsyncWebServerResponse *Response;
+      if (_Binary) {
+        AsyncResponseStream *Stream = _Request->beginResponseStream (JCA_IOT_WEBSERVER_CONTENTTYPE_MSGPACK);
+        serializeMsgPack (_Data, *Stream);
+        JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, "+ Response: MessagePack");
+        Response = Stream;
+      } else {
+        String response;
+        serializeJson (_Data, response);
+        JCA_DEBUG_PRINT (FLAG_TRAFFIC, true, ObjectName, __func__, "+ Response:");
+        JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, response);
+        Response = _Request->beginResponse (200, JCA_IOT_WEBSERVER_CONTENTTYPE_JSON, response);
+      }
+      if (_ETag) {
+        Response->addHeader (JCA_IOT_WEBSERVER_HEADER_ETAG, "\"" + String (getSequence ()) + "\"");
+      }
+      _Request->send (Response);
+    }
+
+    /**
+     * @brief Handle a Request to a single Element (/api/elements/<Element>[/<Group>[/<Tag>]])
+     * The Element is found by the Name-Index, only its Block is created.
+     * GET returns the Block ({"data": {}, "config": {}}) or a single Tag ({"name": ..., "value": ...}).
+     * POST, PUT and PATCH set the Block (Body as Array of Tags or Object of Name-Value-Pairs)
+     * or a single Tag (Body as Value or {"value": ...}) and return the new Values.
+     * @param _Request Request of the Client
+     */
+    void Webserver::onRestApiElement (AsyncWebServerRequest *_Request) {
+      char Path[JCA_IOT_WEBSERVER_PATH_API_MAXLENGTH];
+      strncpy (Path, _Request->url ().c_str () + strlen (JCA_IOT_WEBSERVER_PATH_API_ELEMENTS), sizeof (Path));
+      Path[sizeof (Path) - 1] = '\0';
+      char *Save = nullptr;
+      char *ElementName = strtok_r (Path, "/", &Save);
+      char *Group = strtok_r (nullptr, "/", &Save);
+      char *TagName = strtok_r (nullptr, "/", &Save);
+      if (ElementName == nullptr) {
+        onRestApiReceived (_Request);
+        return;
+      }
+      Protocol *Element = findElement (ElementName);
+      if (Element == nullptr) {
+        releaseRestApiBuffer (_Request);
+        _Request->send (404, "text/plain", "Unknown Element");
+        return;
+      }
+      bool Write = _Request->method () == HTTP_POST || _Request->method () == HTTP_PUT || _Request->method () == HTTP_PATCH;
+      if (!Write && _Request->method () != HTTP_GET) {
+        releaseRestApiBuffer (_Request);
+        _Request->send (405, "text/plain", "Method Not Allowed");
+        return;
+      }
+      size_t Length = _Request->contentLength ();
+      if (Write && (Group == nullptr || Length == 0 || Length >= MsgBuffers.size () || _Request->_tempObject == nullptr)) {
+        releaseRestApiBuffer (_Request);
+        _Request->send (Length >= MsgBuffers.size () ? 413 : 400, "text/plain", "Invalid Body");
+        return;
+      }
+
+      JsonPoolDoc OutLease (OutDocs);
+      if (!OutLease) {
+        releaseRestApiBuffer (_Request);
+        _Request->send (503, "text/plain", "Busy");
+        return;
+      }
+      JsonDocument &JsonOutDoc = *OutLease;
+
+      // Set the Tags, the Body is wrapped as Element-Array of the Protocol
+      if (Write) {
+        JsonPoolDoc InLease (InDocs);
+        if (!InLease) {
+          releaseRestApiBuffer (_Request);
+          _Request->send (503, "text/plain", "Busy");
+          return;
+        }
+        char *Body = (char *)(_Request->_tempObject);
+        Body[Length] = 0;
+        DeserializationError Error;
+        if (_Request->contentType () == JCA_IOT_WEBSERVER_CONTENTTYPE_MSGPACK) {
+          Error = deserializeMsgPack (*InLease, (const char *)Body, Length);
+        } else {
+          Error = deserializeJson (*InLease, Body);
+        }
+        if (Error) {
+          releaseRestApiBuffer (_Request);
+          _Request->send (400, "text/plain", Error.c_str ());
+          return;
+        }
+        JsonVariant InData = InLease->as<JsonVariant> ();
+        JsonArray Elements = JsonOutDoc.to<JsonArray> ();
+        JsonObject Target = Elements.createNestedObject ();
+        Target[JsonTagName] = (const char *)ElementName;
+        JsonArray Tags = Target.createNestedArray ((const char *)Group);
+        if (TagName != nullptr) {
+          JsonObject Tag = Tags.createNestedObject ();
+          Tag[JsonTagName] = (const char *)TagName;
+          // The Value is sent plain or as {"value": ...}
+          JsonVariant Wrapped = InData[JsonTagValue];
+          Tag[JsonTagValue] = Wrapped.isNull () ? InData : Wrapped;
+        } else if (InData.is<JsonArray> ()) {
+          for (JsonVariant Tag : InData.as<JsonArray> ()) {
+            Tags.add (Tag);
+          }
+        } else {
+          for (JsonPair Pair : InData.as<JsonObject> ()) {
+            JsonObject Tag = Tags.createNestedObject ();
+            Tag[JsonTagName] = Pair.key ().c_str ();
+            Tag[JsonTagValue] = Pair.value ();
+          }
+        }
+        uint16_t Found = Element->set (Elements);
+        JsonOutDoc.clear ();
+        if (TagName != nullptr && strcmp (Group, JsonTagCmd) == 0 && Found == 0) {
+          releaseRestApiBuffer (_Request);
+          _Request->send (404, "text/plain", "Unknown Tag");
+          return;
+        }
+        // Config-Changes are saved like PATCH /api, deferred while an Element is moving
+        if (strcmp (Group, JsonTagConfig) == 0) {
+          runJob (onSaveConfigCB, JCA_IOT_WEBSERVER_JOB_SAVECONFIG);
+        }
+      }
+      releaseRestApiBuffer (_Request);
+
+      // Values of the Element, commands return the Data-Block
+      JsonObject OutData = JsonOutDoc.to<JsonObject> ();
+      if (Group == nullptr) {
+        JsonObject Values = OutData.createNestedObject (JsonTagData);
+        Element->getGroupValues (JsonTagData, Values);
+        Values = OutData.createNestedObject (JsonTagConfig);
+        Element->getGroupValues (JsonTagConfig, Values);
+      } else {
+        const char *ReadGroup = strcmp (Group, JsonTagCmd) == 0 ? JsonTagData : Group;
+        JsonObject Values = OutData.createNestedObject (ReadGroup);
+        if (!Element->getGroupValues (ReadGroup, Values)) {
+          _Request->send (404, "text/plain", "Unknown Group");
+          return;
+        }
+        if (TagName != nullptr && strcmp (Group, JsonTagCmd) != 0) {
+          JsonVariant Value = Values[(const char *)TagName];
+          if (Value.isNull ()) {
+            _Request->send (404, "text/plain", "Unknown Tag");
+            return;
+          }
+          // Reply only the Tag, the Value is copied before the Block is removed
+          OutData[JsonTagName] = (const char *)TagName;
+          OutData[JsonTagValue] = Value;
+          OutData.remove (ReadGroup);
+        }
+      }
+      JsonVariant Response = JsonOutDoc.as<JsonVariant> ();
+      bool Binary = _Request->hasHeader (JCA_IOT_WEBSERVER_HEADER_ACCEPT) && _Request->getHeader (JCA_IOT_WEBSERVER_HEADER_ACCEPT)->value ().indexOf (JCA_IOT_WEBSERVER_CONTENTTYPE_MSGPACK) >= 0;
+      sendRestApiResponse (_Request, Response, Binary, !Write);
+    }
+
+    /**
+     * @brief Answer a GET-Request with the shared Snapshot
+     * The Buffer is referenced until the Request is closed, so it survives the next Change
+     * @param _Request Request of the Client
+     * @param _Since Last Sequence the Client has received, 0 for all Values
+     * @param _Binary MessagePack instead of JSON-Text
+     * @return true Response sent
+     * @return false No Snapshot available, the Request must be answered directly
+     */
+    bool Webserver::sendSnapshot (AsyncWebServerRequest *_Request, uint32_t _Since, bool _Binary) {
+      Snapshot *Snap = getSnapshot (_Since, _Binary);
+      if (Snap == nullptr || Snap->Buffer == nullptr) {
+        return false;
+      }
+      AsyncWebSocketMessageBuffer *Buffer = Snap->Buffer;
+      (*Buffer)++;
+      _Request->onDisconnect ([this, _Request, Buffer] () {
+        this->releaseRestApiBuffer (_Request);
+        (*Buffer)--;
+      });
+      AsyncWebServerResponse *Response = _Request->beginResponse (_Binary ? JCA_IOT_WEBSERVER_CONTENTTYPE_MSGPACK : JCA_IOT_WEBSERVER_CONTENTTYPE_JSON, Buffer->length (), [Buffer] (uint8_t *_Data, size_t _MaxLen, size_t _Index) -> size_t {
+        size_t Len = Buffer->length () - _Index;
+        if (Len > _MaxLen) {
+          Len = _MaxLen;
+        }
+        memcpy (_Data, Buffer->get () + _Index, Len);
+        return Len;
+      });
+      Response->addHeader (JCA_IOT_WEBSERVER_HEADER_ETAG, "\"" + String (Snap->Seq) + "\"");
+      JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, "+ Response: Snapshot");
+      _Request->send (Response);
+      return true;
     }
 
     void Webserver::onRestApiGet (JsonVariantCallback _CB) {
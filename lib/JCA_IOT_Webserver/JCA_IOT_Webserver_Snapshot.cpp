@@ -0,0 +1,153 @@
+/**
+ * @file JCA_IOT_Webserver_Snapshot.cpp
+ * @author JCA (https://github.com/ichok)
+ * @brief Shared Update-Messages of the Webserver
+ * An Update is serialized once per Sequence and Format and shared by all WebSocket-Clients and RestAPI-Readers
+ * until the next Change. The Messages are reference counted WebSocket-Buffers, a Buffer is deleted
+ * when it is outdated and no Client is sending it anymore.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Copyright Jochen Cabrera 2022
+ * Apache License
+ *
+ */
+#include <JCA_IOT_Webserver.h>
+using namespace JCA::SYS;
+
+namespace JCA {
+  namespace IOT {
+    /**
+     * @brief Create the Values for an Update
+     *
+     * @param _Since Last Sequence the Client has received
+     * @param _Subscription Subscription of the Client as JSON-Text, nullptr or empty for all Values
+     * @param _Doc Document for the Message
+     * @param _Seq Sequence of the Message, 0 if the Callback doesn't support Change-Tracking
+     * @return true Message created
+     * @return false Nothing changed after _Since
+     */
+    bool Webserver::createUpdate (uint32_t _Since, const char *_Subscription, JsonDocument &_Doc, uint32_t &_Seq) {
+      StaticJsonDocument<JCA_IOT_WEBSERVER_WS_SUBSCRIPTION_DOCSIZE> JsonInDoc;
+      if (_Subscription != nullptr && *_Subscription != '\0') {
+        StaticJsonDocument<JCA_IOT_WEBSERVER_WS_SUBSCRIPTION_DOCSIZE> JsonSubDoc;
+        deserializeJson (JsonSubDoc, _Subscription);
+        JsonInDoc[JsonTagSubscribe] = JsonSubDoc.as<JsonObject> ();
+      }
+      JsonInDoc[JsonTagSequence] = _Since;
+      JsonVariant InData = JsonInDoc.as<JsonVariant> ();
+      _Doc.clear ();
+      JsonVariant OutData = _Doc.as<JsonVariant> ();
+
+      // Call externak datahandling Functions
+      if (wsUpdateCB) {
+        wsUpdateCB (InData, OutData);
+      } else if (restApiGetCB) {
+        restApiGetCB (InData, OutData);
+      }
+
+      _Seq = OutData[JsonTagSequence].as<uint32_t> ();
+      return _Seq == 0 || OutData[JsonTagElements].size () > 0;
+    }
+
+    /**
+     * @brief Outdate the Snapshots if something changed
+     * Outdated Buffers are deleted as soon as no Client is sending them
+     * @return uint32_t Current Sequence
+     */
+    uint32_t Webserver::updateSnapshots () {
+      uint32_t Seq = trackAllChanges ();
+      bool Changed = Seq != SnapshotSeq;
+      SnapshotSeq = Seq;
+      for (uint8_t i = 0; i < JCA_IOT_WEBSERVER_SNAPSHOTS; i++) {
+        Snapshot &Snap = Snapshots[i];
+        if (Changed && Snap.Current) {
+          Snap.Current = false;
+          if (Snap.Buffer != nullptr) {
+            Snap.Buffer->unlock ();
+          }
+        }
+        if (!Snap.Current && Snap.Buffer != nullptr && Snap.Buffer->canDelete ()) {
+          delete Snap.Buffer;
+          Snap.Buffer = nullptr;
+        }
+      }
+      return Seq;
+    }
+
+    /**
+     * @brief Get the shared Update after a Sequence
+     * The Snapshot is created on first Request, call updateSnapshots() before to outdate old Snapshots.
+     * If all Entries are in use, the least recently used current Snapshot that no Client is sending is replaced.
+     * @param _Since Last Sequence the Client has received, 0 for all Values
+     * @param _Binary MessagePack instead of JSON-Text
+     * @param _Subscription Subscription of the Client as JSON-Text, nullptr or empty for all Values
+     * @return Snapshot* Snapshot, Buffer is nullptr if nothing changed after _Since. nullptr if no Memory is free
+     */
+    Snapshot *Webserver::getSnapshot (uint32_t _Since, bool _Binary, const char *_Subscription) {
+      uint32_t ActMillis = millis ();
+      Snapshot *Free = nullptr;
+      Snapshot *Oldest = nullptr;
+      uint32_t Filter = (_Subscription != nullptr && *_Subscription != '\0') ? JCA::FNC::tagHash (_Subscription) : 0;
+      for (uint8_t i = 0; i < JCA_IOT_WEBSERVER_SNAPSHOTS; i++) {
+        Snapshot &Snap = Snapshots[i];
+        if (Snap.Current && Snap.Since == _Since && Snap.Filter == Filter && Snap.Binary == _Binary) {
+          Snap.LastUsed = ActMillis;
+          return &Snap;
+        }
+        if (Free == nullptr && !Snap.Current && Snap.Buffer == nullptr) {
+          Free = &Snap;
+        }
+        // the Buffer of a current Snapshot is only locked, no Client references it
+        bool Unused = Snap.Buffer == nullptr || Snap.Buffer->count () == 0;
+        if (Snap.Current && Unused && (Oldest == nullptr || ActMillis - Snap.LastUsed > ActMillis - Oldest->LastUsed)) {
+          Oldest = &Snap;
+        }
+      }
+      JsonPoolDoc Lease (OutDocs);
+      if (!Lease) {
+        return nullptr;
+      }
+      if (Free == nullptr && Oldest != nullptr) {
+        if (Oldest->Buffer != nullptr) {
+          Oldest->Buffer->unlock ();
+          delete Oldest->Buffer;
+          Oldest->Buffer = nullptr;
+        }
+        Oldest->Current = false;
+        Free = Oldest;
+      }
+      if (Free == nullptr) {
+        JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "+ no free Snapshot");
+        return nullptr;
+      }
+
+      Free->Since = _Since;
+      Free->Filter = Filter;
+      Free->Binary = _Binary;
+      Free->LastUsed = ActMillis;
+      if (createUpdate (_Since, _Subscription, *Lease, Free->Seq)) {
+        size_t Length = _Binary ? measureMsgPack (*Lease) : measureJson (*Lease);
+        AsyncWebSocketMessageBuffer *Buffer = new AsyncWebSocketMessageBuffer (Length);
+        if (Buffer->get () == nullptr) {
+          delete Buffer;
+          JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "+ no Memory for Snapshot");
+          return nullptr;
+        }
+        if (_Binary) {
+          serializeMsgPack (*Lease, Buffer->get (), Length);
+        } else {
+          // Buffer has one more Byte for the Terminator
+          serializeJson (*Lease, (char *)Buffer->get (), Length + 1);
+        }
+        // Locked as long as the Snapshot is current
+        Buffer->lock ();
+        Free->Buffer = Buffer;
+        JCA_DEBUG_PRINT (FLAG_LOOP, true, ObjectName, __func__, "+ Snapshot created, Length: ");
+        JCA_DEBUG_PRINTLN (FLAG_LOOP, true, ObjectName, __func__, Length);
+      }
+      Free->Current = true;
+      return Free;
+    }
+  }
+}
@@ -22,107 +22,525 @@ namespace JCA {
     }
     void Webserver::setWsUpdateCycle (uint32_t _CycleTime) {
       WsUpdateCycle = _CycleTime;
+      configChanged ();
     }
     bool Webserver::doWsUpdate () {
-      return doWsUpdate (nullptr);
+      return doWsUpdate (nullptr, true);
+    }
+
+    /**
+     * @brief Search the Change-State of a WebSocket-Client
+     *
+     * @param _Id Id of the WebSocket-Client
+     * @param _Create Use a free Entry if the Client is unknown
+     * @return WsClientState* State of the Client, nullptr if not found or no Entry is free
+     */
+    WsClientState *Webserver::getWsClient (uint32_t _Id, bool _Create) {
+      WsClientState *Free = nullptr;
+      for (uint8_t i = 0; i < JCA_IOT_WEBSERVER_WS_MAXCLIENTS; i++) {
+        if (WsClients[i].Id == _Id) {
+          return &WsClients[i];
+        }
+        if (Free == nullptr && WsClients[i].Id == 0) {
+          Free = &WsClients[i];
+        }
+      }
+      if (!_Create || Free == nullptr) {
+        return nullptr;
+      }
+      Free->Id = _Id;
+      Free->Seq = 0;
+      Free->Binary = false;
+      Free->Buffer = nullptr;
+      Free->Interval = 0;
+      Free->LastUpdate = millis ();
+      Free->LastSent = Free->LastUpdate;
+      Free->Subscription[0] = '\0';
+      Free->Queued = 0;
+      Free->UpdatePending = false;
+      Free->Dropped = 0;
+      Free->Coalesced = 0;
+      Free->LastSeen = Free->LastUpdate;
+      Free->PingSent = Free->LastUpdate;
+      Free->PingPending = false;
+      Free->Rtt = 0;
+      return Free;
+    }
+
+    /**
+     * @brief Free the Entry of a disconnected Client
+     * Waiting Messages and the Message-Buffer are released
+     * @param _State State of the Client
+     */
+    void Webserver::releaseWsClient (WsClientState *_State) {
+      for (uint8_t i = 0; i < _State->Queued; i++) {
+        delete _State->Queue[i].Buffer;
+      }
+      _State->Queued = 0;
+      MsgBuffers.give (_State->Buffer);
+      _State->Buffer = nullptr;
+      _State->Id = 0;
     }
 
     void Webserver::onWsEvent (AsyncWebSocket *_Server, AsyncWebSocketClient *_Client, AwsEventType _Type, void *_Arg, uint8_t *_Data, size_t _Len) {
-      Debug.println (FLAG_TRAFFIC, true, ObjectName, __func__, "Start");
+      JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, "Start");
       if (_Type == WS_EVT_CONNECT) {
-        doWsUpdate (_Client);
+        // New Clients start with all Values, MessagePack if requested as Subprotocol
+        WsClientState *State = getWsClient (_Client->id (), true);
+        if (State == nullptr) {
+          WsRejected++;
+          JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "+ too many Clients, rejected");
+          _Client->close (JCA_IOT_WEBSERVER_WS_CLOSE_TRYAGAIN, "Too many Clients");
+          return;
+        }
+        AsyncWebServerRequest *Request = (AsyncWebServerRequest *)_Arg;
+        if (Request != nullptr && Request->hasHeader (JCA_IOT_WEBSERVER_HEADER_WSPROTOCOL)) {
+          State->Binary = Request->getHeader (JCA_IOT_WEBSERVER_HEADER_WSPROTOCOL)->value ().indexOf (JCA_IOT_WEBSERVER_WS_PROTOCOL_MSGPACK) >= 0;
+        }
+        doWsUpdate (_Client, true);
+      }
+      else if (_Type == WS_EVT_DISCONNECT) {
+        WsClientState *State = getWsClient (_Client->id (), false);
+        if (State != nullptr) {
+          releaseWsClient (State);
+        }
+      }
+      else if (_Type == WS_EVT_PONG) {
+        // A Pong is a Sign of Life, Dashboards only send on User-Actions
+        WsClientState *State = getWsClient (_Client->id (), false);
+        if (State != nullptr) {
+          State->LastSeen = millis ();
+          if (State->PingPending) {
+            State->Rtt = State->LastSeen - State->PingSent;
+            State->PingPending = false;
+          }
+        }
       }
       else if (_Type == WS_EVT_DATA) {
         wsHandleData (_Client, _Arg, _Data, _Len);
       }
     }
 
-    void Webserver::wsHandleData (AsyncWebSocketClient *_Client, void *_Arg, uint8_t *_Data, size_t _Len) {
-      AwsFrameInfo *Info = (AwsFrameInfo *)_Arg;
-      if (Info->opcode == WS_TEXT) {
-        // Initialise Message-Buffer on first Frame
-        if (Info->index == 0) {
-          _Client->_tempObject = malloc (Info->len + 10);
-          Debug.print (FLAG_TRAFFIC, true, ObjectName, __func__, "+ MsgLen: ");
-          Debug.println (FLAG_TRAFFIC, true, ObjectName, __func__, Info->len);
-        }
-        // Append Data to Message-Buffer
-        memcpy ((uint8_t *)(_Client->_tempObject) + Info->index, _Data, _Len);
-        // Handle Message if last Frame ist received
-        if (Info->final && Info->index + _Len == Info->len) {
-          ((uint8_t *)(_Client->_tempObject))[Info->len] = 0;
-          DynamicJsonDocument JsonInDoc (1000);
-          DynamicJsonDocument JsonOutDoc (10000);
-          JsonVariant InData;
-          JsonVariant OutData = JsonOutDoc.as<JsonVariant> ();
-
-          Debug.print (FLAG_TRAFFIC, true, ObjectName, __func__, "+ Buffer: ");
-          Debug.println (FLAG_TRAFFIC, true, ObjectName, __func__, (char *)(_Client->_tempObject));
-
-          DeserializationError Error = deserializeJson (JsonInDoc, (char *)(_Client->_tempObject));
-          if (Error) {
-            if (Debug.print (FLAG_ERROR, true, ObjectName, __func__, "+ deserializeJson() failed: ")) {
-              Debug.println (FLAG_ERROR, true, ObjectName, __func__, Error.c_str ());
-              Debug.print (FLAG_ERROR, true, ObjectName, __func__, "+ Body:");
-              Debug.println (FLAG_ERROR, true, ObjectName, __func__, (char *)(_Client->_tempObject));
-            }
-            JsonInDoc.clear ();
+    /**
+     * @brief Connection-Manager of the WebSocket-Clients
+     * Pings the Clients and measures the Round-Trip-Time, closes Clients without Pong or without Message and Pong
+     * for WsIdleTimeout and frees the Memory of closed Clients.
+     */
+    void Webserver::manageWsClients () {
+      uint32_t ActMillis = millis ();
+      for (uint8_t i = 0; i < JCA_IOT_WEBSERVER_WS_MAXCLIENTS; i++) {
+        WsClientState &State = WsClients[i];
+        if (State.Id == 0) {
+          continue;
+        }
+        AsyncWebSocketClient *Client = Websocket.client (State.Id);
+        if (Client == nullptr) {
+          releaseWsClient (&State);
+          continue;
+        }
+        bool Unresponsive = State.PingPending && ActMillis - State.PingSent >= JCA_IOT_WEBSERVER_WS_PINGTIMEOUT;
+        bool Idle = WsIdleTimeout > 0 && ActMillis - State.LastSeen >= WsIdleTimeout * 1000;
+        if (Unresponsive || Idle) {
+          if (JCA_DEBUG_PRINT (FLAG_TRAFFIC, true, ObjectName, __func__, Unresponsive ? "+ unresponsive, closed: " : "+ idle, closed: ")) {
+            JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, State.Id);
           }
+          WsEvicted++;
+          Client->close ();
+          releaseWsClient (&State);
+          continue;
+        }
+        if (!State.PingPending && ActMillis - State.PingSent >= JCA_IOT_WEBSERVER_WS_PINGINTERVAL) {
+          Client->ping ();
+          State.PingSent = ActMillis;
+          State.PingPending = true;
+        }
+      }
+      // remove closed Clients from the Server, Clients above the Limit are closed (oldest first)
+      Websocket.cleanupClients (JCA_IOT_WEBSERVER_WS_MAXCLIENTS);
+      releaseWsBuffers ();
+    }
 
-          InData = JsonInDoc.as<JsonVariant> ();
+    /**
+     * @brief Delete the Buffers of sent Messages that the Clients are done with
+     * The Client only references the Buffer, like the Buffer of a Snapshot
+     * @return true a Buffer can be added
+     * @return false all Entries are still in use
+     */
+    bool Webserver::releaseWsBuffers () {
+      uint8_t Kept = 0;
+      for (uint8_t i = 0; i < WsSentCount; i++) {
+        if (WsSent[i]->canDelete ()) {
+          delete WsSent[i];
+        } else {
+          WsSent[Kept++] = WsSent[i];
+        }
+      }
+      WsSentCount = Kept;
+      return WsSentCount < JCA_IOT_WEBSERVER_WS_SENTBUFFERS;
+    }
 
-          // Call externak datahandling Functions
-          if (wsDataCB) {
-            wsDataCB (InData, OutData);
-          } else if (restApiPostCB) {
-            restApiPostCB (InData, OutData);
-          }
+    /**
+     * @brief Send a Message in the Format of the Client
+     * The Message is serialized once into a WebSocket-Buffer, that is passed to the Client without Copy.
+     * If the Client is busy, the Message waits in the Queue of the Client and is sent before the next Update.
+     * If the Queue is full, a waiting Update is merged into the next Update to make Room for a Command-Reply.
+     * Only if no Update is waiting, all Messages are dropped and the Client gets the Changes with the next Update.
+     * @param _Client Client to send to
+     * @param _State State of the Client
+     * @param _Data Message
+     * @param _Since Sequence of the Client before the Message
+     * @param _Update Message is an Update (like the Heartbeat) and no Command-Reply
+     */
+    void Webserver::wsSend (AsyncWebSocketClient *_Client, WsClientState *_State, JsonVariant &_Data, uint32_t _Since, bool _Update) {
+      if (_Update && _State->Queued >= JCA_IOT_WEBSERVER_WS_QUEUESIZE) {
+        // the next Update is sent as soon as the Client is free
+        _State->UpdatePending = true;
+        _State->Coalesced++;
+        WsCoalesced++;
+        return;
+      }
+      size_t Length = _State->Binary ? measureMsgPack (_Data) : measureJson (_Data);
+      AsyncWebSocketMessageBuffer *Message = new AsyncWebSocketMessageBuffer (Length);
+      if (Message->get () == nullptr) {
+        delete Message;
+        JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "+ no Memory for Message");
+        return;
+      }
+      if (_State->Binary) {
+        serializeMsgPack (_Data, Message->get (), Length);
+      } else {
+        // Buffer has one more Byte for the Terminator
+        serializeJson (_Data, (char *)Message->get (), Length + 1);
+        JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, (char *)Message->get ());
+      }
 
-          // Create Response
-          String Response;
-          serializeJson (OutData, Response);
-          Debug.println (FLAG_TRAFFIC, true, ObjectName, __func__, Response);
-          if (_Client->canSend ()) {
-            _Client->text (Response);
+      if (_State->Queued >= JCA_IOT_WEBSERVER_WS_QUEUESIZE) {
+        // Queue full, a waiting Update is merged into the next Update
+        for (uint8_t i = 0; i < _State->Queued; i++) {
+          if (_State->Queue[i].Update) {
+            if ((int32_t)(_State->Queue[i].Since - _State->Seq) < 0) {
+              _State->Seq = _State->Queue[i].Since;
+            }
+            delete _State->Queue[i].Buffer;
+            _State->Queued--;
+            memmove (_State->Queue + i, _State->Queue + i + 1, (_State->Queued - i) * sizeof (WsQueuedMessage));
+            _State->UpdatePending = true;
+            _State->Coalesced++;
+            WsCoalesced++;
+            break;
           }
         }
       }
+      if (_State->Queued < JCA_IOT_WEBSERVER_WS_QUEUESIZE) {
+        WsQueuedMessage &Entry = _State->Queue[_State->Queued++];
+        Entry.Buffer = Message;
+        Entry.Since = _Since;
+        Entry.Update = _Update;
+        wsFlush (_Client, _State);
+        return;
+      }
+
+      // Queue full of Command-Replies, the next Update contains all Changes after the oldest dropped Message
+      _State->Seq = _State->Queue[0].Since;
+      _State->UpdatePending = true;
+      for (uint8_t i = 0; i < _State->Queued; i++) {
+        delete _State->Queue[i].Buffer;
+      }
+      delete Message;
+      _State->Dropped += _State->Queued + 1;
+      WsDropped += _State->Queued + 1;
+      _State->Queued = 0;
+      JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "+ Queue full, Messages dropped");
     }
 
-    bool Webserver::doWsUpdate (AsyncWebSocketClient *_Client) {
-      DynamicJsonDocument JsonDoc(10000);
-      JsonVariant InData;
-      JsonVariant OutData = JsonDoc.as<JsonVariant> ();
+    /**
+     * @brief Send the waiting Messages as long as the Client can send
+     * The Buffers are kept until the Client is done with them, and deleted by releaseWsBuffers()
+     * @param _Client Client to send to
+     * @param _State State of the Client
+     * @return true Queue is empty
+     * @return false Client is busy, Messages are waiting
+     */
+    bool Webserver::wsFlush (AsyncWebSocketClient *_Client, WsClientState *_State) {
+      uint8_t Sent = 0;
+      while (Sent < _State->Queued && _Client->canSend ()) {
+        if (WsSentCount >= JCA_IOT_WEBSERVER_WS_SENTBUFFERS && !releaseWsBuffers ()) {
+          break;
+        }
+        WsQueuedMessage &Entry = _State->Queue[Sent++];
+        if (_State->Binary) {
+          _Client->binary (Entry.Buffer);
+        } else {
+          _Client->text (Entry.Buffer);
+        }
+        WsSent[WsSentCount++] = Entry.Buffer;
+        _State->LastSent = millis ();
+      }
+      if (Sent > 0) {
+        _State->Queued -= Sent;
+        memmove (_State->Queue, _State->Queue + Sent, _State->Queued * sizeof (WsQueuedMessage));
+      }
+      return _State->Queued == 0;
+    }
 
-      if (_Client != nullptr) {
-        // check if selected Client can send Data
-        if (!_Client->canSend ()) {
-          return false;
+    /**
+     * @brief Collect the Frames of a Message and pass it to the Callback
+     * The Message is collected in a Buffer from the Pool, that is given back after the Message is handled.
+     * Messages longer than JCA_IOT_WEBSERVER_MSG_MAXSIZE are rejected.
+     * Text-Messages are JSON, Binary-Messages are MessagePack and switch the Client to MessagePack
+     * @param _Client Sending Client
+     * @param _Arg Frame-Information
+     * @param _Data Data of the Frame
+     * @param _Len Length of the Data
+     */
+    void Webserver::wsHandleData (AsyncWebSocketClient *_Client, void *_Arg, uint8_t *_Data, size_t _Len) {
+      AwsFrameInfo *Info = (AwsFrameInfo *)_Arg;
+      bool Binary = Info->opcode == WS_BINARY;
+      if (Info->opcode != WS_TEXT && !Binary) {
+        return;
+      }
+      WsClientState *State = getWsClient (_Client->id (), true);
+      if (State == nullptr) {
+        return;
+      }
+      State->LastSeen = millis ();
+      // Take the Message-Buffer on first Frame
+      if (Info->index == 0) {
+        JCA_DEBUG_PRINT (FLAG_TRAFFIC, true, ObjectName, __func__, "+ MsgLen: ");
+        JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, Info->len);
+        if (!admit ((uint32_t)_Client->remoteIP (), ROUTE_WS, true)) {
+          RouteLimited[ROUTE_WS]++;
+          JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, "+ Client limited, dropped");
+          MsgBuffers.give (State->Buffer);
+          State->Buffer = nullptr;
+          return;
+        }
+        if (Info->len >= MsgBuffers.size ()) {
+          MsgOversize++;
+          JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "+ Message too long, dropped");
+          MsgBuffers.give (State->Buffer);
+          State->Buffer = nullptr;
+          return;
         }
+        if (State->Buffer == nullptr) {
+          State->Buffer = MsgBuffers.take ();
+        }
+        if (State->Buffer == nullptr) {
+          JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "+ no free Message-Buffer, dropped");
+          return;
+        }
+      }
+      // Frames of a dropped Message
+      if (State->Buffer == nullptr || Info->index + _Len > Info->len) {
+        return;
+      }
+      // Append Data to Message-Buffer
+      memcpy (State->Buffer + Info->index, _Data, _Len);
+      // Handle Message if last Frame ist received
+      if (Info->final && Info->index + _Len == Info->len) {
+        State->Buffer[Info->len] = 0;
+        if (Binary) {
+          State->Binary = true;
+        }
+        uint32_t Start = micros ();
+        wsHandleMessage (_Client, State, Binary, Info->len);
+        RouteLatency[ROUTE_WS].add (micros () - Start);
+        MsgBuffers.give (State->Buffer);
+        State->Buffer = nullptr;
+      }
+    }
+
+    /**
+     * @brief Pass a complete Message to the Callback and send the Response
+     *
+     * @param _Client Sending Client
+     * @param _State State of the Client, contains the Message
+     * @param _Binary true for MessagePack, false for JSON-Text
+     * @param _Len Length of the Message
+     */
+    void Webserver::wsHandleMessage (AsyncWebSocketClient *_Client, WsClientState *_State, bool _Binary, size_t _Len) {
+      JsonPoolDoc InLease (InDocs);
+      JsonPoolDoc OutLease (OutDocs);
+      if (!InLease || !OutLease) {
+        JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "+ no free JSON-Document, Message dropped");
+        return;
+      }
+      JsonDocument &JsonInDoc = *InLease;
+      JsonDocument &JsonOutDoc = *OutLease;
+      JsonVariant InData;
+      JsonVariant OutData = JsonOutDoc.as<JsonVariant> ();
+
+      DeserializationError Error;
+      if (_Binary) {
+        Error = deserializeMsgPack (JsonInDoc, (const char *)(_State->Buffer), _Len);
       } else {
-        // check if selected Client can send Data
-        if (Websocket.count() == 0){
-          return false;
+        JCA_DEBUG_PRINT (FLAG_TRAFFIC, true, ObjectName, __func__, "+ Buffer: ");
+        JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, (char *)(_State->Buffer));
+        Error = deserializeJson (JsonInDoc, (char *)(_State->Buffer));
+      }
+      if (Error) {
+        if (JCA_DEBUG_PRINT (FLAG_ERROR, true, ObjectName, __func__, _Binary ? "+ deserializeMsgPack() failed: " : "+ deserializeJson() failed: ")) {
+          JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, Error.c_str ());
+          if (!_Binary) {
+            JCA_DEBUG_PRINT (FLAG_ERROR, true, ObjectName, __func__, "+ Body:");
+            JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, (char *)(_State->Buffer));
+          }
         }
+        JsonInDoc.clear ();
       }
 
+      // A new Subscription starts with all subscribed Values, otherwise the stored Subscription filters the Reply
+      JsonObject Subscription = JsonInDoc[JsonTagSubscribe].as<JsonObject> ();
+      if (!Subscription.isNull ()) {
+        if (wsSubscribe (_State, Subscription)) {
+          _State->Seq = 0;
+        }
+      } else if (_State->Subscription[0] != '\0') {
+        StaticJsonDocument<JCA_IOT_WEBSERVER_WS_SUBSCRIPTION_DOCSIZE> JsonSubDoc;
+        deserializeJson (JsonSubDoc, _State->Subscription);
+        JsonInDoc[JsonTagSubscribe] = JsonSubDoc.as<JsonObject> ();
+      }
+      // Reply with the Changes after the last Update, the Client can send its own Sequence ("seq": 0 for all Values)
+      if (!JsonInDoc.containsKey (JsonTagSequence)) {
+        JsonInDoc[JsonTagSequence] = _State->Seq;
+      }
+      InData = JsonInDoc.as<JsonVariant> ();
+      uint32_t Since = InData[JsonTagSequence].as<uint32_t> ();
+
       // Call externak datahandling Functions
-      if (wsUpdateCB) {
-        wsUpdateCB (InData, OutData);
-      } else if (restApiGetCB) {
-        restApiGetCB (InData, OutData);
-      }
-
-      // Create Response
-      String Response;
-      serializeJson (OutData, Response);
-      Debug.println (FLAG_LOOP, true, ObjectName, __func__, Response);
-      if (_Client != nullptr) {
-        _Client->text (Response);
+      if (wsDataCB) {
+        wsDataCB (InData, OutData);
+      } else if (restApiPostCB) {
+        restApiPostCB (InData, OutData);
+      }
+      _State->Seq = OutData[JsonTagSequence].as<uint32_t> ();
+      _State->LastUpdate = millis ();
+
+      // Create Response, Replies are queued with Priority over Updates
+      wsSend (_Client, _State, OutData, Since);
+    }
+
+    /**
+     * @brief Store the Subscription of a Client
+     * The Subscription is passed to the Callbacks, only the Rate-Class is used by the Webserver
+     * ("fast", "normal", "slow" or Interval in ms)
+     * @param _State State of the Client
+     * @param _Subscription Subscription from the Message, empty Object subscribes all Values
+     * @return true Subscription stored
+     * @return false Subscription too long, the Client keeps the old one
+     */
+    bool Webserver::wsSubscribe (WsClientState *_State, JsonObject _Subscription) {
+      if (measureJson (_Subscription) >= JCA_IOT_WEBSERVER_WS_SUBSCRIPTION_MAXSIZE) {
+        JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "+ Subscription too long");
+        return false;
+      }
+      JsonVariant Rate = _Subscription[JCA_IOT_WEBSERVER_WS_KEY_RATE];
+      if (Rate.is<uint32_t> ()) {
+        _State->Interval = max (Rate.as<uint32_t> (), (uint32_t)JCA_IOT_WEBSERVER_WS_RATE_FAST);
+      } else if (Rate == "fast") {
+        _State->Interval = JCA_IOT_WEBSERVER_WS_RATE_FAST;
+      } else if (Rate == "slow") {
+        _State->Interval = JCA_IOT_WEBSERVER_WS_RATE_SLOW;
       } else {
-        Websocket.textAll (Response);
+        _State->Interval = 0;
       }
+      if (_Subscription.size () == 0) {
+        _State->Subscription[0] = '\0';
+      } else {
+        serializeJson (_Subscription, _State->Subscription, JCA_IOT_WEBSERVER_WS_SUBSCRIPTION_MAXSIZE);
+      }
+      JCA_DEBUG_PRINT (FLAG_TRAFFIC, true, ObjectName, __func__, "+ Subscription: ");
+      JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, _State->Subscription);
       return true;
     }
+
+    /**
+     * @brief Send the Changes to the Clients
+     * Every Client gets the Changes after its last Update as shared Snapshot,
+     * so Clients with the same Sequence, Subscription and Format share one serialized Message.
+     * @param _Client Client to update, nullptr for all Clients
+     * @param _Force Ignore the Interval of the Rate-Class
+     * @param _Signaled Changes are signaled, only Clients with an Interval up to the fast Rate-Class are due at once
+     * @return true Message sent to at least one Client
+     * @return false Nothing sent
+     */
+    bool Webserver::doWsUpdate (AsyncWebSocketClient *_Client, bool _Force, bool _Signaled) {
+      uint32_t ActMillis = millis ();
+      bool Sent = false;
+      bool Tracked = false;
+      if (Websocket.count () == 0) {
+        return false;
+      }
+
+      for (uint8_t i = 0; i < JCA_IOT_WEBSERVER_WS_MAXCLIENTS; i++) {
+        WsClientState &State = WsClients[i];
+        if (State.Id == 0 || (_Client != nullptr && _Client->id () != State.Id)) {
+          continue;
+        }
+        AsyncWebSocketClient *Client = Websocket.client (State.Id);
+        if (Client == nullptr) {
+          releaseWsClient (&State);
+          continue;
+        }
+        // check if the Rate-Class or the Heartbeat of the Client is due, a merged Update is sent as soon as possible
+        uint32_t Interval = State.Interval > 0 ? State.Interval : WsUpdateCycle;
+        bool IntervalDue = _Force || (_Signaled && Interval <= JCA_IOT_WEBSERVER_WS_RATE_FAST) || (Interval > 0 && ActMillis - State.LastUpdate >= Interval);
+        bool UpdateDue = IntervalDue || State.UpdatePending;
+        bool HeartbeatDue = WsHeartbeat > 0 && ActMillis - State.LastSent >= WsHeartbeat;
+        if (!UpdateDue && !HeartbeatDue && State.Queued == 0) {
+          continue;
+        }
+        // waiting Command-Replies first, the Update is merged into the next one while the Client is busy
+        if (!wsFlush (Client, &State) || !Client->canSend ()) {
+          if (IntervalDue) {
+            if (State.UpdatePending) {
+              State.Coalesced++;
+              WsCoalesced++;
+            }
+            State.UpdatePending = true;
+            State.LastUpdate = ActMillis;
+          }
+          continue;
+        }
+        if (!UpdateDue && !HeartbeatDue) {
+          continue;
+        }
+        // Changes are only tracked if at least one Client is due
+        if (!Tracked) {
+          updateSnapshots ();
+          Tracked = true;
+        }
+        State.LastUpdate = ActMillis;
+        Snapshot *Snap = getSnapshot (State.Seq, State.Binary, State.Subscription);
+        if (Snap == nullptr) {
+          // no Snapshot available, the Update is retried with the next Call
+          State.UpdatePending = true;
+          continue;
+        }
+        if (Snap->Buffer == nullptr) {
+          if (HeartbeatDue) {
+            // Update without Changes, the Client knows the Connection is alive and gets the untracked System-Time
+            StaticJsonDocument<128> JsonHeartbeat;
+            JsonHeartbeat[JsonTagSequence] = State.Seq;
+            JsonObject HeartbeatData = JsonHeartbeat.createNestedObject (JsonTagElements).createNestedObject (ElementName).createNestedObject (JsonTagData);
+            HeartbeatData[Time_Name] = getTime ();
+            JsonVariant Heartbeat = JsonHeartbeat.as<JsonVariant> ();
+            wsSend (Client, &State, Heartbeat, State.Seq, true);
+          }
+          State.UpdatePending = false;
+          continue;
+        }
+        if (State.Binary) {
+          Client->binary (Snap->Buffer);
+        } else {
+          Client->text (Snap->Buffer);
+        }
+        State.Seq = Snap->Seq;
+        State.LastSent = ActMillis;
+        State.UpdatePending = false;
+        Sent = true;
+      }
+      return Sent;
+    }
   }
 }
@@ -16,25 +16,44 @@ using namespace JCA::FNC;
 namespace JCA {
   namespace IOT {
     const char *Webserver::ElementName = "System";
-    const char *Webserver::Hostname_Name = "hostname";
-    const char *Webserver::Hostname_Text = "Hostname";
-    const char *Webserver::Hostname_Comment = "Hostname wirde erst nache dem Reboot aktiv";
-    const char *Webserver::WsUpdateCycle_Name = "wsUpdate";
-    const char *Webserver::WsUpdateCycle_Text  = "Websocket Updatezyklus";
-    const char *Webserver::WsUpdateCycle_Unit = "ms";
-    const char *Webserver::WsUpdateCycle_Comment = nullptr;
-    const char *Webserver::TimeSync_Name = "timeSync";
-    const char *Webserver::TimeSync_Text = "Uhrzeit syncronisieren";
-    const char *Webserver::TimeSync_Type = "uint32";
-    const char *Webserver::TimeSync_Comment = nullptr;
-    const char *Webserver::SaveConfig_Name = "saveConfig";
-    const char *Webserver::SaveConfig_Text = "Konfiguration speichern";
-    const char *Webserver::SaveConfig_Type = "bool";
-    const char *Webserver::SaveConfig_Comment = "Save the current Config to ConfigFile";
-    const char *Webserver::SaveConfig_BtnText = "SAVE";
     const char *Webserver::Time_Name = "time";
     const char *Webserver::Time_Text = "Systemzeit";
-    const char *Webserver::Time_Comment = nullptr;
+    const char *Webserver::Rtt_Name = "wsRtt";
+    const char *Webserver::Rtt_Text = "Websocket Antwortzeit (max.)";
+    const char *Webserver::Rtt_Comment = "Ping-Pong aller Clients";
+    const char *Webserver::Clients_Name = "wsClients";
+    const char *Webserver::Clients_Text = "Websocket Clients";
+    const char *Webserver::Clients_Comment = "IP: Warteschlange / verworfen / zusammengefasst, Antwortzeit";
+    const TagDescriptor<Webserver> Webserver::Tags[] = {
+      {TagGroup::Config, "hostname", "Hostname", "Hostname wirde erst nache dem Reboot aktiv", false, &Webserver::Hostname},
+      {TagGroup::Config, "wsUpdate", "Websocket Updatezyklus", nullptr, false, "ms", &Webserver::WsUpdateCycle},
+      {TagGroup::Config, "wsMinInterval", "Websocket min. Sendeabstand", "Änderungen werden sofort, aber höchstens in diesem Abstand gesendet", false, "ms", &Webserver::WsMinInterval},
+      {TagGroup::Config, "wsHeartbeat", "Websocket Heartbeat", "Nachricht an Clients ohne Änderungen, 0 = aus", false, "ms", &Webserver::WsHeartbeat},
+      {TagGroup::Config, "wsIdleTimeout", "Websocket Leerlaufzeit", "Clients ohne Nachricht und Pong werden getrennt, 0 = aus", false, "s", &Webserver::WsIdleTimeout},
+      {TagGroup::Config, "admitApiRate", "RestAPI Anfragen pro Client", "Token-Bucket je Client-IP, 0 = unbegrenzt", false, "1/s", &Webserver::AdmitApiRate},
+      {TagGroup::Config, "admitWsRate", "Websocket Nachrichten pro Client", "Token-Bucket je Client-IP, 0 = unbegrenzt", false, "1/s", &Webserver::AdmitWsRate},
+      {TagGroup::Config, "admitBurst", "Anfragen am Stück", "Größe des Token-Buckets", false, nullptr, &Webserver::AdmitBurst},
+      {TagGroup::Config, "admitMotionDivider", "Teiler bei Bewegung", "Rate wird geteilt und Anfragen am Stück auf 1 begrenzt, solange sich ein Antrieb bewegt, 0 = aus", false, nullptr, &Webserver::AdmitMotionDivider},
+      {TagGroup::Data, "docsMaxUsed", "JSON-Dokumente max. belegt", "Gleichzeitig belegte Antwort-Dokumente", true, nullptr, &Webserver::DocsMaxUsed},
+      {TagGroup::Data, "docsMaxMemory", "JSON-Dokument max. Speicher", nullptr, true, "Byte", &Webserver::DocsMaxMemory},
+      {TagGroup::Data, "docsBusy", "Abgewiesene Anfragen", "Kein JSON-Dokument frei", true, nullptr, &Webserver::DocsBusy},
+      {TagGroup::Data, "msgOversize", "Abgewiesene Nachrichten (zu lang)", "Nachricht länger als der Empfangspuffer", true, nullptr, &Webserver::MsgOversize},
+      {TagGroup::Data, "msgBusy", "Abgewiesene Nachrichten (belegt)", "Kein Empfangspuffer frei", true, nullptr, &Webserver::MsgBusy},
+      {TagGroup::Data, "wsQueued", "Websocket Warteschlange", "Wartende Antworten und Updates aller Clients", true, nullptr, &Webserver::WsQueued},
+      {TagGroup::Data, "wsDropped", "Websocket verworfene Antworten", "Warteschlange eines Clients voll", true, nullptr, &Webserver::WsDropped},
+      {TagGroup::Data, "wsCoalesced", "Websocket zusammengefasste Updates", "Client war beim Update belegt", true, nullptr, &Webserver::WsCoalesced},
+      {TagGroup::Data, "wsConnected", "Websocket verbundene Clients", nullptr, true, nullptr, &Webserver::WsConnected},
+      {TagGroup::Data, "wsRejected", "Websocket abgewiesene Clients", "Maximale Anzahl Clients erreicht", true, nullptr, &Webserver::WsRejected},
+      {TagGroup::Data, "wsEvicted", "Websocket getrennte Clients", "Keine Antwort oder Leerlaufzeit abgelaufen", true, nullptr, &Webserver::WsEvicted},
+      {TagGroup::Data, "admitLimited", "Begrenzte Anfragen", "Mit 429 beantwortet oder verworfen", true, nullptr, &Webserver::AdmitLimited},
+      {TagGroup::Data, "motion", "Bewegung aktiv", "Updates und Aufgaben warten bis die Bewegung beendet ist, höchstens 2 s am Stück", true, nullptr, nullptr, &Webserver::MotionActive},
+      {TagGroup::Data, "jobBacklog", "Wartende Aufgaben", "Während der Bewegung zurückgestellt", true, nullptr, &Webserver::JobCount},
+      {TagGroup::Data, "updatesDeferred", "Zurückgestellte Updates", "Update-Zyklen während einer Bewegung", true, nullptr, &Webserver::UpdatesDeferred},
+      {TagGroup::Data, "debugHeld", "Wartende Debug-Ausgabe", "Noch nicht gesendete Meldungen im Ringpuffer", true, "Byte", &Webserver::DebugHeld},
+      {TagGroup::Data, "debugDropped", "Verworfene Debug-Meldungen", "Ringpuffer voll", true, nullptr, &Webserver::DebugDropped},
+      {TagGroup::Data, "eventsConnected", "Event-Stream Clients", "Server-Sent Events", true, nullptr, &Webserver::EventsConnected},
+      {TagGroup::Cmd, "timeSync", "Uhrzeit syncronisieren", nullptr, "uint32", nullptr, &Webserver::doTimeSync},
+      {TagGroup::Cmd, "saveConfig", "Konfiguration speichern", "Save the current Config to ConfigFile", "bool", "SAVE", &Webserver::doSaveConfig}};
 
     /**
      * @brief Construct a new Webserver::Webserver object
@@ -46,14 +65,65 @@ namespace JCA {
      * @param _Offset RTC Timeoffset in seconds
      */
     Webserver::Webserver (const char *_HostnamePrefix, uint16_t _Port, const char *_ConfUser, const char *_ConfPassword, unsigned long _Offset)
-        : Protocol (ElementName), Server (_Port), Websocket ("/ws"), Rtc (_Offset) {
-      sprintf (Hostname, "%s_%08X", _HostnamePrefix, ESP.getChipId ());
+        : Protocol (ElementName), Server (_Port), Websocket ("/ws"), Rtc (_Offset),
+          InDocs (JCA_IOT_WEBSERVER_DOCPOOL_IN_COUNT, JCA_IOT_WEBSERVER_DOCPOOL_IN_CAPACITY),
+          OutDocs (JCA_IOT_WEBSERVER_DOCPOOL_OUT_COUNT, JCA_IOT_WEBSERVER_DOCPOOL_OUT_CAPACITY),
+          MsgBuffers (JCA_IOT_WEBSERVER_MSGPOOL_COUNT, JCA_IOT_WEBSERVER_MSG_MAXSIZE + 1),
+          Events (JCA_IOT_WEBSERVER_PATH_EVENTS) {
+      char DefaultHostname[80];
+      snprintf (DefaultHostname, sizeof (DefaultHostname), "%s_%08X", _HostnamePrefix, ESP.getChipId ());
+      Hostname = DefaultHostname;
       Port = _Port;
       Reboot = false;
       strncpy (ConfUser, _ConfUser, sizeof (ConfUser));
       strncpy (ConfPassword, _ConfPassword, sizeof (ConfPassword));
       WsUpdateCycle = 1000;
       WsLastUpdate = millis ();
+      WsMinInterval = JCA_IOT_WEBSERVER_WS_MININTERVAL;
+      WsHeartbeat = JCA_IOT_WEBSERVER_WS_HEARTBEAT;
+      WsLastPush = WsLastUpdate;
+      memset (WsClients, 0, sizeof (WsClients));
+      memset (Snapshots, 0, sizeof (Snapshots));
+      memset (Buckets, 0, sizeof (Buckets));
+      memset (RouteLimited, 0, sizeof (RouteLimited));
+      AdmitApiRate = JCA_IOT_WEBSERVER_ADMISSION_API_RATE;
+      AdmitWsRate = JCA_IOT_WEBSERVER_ADMISSION_WS_RATE;
+      AdmitBurst = JCA_IOT_WEBSERVER_ADMISSION_BURST;
+      AdmitMotionDivider = JCA_IOT_WEBSERVER_ADMISSION_MOTIONDIVIDER;
+      AdmitLimited = 0;
+      JobCount = 0;
+      MotionActive = false;
+      MotionLastRun = 0;
+      UpdatesDeferred = 0;
+      DebugHeld = 0;
+      DebugDropped = 0;
+      for (uint8_t i = 0; i < ROUTE_COUNT; i++) {
+        RouteLatency[i].setBounds (LatencyBounds, JCA_IOT_WEBSERVER_METRICS_BUCKETS);
+      }
+      SnapshotSeq = 0;
+      DocsMaxUsed = 0;
+      DocsMaxMemory = 0;
+      DocsBusy = 0;
+      MsgOversize = 0;
+      WsQueued = 0;
+      WsDropped = 0;
+      WsCoalesced = 0;
+      WsConnected = 0;
+      WsRtt = 0;
+      WsRejected = 0;
+      WsEvicted = 0;
+      WsIdleTimeout = JCA_IOT_WEBSERVER_WS_IDLETIMEOUT;
+      WsSentCount = 0;
+      WsLastManage = WsLastUpdate;
+      EventsSeq = 0;
+      EventsJoined = false;
+      EventsJoinedSince = 0;
+      EventsLastUpdate = WsLastUpdate;
+      EventsLastFull = WsLastUpdate;
+      EventsConnected = 0;
+      MsgBusy = 0;
+      // update() has nothing to do, the Network is handled by handle()
+      setSchedule (1000, TaskPriority::Low);
     }
 
     /**
@@ -114,51 +184,51 @@ namespace JCA {
       // Get Wifi-Config from File5
       File ConfigFile = LittleFS.open (JCA_IOT_WEBSERVER_CONFIGPATH, "r");
       if (ConfigFile) {
-        Debug.println (FLAG_CONFIG, true, ObjectName, __func__, "Config File Found");
+        JCA_DEBUG_PRINTLN (FLAG_CONFIG, true, ObjectName, __func__, "Config File Found");
         DeserializationError Error = deserializeJson (JsonDoc, ConfigFile);
         if (!Error) {
-          Debug.println (FLAG_CONFIG, true, ObjectName, __func__, "Deserialize Done");
+          JCA_DEBUG_PRINTLN (FLAG_CONFIG, true, ObjectName, __func__, "Deserialize Done");
           JsonObject Config = JsonDoc.as<JsonObject> ();
           //------------------------------------------------------
           // Read WiFi Config
           //------------------------------------------------------
           if (Config.containsKey (JCA_IOT_WEBSERVER_CONFKEY_WIFI)) {
-            Debug.println (FLAG_CONFIG, true, ObjectName, __func__, "Config contains WiFi");
+            JCA_DEBUG_PRINTLN (FLAG_CONFIG, true, ObjectName, __func__, "Config contains WiFi");
             JsonObject WiFiConfig = Config[JCA_IOT_WEBSERVER_CONFKEY_WIFI].as<JsonObject> ();
             if (WiFiConfig.containsKey (JCA_IOT_WEBSERVER_CONFKEY_WIFI_SSID)) {
-              Debug.println (FLAG_CONFIG, true, ObjectName, __func__, "[WiFi] Found SSID");
+              JCA_DEBUG_PRINTLN (FLAG_CONFIG, true, ObjectName, __func__, "[WiFi] Found SSID");
               if (!Connector.setSsid (WiFiConfig[JCA_IOT_WEBSERVER_CONFKEY_WIFI_SSID].as<const char *> ())) {
-                Debug.println (FLAG_ERROR, true, ObjectName, __func__, "[WiFi] SSID invalid");
+                JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "[WiFi] SSID invalid");
               }
             }
             if (WiFiConfig.containsKey (JCA_IOT_WEBSERVER_CONFKEY_WIFI_PASS)) {
-              Debug.println (FLAG_CONFIG, true, ObjectName, __func__, "[WiFi] Found Password");
+              JCA_DEBUG_PRINTLN (FLAG_CONFIG, true, ObjectName, __func__, "[WiFi] Found Password");
               if (!Connector.setPassword (WiFiConfig[JCA_IOT_WEBSERVER_CONFKEY_WIFI_PASS].as<const char *> ())) {
-                Debug.println (FLAG_ERROR, true, ObjectName, __func__, "[WiFi] Password invalid");
+                JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "[WiFi] Password invalid");
               }
             }
             if (WiFiConfig.containsKey (JCA_IOT_WEBSERVER_CONFKEY_WIFI_DHCP)) {
-              Debug.println (FLAG_CONFIG, true, ObjectName, __func__, "[WiFi] Found DHCP");
+              JCA_DEBUG_PRINTLN (FLAG_CONFIG, true, ObjectName, __func__, "[WiFi] Found DHCP");
               if (!Connector.setDHCP (WiFiConfig[JCA_IOT_WEBSERVER_CONFKEY_WIFI_DHCP].as<bool> ())) {
-                Debug.println (FLAG_ERROR, true, ObjectName, __func__, "[WiFi] DHCP invalid");
+                JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "[WiFi] DHCP invalid");
               }
             }
             if (WiFiConfig.containsKey (JCA_IOT_WEBSERVER_CONFKEY_WIFI_IP)) {
-              Debug.println (FLAG_CONFIG, true, ObjectName, __func__, "[WiFi] Found IP");
+              JCA_DEBUG_PRINTLN (FLAG_CONFIG, true, ObjectName, __func__, "[WiFi] Found IP");
               if (!Connector.setIP (WiFiConfig[JCA_IOT_WEBSERVER_CONFKEY_WIFI_IP].as<const char *> ())) {
-                Debug.println (FLAG_ERROR, true, ObjectName, __func__, "[WiFi] IP invalid");
+                JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "[WiFi] IP invalid");
               }
             }
             if (WiFiConfig.containsKey (JCA_IOT_WEBSERVER_CONFKEY_WIFI_GATEWAY)) {
-              Debug.println (FLAG_CONFIG, true, ObjectName, __func__, "[WiFi] Found Gateway");
+              JCA_DEBUG_PRINTLN (FLAG_CONFIG, true, ObjectName, __func__, "[WiFi] Found Gateway");
               if (!Connector.setGateway (WiFiConfig[JCA_IOT_WEBSERVER_CONFKEY_WIFI_GATEWAY].as<const char *> ())) {
-                Debug.println (FLAG_ERROR, true, ObjectName, __func__, "[WiFi] Gateway invalid");
+                JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "[WiFi] Gateway invalid");
               }
             }
             if (WiFiConfig.containsKey (JCA_IOT_WEBSERVER_CONFKEY_WIFI_SUBNET)) {
-              Debug.println (FLAG_CONFIG, true, ObjectName, __func__, "[WiFi] Found Subnet");
+              JCA_DEBUG_PRINTLN (FLAG_CONFIG, true, ObjectName, __func__, "[WiFi] Found Subnet");
               if (!Connector.setSubnet (WiFiConfig[JCA_IOT_WEBSERVER_CONFKEY_WIFI_SUBNET].as<const char *> ())) {
-                Debug.println (FLAG_ERROR, true, ObjectName, __func__, "[WiFi] Subnet invalid");
+                JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "[WiFi] Subnet invalid");
               }
             }
           }
@@ -166,26 +236,26 @@ namespace JCA {
           // Read Server Config
           //------------------------------------------------------
           if (Config.containsKey (JCA_IOT_WEBSERVER_CONFKEY_HOSTNAME)) {
-            Debug.println (FLAG_CONFIG, true, ObjectName, __func__, "Config contains Hostname");
-            strncpy (Hostname, Config[JCA_IOT_WEBSERVER_CONFKEY_HOSTNAME].as<const char *> (), sizeof (Hostname));
+            JCA_DEBUG_PRINTLN (FLAG_CONFIG, true, ObjectName, __func__, "Config contains Hostname");
+            Hostname = Config[JCA_IOT_WEBSERVER_CONFKEY_HOSTNAME].as<String> ();
           }
           if (Config.containsKey (JCA_IOT_WEBSERVER_CONFKEY_PORT)) {
-            Debug.println (FLAG_CONFIG, true, ObjectName, __func__, "Config contains Serverport");
+            JCA_DEBUG_PRINTLN (FLAG_CONFIG, true, ObjectName, __func__, "Config contains Serverport");
             Port = Config[JCA_IOT_WEBSERVER_CONFKEY_PORT].as<uint16_t> ();
           }
           if (Config.containsKey (JCA_IOT_WEBSERVER_CONFKEY_SOCKETUPDATE)) {
-            Debug.println (FLAG_CONFIG, true, ObjectName, __func__, "Config contains WebSocket Update");
+            JCA_DEBUG_PRINTLN (FLAG_CONFIG, true, ObjectName, __func__, "Config contains WebSocket Update");
             WsUpdateCycle = Config[JCA_IOT_WEBSERVER_CONFKEY_SOCKETUPDATE].as<uint32_t> ();
           }
 
         } else {
-          Debug.print (FLAG_ERROR, true, ObjectName, __func__, "deserializeJson() failed: ");
-          Debug.println (FLAG_ERROR, true, ObjectName, __func__, Error.c_str ());
+          JCA_DEBUG_PRINT (FLAG_ERROR, true, ObjectName, __func__, "deserializeJson() failed: ");
+          JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, Error.c_str ());
           return false;
         }
         ConfigFile.close ();
       } else {
-        Debug.println (FLAG_ERROR, true, ObjectName, __func__, "Config File NOT found");
+        JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "Config File NOT found");
         return false;
       }
       return true;
@@ -197,23 +267,8 @@ namespace JCA {
      * @param _Tags Array of Config-Tags ("config": [])
      */
     void Webserver::setConfig (JsonArray _Tags) {
-      Debug.println (FLAG_CONFIG, false, ObjectName, __func__, "Set");
-      for (JsonObject Tag : _Tags) {
-        if (Tag[JsonTagName] == Hostname_Name) {
-          strncpy (Hostname, Tag[JsonTagValue].as<const char *> (), sizeof (Hostname));
-          if (Debug.print (FLAG_CONFIG, false, ObjectName, __func__, Hostname_Name)) {
-            Debug.print (FLAG_CONFIG, false, ObjectName, __func__, DebugSeparator);
-            Debug.println (FLAG_CONFIG, false, ObjectName, __func__, Hostname);
-          }
-        }
-        if (Tag[JsonTagName] == WsUpdateCycle_Name) {
-          WsUpdateCycle = Tag[JsonTagValue].as<uint32_t> ();
-          if (Debug.print (FLAG_CONFIG, false, ObjectName, __func__, WsUpdateCycle_Name)) {
-            Debug.print (FLAG_CONFIG, false, ObjectName, __func__, DebugSeparator);
-            Debug.println (FLAG_CONFIG, false, ObjectName, __func__, WsUpdateCycle);
-          }
-        }
-      }
+      JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, ObjectName, __func__, "Set");
+      setTags (this, Tags, TagGroup::Config, _Tags);
     }
 
     /**
@@ -230,72 +285,140 @@ namespace JCA {
      * @param _Tags Array of Commands ("cmd": [])
      */
     void Webserver::setCmd (JsonArray _Tags) {
-      Debug.println (FLAG_CONFIG, false, ObjectName, __func__, "Set");
-      for (JsonObject Tag : _Tags) {
-        if (Tag[JsonTagName] == TimeSync_Name) {
-          setTime (Tag[JsonTagValue].as<uint32_t> ());
-          if (Debug.print (FLAG_CONFIG, false, ObjectName, __func__, TimeSync_Name)) {
-            Debug.print (FLAG_CONFIG, false, ObjectName, __func__, DebugSeparator);
-            Debug.println (FLAG_CONFIG, false, ObjectName, __func__, getTime ());
-          }
-        }
-        if (Tag[JsonTagName] == SaveConfig_Name) {
-          if (Tag[JsonTagValue].as<bool> ()) {
-            onSaveConfigCB();
-          }
-          if (Debug.print (FLAG_CONFIG, false, ObjectName, __func__, SaveConfig_Name)) {
-            Debug.print (FLAG_CONFIG, false, ObjectName, __func__, DebugSeparator);
-            Debug.println (FLAG_CONFIG, false, ObjectName, __func__, Tag[JsonTagValue].as<bool> ());
-          }
-        }
+      JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, ObjectName, __func__, "Set");
+      setTags (this, Tags, TagGroup::Cmd, _Tags);
+    }
+
+    /**
+     * @brief Command to set the RTC
+     *
+     * @param _Value Epoch in seconds
+     */
+    void Webserver::doTimeSync (JsonVariant _Value) {
+      setTime (_Value.as<uint32_t> ());
+    }
+
+    /**
+     * @brief Command to save the current Config of all Elements
+     *
+     * @param _Value true to execute the Save-Callback
+     */
+    void Webserver::doSaveConfig (JsonVariant _Value) {
+      if (_Value.as<bool> ()) {
+        runJob (onSaveConfigCB, JCA_IOT_WEBSERVER_JOB_SAVECONFIG);
       }
     }
 
     /**
      * @brief Create a list of Config-Tags containing the current Value
      *
-     * @param _Tags Array the Tags have to add
+     * @param _Setup Writer inside the Element
      */
-    void Webserver::writeSetupConfig (File _SetupFile) {
-      Debug.println (FLAG_CONFIG, false, ObjectName, __func__, "Get");
-      _SetupFile.println (",\"" + String(JsonTagConfig) + "\":[");
-      _SetupFile.println ("{" + createSetupTag (Hostname_Name, Hostname_Text, Hostname_Comment, false, Hostname) + "}");
-      _SetupFile.println (",{" + createSetupTag (WsUpdateCycle_Name, WsUpdateCycle_Text, WsUpdateCycle_Comment, false, WsUpdateCycle_Unit, WsUpdateCycle) + "}");
-      _SetupFile.println ("]");
+    void Webserver::writeSetupConfig (JsonStream &_Setup) {
+      JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, ObjectName, __func__, "Get");
+      _Setup.beginArray (JsonTagConfig);
+      writeSetupTags (this, Tags, TagGroup::Config, _Setup);
+      _Setup.endArray ();
     }
 
     /**
      * @brief Create a list of Data-Tags containing the current Value
      *
-     * @param _Tags Array the Tags have to add
+     * @param _Setup Writer inside the Element
      */
-    void Webserver::writeSetupData (File _SetupFile) {
-      Debug.println (FLAG_CONFIG, false, ObjectName, __func__, "Get");
-      _SetupFile.println (",\"" + String(JsonTagData) + "\":[");
-      _SetupFile.println ("{" + createSetupTag (Time_Name, Time_Text, Time_Comment, true, getTime ()) + "}");
-      _SetupFile.println ("]");
+    void Webserver::writeSetupData (JsonStream &_Setup) {
+      JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, ObjectName, __func__, "Get");
+      _Setup.beginArray (JsonTagData);
+      writeSetupTags (this, Tags, TagGroup::Data, _Setup);
+      char Info[JCA_IOT_WEBSERVER_CLIENTINFO_LENGTH];
+      getClientInfo (Info, sizeof (Info));
+      writeSetupTag (_Setup, Time_Name, Time_Text, nullptr, true, getTime ());
+      writeSetupTag (_Setup, Rtt_Name, Rtt_Text, Rtt_Comment, true, "ms", WsRtt);
+      writeSetupTag (_Setup, Clients_Name, Clients_Text, Clients_Comment, true, Info);
+      _Setup.endArray ();
     }
 
     /**
      * @brief Create a list of Command-Informations
      *
-     * @param _Tags Array the Command-Infos have to add
+     * @param _Setup Writer inside the Element
      */
-    void Webserver::writeSetupCmdInfo (File _SetupFile) {
-      Debug.println (FLAG_CONFIG, false, ObjectName, __func__, "Get");
-      _SetupFile.println (",\"" + String(JsonTagCmdInfo) + "\":[");
-      _SetupFile.println ("{" + createSetupCmdInfo (TimeSync_Name, TimeSync_Text, TimeSync_Comment, TimeSync_Type) + "}");
-      _SetupFile.println (",{" + createSetupCmdInfo (SaveConfig_Name, SaveConfig_Text, SaveConfig_Comment, SaveConfig_Type, SaveConfig_BtnText) + "}");
-      _SetupFile.println ("]");
+    void Webserver::writeSetupCmdInfo (JsonStream &_Setup) {
+      JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, ObjectName, __func__, "Get");
+      _Setup.beginArray (JsonTagCmdInfo);
+      writeSetupTags (this, Tags, TagGroup::Cmd, _Setup);
+      _Setup.endArray ();
     }
 
     void Webserver::createConfigValues (JsonObject &_Values) {
-      _Values[Hostname_Name] = Hostname;
-      _Values[WsUpdateCycle_Name] = WsUpdateCycle;
+      createTagValues (this, Tags, TagGroup::Config, _Values);
     }
 
     void Webserver::createDataValues (JsonObject &_Values) {
-      _Values[Time_Name] = getTime ();
+      createTagValues (this, Tags, TagGroup::Data, _Values);
+      // Time and Client-Statistics change with every Second or Ping, they are not tracked and only sent with a full Request
+      if (ValuesSince > 0) {
+        return;
+      }
+      if (matchPatterns (ValuesTags, Time_Name)) {
+        _Values[Time_Name] = getTime ();
+      }
+      if (matchPatterns (ValuesTags, Rtt_Name)) {
+        _Values[Rtt_Name] = WsRtt;
+      }
+      if (matchPatterns (ValuesTags, Clients_Name)) {
+        // Non-const Values are copied by ArduinoJson
+        char Info[JCA_IOT_WEBSERVER_CLIENTINFO_LENGTH];
+        getClientInfo (Info, sizeof (Info));
+        _Values[Clients_Name] = (char *)Info;
+      }
+    }
+
+    void Webserver::trackChanges () {
+      DocsMaxUsed = OutDocs.maxUsed ();
+      DocsMaxMemory = OutDocs.maxMemory ();
+      DocsBusy = InDocs.exhausted () + OutDocs.exhausted ();
+      MsgBusy = MsgBuffers.exhausted ();
+      DebugHeld = Debug.pending ();
+      DebugDropped = Debug.dropped ();
+      AdmitLimited = 0;
+      for (uint8_t i = 0; i < ROUTE_COUNT; i++) {
+        AdmitLimited += RouteLimited[i];
+      }
+      // Send-Queues of the WebSocket-Clients
+      EventsConnected = Events.count ();
+      WsQueued = 0;
+      WsConnected = 0;
+      WsRtt = 0;
+      for (uint8_t i = 0; i < JCA_IOT_WEBSERVER_WS_MAXCLIENTS; i++) {
+        WsClientState &State = WsClients[i];
+        if (State.Id == 0 || Websocket.client (State.Id) == nullptr) {
+          continue;
+        }
+        WsConnected++;
+        WsRtt = max (WsRtt, State.Rtt);
+        WsQueued += State.Queued + (State.UpdatePending ? 1 : 0);
+      }
+      trackTags (this, Tags);
+    }
+
+    /**
+     * @brief Write the Send-Queue Statistics of all WebSocket-Clients
+     *
+     * @param _Buffer Target, truncated if too many Clients are connected
+     * @param _Size Size of the Target
+     */
+    void Webserver::getClientInfo (char *_Buffer, size_t _Size) {
+      size_t Length = 0;
+      _Buffer[0] = '\0';
+      for (uint8_t i = 0; i < JCA_IOT_WEBSERVER_WS_MAXCLIENTS && Length < _Size; i++) {
+        WsClientState &State = WsClients[i];
+        AsyncWebSocketClient *Client = State.Id != 0 ? Websocket.client (State.Id) : nullptr;
+        if (Client == nullptr) {
+          continue;
+        }
+        Length += snprintf (_Buffer + Length, _Size - Length, "%s%s: %u / %u / %u, %ums", Length > 0 ? ", " : "", Client->remoteIP ().toString ().c_str (), State.Queued + (State.UpdatePending ? 1 : 0), State.Dropped, State.Coalesced, State.Rtt);
+      }
     }
 
     /**
@@ -308,6 +431,14 @@ namespace JCA {
       // Read Config
       readConfig ();
 
+      // Documents for Requests and Responses, allocated once to keep the Heap unfragmented
+      if (InDocs.begin () < JCA_IOT_WEBSERVER_DOCPOOL_IN_COUNT || OutDocs.begin () < JCA_IOT_WEBSERVER_DOCPOOL_OUT_COUNT) {
+        JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "JSON-Documents not complete allocated");
+      }
+      if (!MsgBuffers.begin ()) {
+        JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "Message-Buffers not allocated");
+      }
+
       // WiFi Connection
       Connector.init ();
 
@@ -315,66 +446,56 @@ namespace JCA {
       Websocket.onEvent ([this] (AsyncWebSocket *_Server, AsyncWebSocketClient *_Client, AwsEventType _Type, void *_Arg, uint8_t *_Data, size_t _Len) { this->onWsEvent (_Server, _Client, _Type, _Arg, _Data, _Len); });
       Server.addHandler (&Websocket);
 
+      // Server-Sent Events - Init
+      Events.onConnect ([this] (AsyncEventSourceClient *_Client) { this->onEventsConnect (_Client); });
+      Server.addHandler (&Events);
+
       // Webserver - WiFi Config
-      Server.on (JCA_IOT_WEBSERVER_PATH_CONNECT, HTTP_GET, [this] (AsyncWebServerRequest *_Request) { this->onWebConnectGet (_Request); });
-      Server.on (JCA_IOT_WEBSERVER_PATH_CONNECT, HTTP_POST, [this] (AsyncWebServerRequest *_Request) { this->onWebConnectPost (_Request); });
+      Server.on (JCA_IOT_WEBSERVER_PATH_CONNECT, HTTP_GET, measureRoute (ROUTE_SYS, [this] (AsyncWebServerRequest *_Request) { this->onWebConnectGet (_Request); }));
+      Server.on (JCA_IOT_WEBSERVER_PATH_CONNECT, HTTP_POST, measureRoute (ROUTE_SYS, [this] (AsyncWebServerRequest *_Request) { this->onWebConnectPost (_Request); }));
 
       // Webserver - System Config
-      Server.on (JCA_IOT_WEBSERVER_PATH_SYS, HTTP_GET, [this] (AsyncWebServerRequest *_Request) { this->onWebSystemGet (_Request); });
+      Server.on (JCA_IOT_WEBSERVER_PATH_SYS, HTTP_GET, measureRoute (ROUTE_SYS, [this] (AsyncWebServerRequest *_Request) { this->onWebSystemGet (_Request); }));
       Server.on (
-          JCA_IOT_WEBSERVER_PATH_SYS_UPLOAD, HTTP_POST, [this] (AsyncWebServerRequest *_Request) { _Request->redirect (JCA_IOT_WEBSERVER_PATH_SYS); },
+          JCA_IOT_WEBSERVER_PATH_SYS_UPLOAD, HTTP_POST, measureRoute (ROUTE_SYS, [this] (AsyncWebServerRequest *_Request) { _Request->redirect (JCA_IOT_WEBSERVER_PATH_SYS); }),
           [this] (AsyncWebServerRequest *_Request, String _Filename, size_t _Index, uint8_t *_Data, size_t _Len, bool _Final) { this->onWebSystemUploadData (_Request, _Filename, _Index, _Data, _Len, _Final); });
       Server.on (
-          JCA_IOT_WEBSERVER_PATH_SYS_UPDATE, HTTP_POST, [this] (AsyncWebServerRequest *_Request) { this->onWebSystemUpdate (_Request); },
+          JCA_IOT_WEBSERVER_PATH_SYS_UPDATE, HTTP_POST, measureRoute (ROUTE_SYS, [this] (AsyncWebServerRequest *_Request) { this->onWebSystemUpdate (_Request); }),
           [this] (AsyncWebServerRequest *_Request, String _Filename, size_t _Index, uint8_t *_Data, size_t _Len, bool _Final) { this->onWebSystemUpdateData (_Request, _Filename, _Index, _Data, _Len, _Final); });
-      Server.on (JCA_IOT_WEBSERVER_PATH_SYS_RESET, HTTP_POST, [this] (AsyncWebServerRequest *_Request) { this->onWebSystemReset (_Request); });
+      Server.on (JCA_IOT_WEBSERVER_PATH_SYS_RESET, HTTP_POST, measureRoute (ROUTE_SYS, [this] (AsyncWebServerRequest *_Request) { this->onWebSystemReset (_Request); }));
 
       // Webserver - Custom Pages
-      Server.on ("/", HTTP_GET, [this] (AsyncWebServerRequest *_Request) { this->onWebHomeGet (_Request); });
-      Server.on (JCA_IOT_WEBSERVER_PATH_HOME, HTTP_GET, [this] (AsyncWebServerRequest *_Request) { this->onWebHomeGet (_Request); });
-      Server.on (JCA_IOT_WEBSERVER_PATH_CONFIG, HTTP_GET, [this] (AsyncWebServerRequest *_Request) { this->onWebConfigGet (_Request); });
+      Server.on ("/", HTTP_GET, measureRoute (ROUTE_WEB, [this] (AsyncWebServerRequest *_Request) { this->onWebHomeGet (_Request); }));
+      Server.on (JCA_IOT_WEBSERVER_PATH_HOME, HTTP_GET, measureRoute (ROUTE_WEB, [this] (AsyncWebServerRequest *_Request) { this->onWebHomeGet (_Request); }));
+      Server.on (JCA_IOT_WEBSERVER_PATH_CONFIG, HTTP_GET, measureRoute (ROUTE_WEB, [this] (AsyncWebServerRequest *_Request) { this->onWebConfigGet (_Request); }));
+
+      // Metrics
+      Server.on (JCA_IOT_WEBSERVER_PATH_METRICS, HTTP_GET, measureRoute (ROUTE_METRICS, [this] (AsyncWebServerRequest *_Request) { this->onWebMetricsGet (_Request); }));
 
-      // RestAPI
+      // RestAPI, the Element-Routes have to be registered before the general Route
       Server.on (
-          "/api", HTTP_ANY,
-          [this] (AsyncWebServerRequest *_Request) {
-            Debug.println (FLAG_TRAFFIC, true, this->ObjectName, "RestAPI", "Request");
-            DynamicJsonDocument JBuffer (1000);
-            JsonVariant InData;
-
-            DeserializationError Error = deserializeJson (JBuffer, (char *)(_Request->_tempObject));
-            if (Error) {
-              if (Debug.print (FLAG_ERROR, true, ObjectName, "RestAPI", "+ deserializeJson() failed: ")) {
-                Debug.println (FLAG_ERROR, true, ObjectName, "RestAPI", Error.c_str ());
-                Debug.print (FLAG_ERROR, true, ObjectName, "RestAPI", "+ Body:");
-                Debug.println (FLAG_ERROR, true, ObjectName, "RestAPI", (char *)(_Request->_tempObject));
-              }
-              JBuffer.clear ();
-            }
-            InData = JBuffer.as<JsonVariant> ();
-            this->onRestApiRequest (_Request, InData);
+          JCA_IOT_WEBSERVER_PATH_API_ELEMENTS, HTTP_ANY,
+          measureRoute (ROUTE_API, admitRoute (ROUTE_API, [this] (AsyncWebServerRequest *_Request) { this->onRestApiElement (_Request); })),
+          [this] (AsyncWebServerRequest *_Request, String _Filename, size_t _Index, uint8_t *_Data, size_t _Len, bool _Final) {
+            JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, this->ObjectName, "RestAPI", "File");
           },
+          [this] (AsyncWebServerRequest *_Request, uint8_t *_Data, size_t _Len, size_t _Index, size_t _Total) { this->onRestApiData (_Request, _Data, _Len, _Index, _Total); });
+      Server.on (
+          JCA_IOT_WEBSERVER_PATH_API, HTTP_ANY,
+          measureRoute (ROUTE_API, admitRoute (ROUTE_API, [this] (AsyncWebServerRequest *_Request) { this->onRestApiReceived (_Request); })),
           [this] (AsyncWebServerRequest *_Request, String _Filename, size_t _Index, uint8_t *_Data, size_t _Len, bool _Final) {
-            Debug.println (FLAG_TRAFFIC, true, this->ObjectName, "RestAPI", "File");
+            JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, this->ObjectName, "RestAPI", "File");
           },
-          [this] (AsyncWebServerRequest *_Request, uint8_t *_Data, size_t _Len, size_t _Index, size_t _Total) {
-            Debug.println (FLAG_TRAFFIC, true, this->ObjectName, "RestAPI", "Data");
-
-            if (_Total > 0 && _Request->_tempObject == nullptr) {
-              _Request->_tempObject = malloc (_Total + 10);
-            }
-            if (_Request->_tempObject != nullptr) {
-              memcpy ((uint8_t *)(_Request->_tempObject) + _Index, _Data, _Len);
-            }
-          });
+          [this] (AsyncWebServerRequest *_Request, uint8_t *_Data, size_t _Len, size_t _Index, size_t _Total) { this->onRestApiData (_Request, _Data, _Len, _Index, _Total); });
 
-      // Webserver - If not defined
-      Server.serveStatic ("/", LittleFS, "/")
-          .setDefaultFile (JCA_IOT_WEBSERVER_PATH_HOME);
+      // Webserver - If not defined, the Handler of the Files is wrapped to measure the Latency
+      AsyncStaticWebHandler *StaticFiles = new AsyncStaticWebHandler ("/", LittleFS, "/", nullptr);
+      StaticFiles->setDefaultFile (JCA_IOT_WEBSERVER_PATH_HOME);
+      Server.addHandler (new MeasuredWebHandler (StaticFiles, RouteLatency[ROUTE_STATIC]));
       Server.onNotFound ([] (AsyncWebServerRequest *_Request) { _Request->redirect (JCA_IOT_WEBSERVER_PATH_SYS); });
       Server.begin ();
 
-      Debug.println (FLAG_SETUP, true, ObjectName, __func__, "Done");
+      JCA_DEBUG_PRINTLN (FLAG_SETUP, true, ObjectName, __func__, "Done");
       return Connector.isConnected ();
     }
 
@@ -386,10 +507,47 @@ namespace JCA {
      */
     bool Webserver::handle () {
       uint32_t ActMillis = millis ();
-      // Update Cycle WebSocket
-      if (ActMillis - WsLastUpdate >= WsUpdateCycle && WsUpdateCycle > 0) {
-        doWsUpdate (nullptr);
-        WsLastUpdate = ActMillis;
+      MotionActive = inMotion ();
+      if (deferForMotion (MotionLastRun)) {
+        // Motion-Priority, the Change-Signal stays set and all Changes are pushed when the Movement is done
+        // or the Motion-Hold is over
+        if (ActMillis - WsLastUpdate >= JCA_IOT_WEBSERVER_WS_RATE_FAST) {
+          UpdatesDeferred++;
+          WsLastUpdate = ActMillis;
+        }
+      } else {
+        MotionLastRun = ActMillis;
+        // Deferred Background-Jobs, one per Call
+        if (JobCount > 0) {
+          SimpleCallback Job = Jobs[0];
+          JobCount--;
+          for (uint16_t i = 0; i < JobCount; i++) {
+            Jobs[i] = Jobs[i + 1];
+            JobKeys[i] = JobKeys[i + 1];
+          }
+          Jobs[JobCount] = nullptr;
+          JobKeys[JobCount] = nullptr;
+          Job ();
+        }
+        // Signaled Changes are pushed to the fast Clients, coalesced to the minimum Interval,
+        // slower Rate-Classes get them with their next Interval
+        if (ActMillis - WsLastPush >= WsMinInterval && takeChangeSignal ()) {
+          doWsUpdate (nullptr, false, true);
+          doEventsUpdate (true);
+          WsLastPush = ActMillis;
+        }
+        // Update Cycle WebSocket, every Client is updated in the Interval of its Rate-Class,
+        // after a Motion-Hold the Cycle is due at once
+        if (MotionActive || ActMillis - WsLastUpdate >= JCA_IOT_WEBSERVER_WS_RATE_FAST) {
+          doWsUpdate (nullptr, false);
+          doEventsUpdate (false);
+          WsLastUpdate = ActMillis;
+        }
+      }
+      // Ping, Timeouts and Cleanup of the WebSocket-Clients
+      if (ActMillis - WsLastManage >= JCA_IOT_WEBSERVER_WS_MANAGECYCLE) {
+        manageWsClients ();
+        WsLastManage = ActMillis;
       }
       // Check WiFi Connection
       Connector.handle ();
@@ -407,6 +565,40 @@ namespace JCA {
       onSaveConfigCB = _CB;
     }
 
+    /**
+     * @brief Run a Background-Job, like saving the Config
+     * While an Element is moving the Job is queued and run by handle() when the Movement is done
+     * or the Motion-Hold is over. A Job with the Key of a queued Job is not queued again,
+     * the queued Job does the same Work when it runs.
+     * @param _Job Function to run
+     * @param _Key Key of the Job, like JCA_IOT_WEBSERVER_JOB_SAVECONFIG, nullptr is never merged
+     * @return true Job is done or queued
+     * @return false no Job or Queue is full
+     */
+    bool Webserver::runJob (SimpleCallback _Job, const char *_Key) {
+      if (!_Job) {
+        return false;
+      }
+      if (!inMotion () && JobCount == 0) {
+        _Job ();
+        return true;
+      }
+      if (_Key != nullptr) {
+        for (uint16_t i = 0; i < JobCount; i++) {
+          if (JobKeys[i] != nullptr && strcmp (JobKeys[i], _Key) == 0) {
+            return true;
+          }
+        }
+      }
+      if (JobCount >= JCA_IOT_WEBSERVER_JOBS) {
+        JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "Job-Queue full, Job dropped");
+        return false;
+      }
+      JobKeys[JobCount] = _Key;
+      Jobs[JobCount++] = _Job;
+      return true;
+    }
+
     void Webserver::setTime (unsigned long _Epoch, int _Millis) {
       Rtc.setTime (_Epoch, _Millis);
     }
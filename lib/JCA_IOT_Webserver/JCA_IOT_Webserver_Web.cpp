@@ -35,29 +35,29 @@ namespace JCA {
 
       File ConfigFile = LittleFS.open (JCA_IOT_WEBSERVER_CONFIGPATH, "r");
       if (ConfigFile) {
-        Debug.println (FLAG_CONFIG, true, ObjectName, __func__, "Config File Found");
+        JCA_DEBUG_PRINTLN (FLAG_CONFIG, true, ObjectName, __func__, "Config File Found");
         DeserializationError Error = deserializeJson (JsonDoc, ConfigFile);
         if (!Error) {
-          Debug.println (FLAG_CONFIG, true, ObjectName, __func__, "Deserialize Done");
+          JCA_DEBUG_PRINTLN (FLAG_CONFIG, true, ObjectName, __func__, "Deserialize Done");
           Config = JsonDoc.as<JsonObject> ();
           if (Config.containsKey (JCA_IOT_WEBSERVER_CONFKEY_WIFI)) {
-            Debug.println (FLAG_CONFIG, true, ObjectName, __func__, "Config Node Found");
+            JCA_DEBUG_PRINTLN (FLAG_CONFIG, true, ObjectName, __func__, "Config Node Found");
             WiFiConfig = Config[JCA_IOT_WEBSERVER_CONFKEY_WIFI].as<JsonObject> ();
           } else {
-            Debug.println (FLAG_CONFIG, true, ObjectName, __func__, "Config Node Created");
+            JCA_DEBUG_PRINTLN (FLAG_CONFIG, true, ObjectName, __func__, "Config Node Created");
             WiFiConfig = JsonDoc.createNestedObject (JCA_IOT_WEBSERVER_CONFKEY_WIFI);
           }
         } else {
-          Debug.print (FLAG_ERROR, true, ObjectName, __func__, "deserializeJson() failed: ");
-          Debug.println (FLAG_ERROR, true, ObjectName, __func__, Error.c_str ());
-          Debug.println (FLAG_ERROR, true, ObjectName, __func__, "Create new Konfig");
+          JCA_DEBUG_PRINT (FLAG_ERROR, true, ObjectName, __func__, "deserializeJson() failed: ");
+          JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, Error.c_str ());
+          JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "Create new Konfig");
           JsonDoc.clear ();
           WiFiConfig = Config.createNestedObject (JCA_IOT_WEBSERVER_CONFKEY_WIFI);
         }
         ConfigFile.close();
       } else {
-        Debug.println (FLAG_ERROR, true, ObjectName, __func__, "Config File NOT found");
-        Debug.println (FLAG_ERROR, true, ObjectName, __func__, "Create new Konfig");
+        JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "Config File NOT found");
+        JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "Create new Konfig");
         JsonDoc.clear ();
         WiFiConfig = JsonDoc.createNestedObject (JCA_IOT_WEBSERVER_CONFKEY_WIFI);
       }
@@ -83,9 +83,9 @@ namespace JCA {
       ConfigFile = LittleFS.open (JCA_IOT_WEBSERVER_CONFIGPATH, "w");
       size_t WrittenBytes = serializeJson (JsonDoc, ConfigFile);
       ConfigFile.close();
-      Debug.print (FLAG_CONFIG, true, ObjectName, __func__, "Write Config File [");
-      Debug.print (FLAG_CONFIG, true, ObjectName, __func__, WrittenBytes);
-      Debug.println (FLAG_CONFIG, true, ObjectName, __func__, "]");
+      JCA_DEBUG_PRINT (FLAG_CONFIG, true, ObjectName, __func__, "Write Config File [");
+      JCA_DEBUG_PRINT (FLAG_CONFIG, true, ObjectName, __func__, WrittenBytes);
+      JCA_DEBUG_PRINTLN (FLAG_CONFIG, true, ObjectName, __func__, "]");
 
       // Read back Config-File
       readConfig();
@@ -136,19 +136,19 @@ namespace JCA {
       if (!_Request->authenticate (ConfUser, ConfPassword)) {
         return _Request->requestAuthentication ();
       }
-      Debug.println (FLAG_TRAFFIC, true, ObjectName, __func__, String ("Client:" + _Request->client ()->remoteIP ().toString () + " " + _Request->url ()));
+      JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, String ("Client:" + _Request->client ()->remoteIP ().toString () + " " + _Request->url ()));
       if (!_Index) {
-        Debug.println (FLAG_TRAFFIC, true, ObjectName, __func__, String ("Upload Start: " + String (_Filename)));
+        JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, String ("Upload Start: " + String (_Filename)));
         // open the file on first call and store the file handle in the request object
         _Request->_tempFile = LittleFS.open ("/" + _Filename, "w");
       }
       if (_Len) {
-        Debug.println (FLAG_TRAFFIC, true, ObjectName, __func__, String ("Writing file: " + String (_Filename) + " index=" + String (_Index) + " len=" + String (_Len)));
+        JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, String ("Writing file: " + String (_Filename) + " index=" + String (_Index) + " len=" + String (_Len)));
         // stream the incoming chunk to the opened file
         _Request->_tempFile.write (_Data, _Len);
       }
       if (_Final) {
-        Debug.println (FLAG_TRAFFIC, true, ObjectName, __func__, String ("Upload Complete: " + String (_Filename) + ",size: " + String (_Index + _Len)));
+        JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, String ("Upload Complete: " + String (_Filename) + ",size: " + String (_Index + _Len)));
         // close the file handle as the upload is now done
         _Request->_tempFile.close ();
       }
@@ -185,28 +185,28 @@ namespace JCA {
         return _Request->requestAuthentication ();
       }
       if (!_Index) {
-        Debug.print (FLAG_TRAFFIC, true, ObjectName, __func__, "Update Start: ");
-        Debug.println (FLAG_TRAFFIC, true, ObjectName, __func__, _Filename.c_str ());
+        JCA_DEBUG_PRINT (FLAG_TRAFFIC, true, ObjectName, __func__, "Update Start: ");
+        JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, _Filename.c_str ());
         Update.runAsync (true);
         if (!Update.begin ((ESP.getFreeSketchSpace () - 0x1000) & 0xFFFFF000)) {
-          if (Debug.print (FLAG_ERROR, true, ObjectName, __func__, "")){
+          if (JCA_DEBUG_PRINT (FLAG_ERROR, true, ObjectName, __func__, "")){
             Update.printError (Serial);
           }
         }
       }
       if (!Update.hasError ()) {
         if (Update.write (_Data, _Len) != _Len) {
-          if (Debug.print (FLAG_ERROR, true, ObjectName, __func__, "")) {
+          if (JCA_DEBUG_PRINT (FLAG_ERROR, true, ObjectName, __func__, "")) {
             Update.printError (Serial);
           }
         }
       }
       if (_Final) {
         if (Update.end (true)) {
-          Debug.print (FLAG_TRAFFIC, true, ObjectName, __func__, "Update Success: ");
-          Debug.println (FLAG_TRAFFIC, true, ObjectName, __func__, _Index + _Len);
+          JCA_DEBUG_PRINT (FLAG_TRAFFIC, true, ObjectName, __func__, "Update Success: ");
+          JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, _Index + _Len);
         } else {
-          if (Debug.print (FLAG_ERROR, true, ObjectName, __func__, "")) {
+          if (JCA_DEBUG_PRINT (FLAG_ERROR, true, ObjectName, __func__, "")) {
             Update.printError (Serial);
           }
         }
@@ -261,7 +261,7 @@ namespace JCA {
      */
     String Webserver::replaceDefaultWildcards (const String &var) {
       if (var == "TITLE") {
-        return String (Hostname);
+        return Hostname;
       }
       if (var == "SVG_LOGO") {
         return String (SvgLogo);
@@ -333,7 +333,7 @@ namespace JCA {
       String RetVal;
       RetVal = replaceDefaultWildcards (var);
       if (!RetVal.isEmpty()) {
-        Debug.println (FLAG_TRAFFIC, true, ObjectName, __func__, "Replace from Default Function");
+        JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, "Replace from Default Function");
         return RetVal;
       }
       if (var == "NAME") {
@@ -376,16 +376,16 @@ namespace JCA {
       String RetVal;
       RetVal = Connector.replaceWildcards (var);
       if (!RetVal.isEmpty ()) {
-        Debug.println (FLAG_TRAFFIC, true, ObjectName, __func__, "Replace from Connector Function") ;
+        JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, "Replace from Connector Function") ;
         return RetVal;
       }
       RetVal = replaceDefaultWildcards (var);
       if (!RetVal.isEmpty ()) {
-        Debug.println (FLAG_TRAFFIC, true, ObjectName, __func__, "Replace from Default Function");
+        JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, "Replace from Default Function");
         return RetVal;
       }
       if (var == "SECTION") {
-        Debug.println (FLAG_TRAFFIC, true, ObjectName, __func__, var);
+        JCA_DEBUG_PRINTLN (FLAG_TRAFFIC, true, ObjectName, __func__, var);
         return String (SectionConnect);
       }
       return String ();
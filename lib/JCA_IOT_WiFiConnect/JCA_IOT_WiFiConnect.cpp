@@ -175,31 +175,31 @@ namespace JCA {
      * @return false Data is invalid or can't connect to AP
      */
     bool WiFiConnect::init (const char *_Ssid, const char *_Password, const char *_IP, const char *_Gateway, const char *_Subnet, bool _DHCP) {
-      Debug.println (FLAG_SETUP, true, ObjectName, __func__, "Started");
+      JCA_DEBUG_PRINTLN (FLAG_SETUP, true, ObjectName, __func__, "Started");
       bool DataValid = true;
       if (!setSsid (_Ssid)) {
         DataValid = false;
-        Debug.println (FLAG_SETUP, true, ObjectName, __func__, "SSID Invalid");
+        JCA_DEBUG_PRINTLN (FLAG_SETUP, true, ObjectName, __func__, "SSID Invalid");
       }
       if (!setPassword (_Password)) {
         DataValid = false;
-        Debug.println (FLAG_SETUP, true, ObjectName, __func__, "Pasword Invalid");
+        JCA_DEBUG_PRINTLN (FLAG_SETUP, true, ObjectName, __func__, "Pasword Invalid");
       }
       if (!setIP (_IP)) {
         DataValid = false;
-        Debug.println (FLAG_SETUP, true, ObjectName, __func__, "IP Invalid");
+        JCA_DEBUG_PRINTLN (FLAG_SETUP, true, ObjectName, __func__, "IP Invalid");
       }
       if (!setGateway (_Gateway)) {
         DataValid = false;
-        Debug.println (FLAG_SETUP, true, ObjectName, __func__, "Gateway Invalid");
+        JCA_DEBUG_PRINTLN (FLAG_SETUP, true, ObjectName, __func__, "Gateway Invalid");
       }
       if (!setSubnet (_Subnet)) {
         DataValid = false;
-        Debug.println (FLAG_SETUP, true, ObjectName, __func__, "Subnet Invalid");
+        JCA_DEBUG_PRINTLN (FLAG_SETUP, true, ObjectName, __func__, "Subnet Invalid");
       }
       if (!setDHCP (_DHCP)) {
         DataValid = false;
-        Debug.println (FLAG_SETUP, true, ObjectName, __func__, "DHCP Invalid");
+        JCA_DEBUG_PRINTLN (FLAG_SETUP, true, ObjectName, __func__, "DHCP Invalid");
       }
       if (DataValid) {
         handle ();
@@ -216,7 +216,7 @@ namespace JCA {
      * @return false never
      */
     bool WiFiConnect::init () {
-      Debug.println (FLAG_SETUP, true, ObjectName, __func__, "Not initialized");
+      JCA_DEBUG_PRINTLN (FLAG_SETUP, true, ObjectName, __func__, "Not initialized");
       return false;
     }
 
@@ -233,33 +233,33 @@ namespace JCA {
         // Init Connection
         //-----------------------------
         WiFi.persistent (true);
-        Debug.println (FLAG_SETUP, true, ObjectName, __func__, "[Init] Started");
+        JCA_DEBUG_PRINTLN (FLAG_SETUP, true, ObjectName, __func__, "[Init] Started");
         if (isConfigured ()) {
           int ConnectCounter = 0;
           // Set static IP
           if (!DHCP) {
-            Debug.println (FLAG_SETUP, true, ObjectName, __func__, "[Init] Set static IP");
+            JCA_DEBUG_PRINTLN (FLAG_SETUP, true, ObjectName, __func__, "[Init] Set static IP");
             if (!WiFi.config (IP, Gateway, Subnet)) {
-              Debug.println (FLAG_ERROR, true, ObjectName, __func__, "[Init] Static IP failed");
+              JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "[Init] Static IP failed");
             }
           }
 
           // Connect to Network
-          Debug.print (FLAG_SETUP, true, ObjectName, __func__, "[Init] Connect ");
+          JCA_DEBUG_PRINT (FLAG_SETUP, true, ObjectName, __func__, "[Init] Connect ");
           WiFi.mode (WIFI_STA);
           WiFi.begin (Ssid, Password);
           while (WiFi.status () != WL_CONNECTED && ConnectCounter < 10) {
-            Debug.print (FLAG_SETUP, true, ObjectName, __func__, "0");
+            JCA_DEBUG_PRINT (FLAG_SETUP, true, ObjectName, __func__, "0");
             delay (500);
             ConnectCounter++;
           }
 
           if (WiFi.status () == WL_CONNECTED) {
-            Debug.print (FLAG_SETUP, true, ObjectName, __func__, " DONE : ");
-            Debug.println (FLAG_SETUP, true, ObjectName, __func__, WiFi.localIP().toString());
+            JCA_DEBUG_PRINT (FLAG_SETUP, true, ObjectName, __func__, " DONE : ");
+            JCA_DEBUG_PRINTLN (FLAG_SETUP, true, ObjectName, __func__, WiFi.localIP().toString());
             State = STA;
           } else {
-            Debug.println (FLAG_SETUP, true, ObjectName, __func__, " FAILED");
+            JCA_DEBUG_PRINTLN (FLAG_SETUP, true, ObjectName, __func__, " FAILED");
             BusyTimer = millis ();
             State = Failed;
           }
@@ -280,14 +280,14 @@ namespace JCA {
 
         // Set static IP
         if (!DHCP) {
-          Debug.println (FLAG_SETUP, true, ObjectName, __func__, "[Connect] Set static IP");
+          JCA_DEBUG_PRINTLN (FLAG_SETUP, true, ObjectName, __func__, "[Connect] Set static IP");
           if (!WiFi.config (IP, Gateway, Subnet)) {
-            Debug.println (FLAG_ERROR, true, ObjectName, __func__, "[Connect] Static IP failed");
+            JCA_DEBUG_PRINTLN (FLAG_ERROR, true, ObjectName, __func__, "[Connect] Static IP failed");
           }
         }
 
         // Connect to Network
-        Debug.println (FLAG_SETUP, true, ObjectName, __func__, "[Connect] Connect ");
+        JCA_DEBUG_PRINTLN (FLAG_SETUP, true, ObjectName, __func__, "[Connect] Connect ");
         WiFi.mode (WIFI_STA);
         WiFi.begin (Ssid, Password);
         BusyTimer = millis ();
@@ -299,13 +299,13 @@ namespace JCA {
         // Wait for Connection
         //-----------------------------
         if (WiFi.status () == WL_CONNECTED && WiFi.getMode () == WIFI_STA) {
-          Debug.print (FLAG_SETUP, true, ObjectName, __func__, "[Connect] Connect DONE : ");
-          Debug.println (FLAG_SETUP, true, ObjectName, __func__, WiFi.localIP ().toString ());
+          JCA_DEBUG_PRINT (FLAG_SETUP, true, ObjectName, __func__, "[Connect] Connect DONE : ");
+          JCA_DEBUG_PRINTLN (FLAG_SETUP, true, ObjectName, __func__, WiFi.localIP ().toString ());
           State = STA;
         } else {
           digitalWrite (LED_BUILTIN, !digitalRead (LED_BUILTIN));
           if (millis () - BusyTimer > JCA_IOT_WIFICONNECT_DELAY_FAILED) {
-            Debug.println (FLAG_SETUP, true, ObjectName, __func__, "[Connect] Connect FAILED");
+            JCA_DEBUG_PRINTLN (FLAG_SETUP, true, ObjectName, __func__, "[Connect] Connect FAILED");
             State = Failed;
           }
         }
@@ -315,8 +315,8 @@ namespace JCA {
         //-----------------------------
         // Connection Failt, setup AP
         //-----------------------------
-        Debug.print (FLAG_SETUP, true, ObjectName, __func__, "[Failed] Start AP: ");
-        Debug.println (FLAG_SETUP, true, ObjectName, __func__, ApSsid);
+        JCA_DEBUG_PRINT (FLAG_SETUP, true, ObjectName, __func__, "[Failed] Start AP: ");
+        JCA_DEBUG_PRINTLN (FLAG_SETUP, true, ObjectName, __func__, ApSsid);
         WiFi.mode (WIFI_AP);
         WiFi.softAPConfig (ApIP, ApGateway, ApSubnet);
         WiFi.softAP (ApSsid, ApPassword);
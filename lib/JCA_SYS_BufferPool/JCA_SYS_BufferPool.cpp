@@ -0,0 +1,128 @@
+/**
+ * @file JCA_SYS_BufferPool.cpp
+ * @author JCA (https://github.com/ichok)
+ * @brief Fixed Pool of reusable Byte-Buffers
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Copyright Jochen Cabrera 2022
+ * Apache License
+ *
+ */
+
+#include <JCA_SYS_BufferPool.h>
+
+namespace JCA {
+  namespace SYS {
+    /**
+     * @brief Construct a new BufferPool::BufferPool object
+     * The Buffers are allocated on begin()
+     * @param _Count Number of Buffers, limited to JCA_SYS_BUFFERPOOL_MAXBUFFERS
+     * @param _Size Size of every Buffer in Bytes
+     */
+    BufferPool::BufferPool (uint8_t _Count, size_t _Size) {
+      Block = nullptr;
+      Count = _Count < JCA_SYS_BUFFERPOOL_MAXBUFFERS ? _Count : JCA_SYS_BUFFERPOOL_MAXBUFFERS;
+      Size = _Size;
+      InUse = 0;
+      Used = 0;
+      MaxUsed = 0;
+      Exhausted = 0;
+    }
+
+    /**
+     * @brief Destroy the BufferPool::BufferPool object
+     */
+    BufferPool::~BufferPool () {
+      free (Block);
+    }
+
+    /**
+     * @brief Allocate the Buffers in one Block
+     *
+     * @return true Buffers allocated
+     * @return false not enough Memory, take() always fails
+     */
+    bool BufferPool::begin () {
+      if (Block == nullptr) {
+        Block = (uint8_t *)malloc (Count * Size);
+      }
+      return Block != nullptr;
+    }
+
+    /**
+     * @brief Check out a free Buffer
+     * The Buffer has to be given back with give()
+     * @return uint8_t* Buffer with size() Bytes, nullptr if all Buffers are in use
+     */
+    uint8_t *BufferPool::take () {
+      if (Block != nullptr) {
+        for (uint8_t i = 0; i < Count; i++) {
+          uint16_t Mask = 1 << i;
+          if ((InUse & Mask) == 0) {
+            InUse |= Mask;
+            Used++;
+            if (Used > MaxUsed) {
+              MaxUsed = Used;
+            }
+            return Block + i * Size;
+          }
+        }
+      }
+      Exhausted++;
+      return nullptr;
+    }
+
+    /**
+     * @brief Give a Buffer back to the Pool
+     *
+     * @param _Buffer Buffer from take(), nullptr is ignored
+     */
+    void BufferPool::give (uint8_t *_Buffer) {
+      if (_Buffer == nullptr || _Buffer < Block || _Buffer >= Block + Count * Size) {
+        return;
+      }
+      uint16_t Mask = 1 << ((_Buffer - Block) / Size);
+      if (InUse & Mask) {
+        InUse &= ~Mask;
+        Used--;
+      }
+    }
+
+    /**
+     * @brief Size of every Buffer
+     *
+     * @return size_t Bytes
+     */
+    size_t BufferPool::size () {
+      return Size;
+    }
+
+    /**
+     * @brief Number of checked out Buffers
+     *
+     * @return uint8_t Buffers
+     */
+    uint8_t BufferPool::used () {
+      return Used;
+    }
+
+    /**
+     * @brief Maximum Number of checked out Buffers at the same Time
+     *
+     * @return uint8_t Buffers
+     */
+    uint8_t BufferPool::maxUsed () {
+      return MaxUsed;
+    }
+
+    /**
+     * @brief Number of Requests without a free Buffer
+     *
+     * @return uint32_t Rejected Requests
+     */
+    uint32_t BufferPool::exhausted () {
+      return Exhausted;
+    }
+  }
+}
@@ -0,0 +1,54 @@
+/**
+ * @file JCA_SYS_BufferPool.h
+ * @author JCA (https://github.com/ichok)
+ * @brief Fixed Pool of reusable Byte-Buffers
+ * All Buffers are allocated in one Block on begin(), so incoming Messages
+ * are collected without Heap-Allocations and the Memory is bounded.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Copyright Jochen Cabrera 2022
+ * Apache License
+ *
+ */
+
+#ifndef _JCA_SYS_BUFFERPOOL_
+#define _JCA_SYS_BUFFERPOOL_
+#include <Arduino.h>
+
+// Maximum Number of Buffers inside one Pool
+#define JCA_SYS_BUFFERPOOL_MAXBUFFERS 16
+
+namespace JCA {
+  namespace SYS {
+    /**
+     * @brief
+     * Pool of equal sized Buffers with Usage-Statistics
+     */
+    class BufferPool {
+    private:
+      uint8_t *Block;
+      uint8_t Count;
+      size_t Size;
+      uint16_t InUse; ///< Bit n = Buffer n is checked out
+      uint8_t Used;
+      uint8_t MaxUsed;
+      uint32_t Exhausted;
+
+    public:
+      BufferPool (uint8_t _Count, size_t _Size);
+      ~BufferPool ();
+      bool begin ();
+
+      uint8_t *take ();
+      void give (uint8_t *_Buffer);
+
+      size_t size ();
+      uint8_t used ();
+      uint8_t maxUsed ();
+      uint32_t exhausted ();
+    };
+  }
+}
+
+#endif
@@ -4,6 +4,8 @@
  * @brief The DebugOut Class is used to handle Debug-Prints,
  * Serial prints for the selected Debug-Level.
  * It's declerated as `extern DebugOut Debug(Serial)` to use in all other Parts of the JCA::IOT Namespace
+ * The Messages are stored as Records in a Ring-Buffer and written to the Serial interface by handle()
+ * Numbers and Flash-Strings are stored binary and formatted by handle()
  * @version 0.1
  * @date 2022-09-04
  *
@@ -22,7 +24,10 @@ namespace JCA {
      * @param _Serial The Serial-Interface to use for Debug output
      */
     DebugOut::DebugOut (const HardwareSerial &_Serial) : DebugSerial (_Serial) {
+      Flags = FLAG_NONE;
       NewLine = true;
+      Holding = false;
+      LastDrain = 0;
     }
 
     /**
@@ -32,42 +37,79 @@ namespace JCA {
     DebugOut::~DebugOut () {
     }
 
-    String DebugOut::getPrefix (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function) {
-      String RetVal = "";
-      if (NewLine) {
-        switch (_Flag)
-        {
+    /**
+     * @brief Open a new Record for a Message, the Element-Name is only stored at the Start of a Line
+     *
+     * @param _Flag Flag for Debug Message
+     * @param _Framework use from Framework, add the Namespace tp Prefix
+     * @param _ElementName Name of the Object or Function-Group that calls the Function
+     * @param _Function Name of the Function
+     */
+    void DebugOut::beginRecord (DEBUGOUT_FLAGS _Flag, bool _Framework, const DebugName &_ElementName, const char *_Function) {
+      Ring.begin (_Flag, _Framework, _ElementName, _Function, NewLine);
+      NewLine = false;
+    }
+
+    /**
+     * @brief Write the next Part of the Output to the Serial interface
+     * The current Line is sent first, then the next Record is formatted as
+     * "[FLAG] [JCA::]Object::Function - Message", binary Values are printed here
+     * @param _Block Wait for the UART, else only fill the free Space of the FIFO
+     * @return true Something was written and there may be more
+     * @return false Nothing to write or the UART is busy
+     */
+    bool DebugOut::drain (bool _Block) {
+      if (!Line.send (DebugSerial, _Block)) {
+        return false;
+      }
+      DebugRecord Record;
+      if (!Ring.read (Record)) {
+        return false;
+      }
+      Line.clear ();
+      if (Record.Options & RECORD_PREFIX) {
+        switch (Record.Flag) {
         case FLAG_ERROR:
-          RetVal += "[ERROR] ";
+          Line.print (F ("[ERROR] "));
           break;
 
         case FLAG_SETUP:
-          RetVal += "[SETUP] ";
+          Line.print (F ("[SETUP] "));
           break;
 
         case FLAG_CONFIG:
-          RetVal += "[CONFIG] ";
+          Line.print (F ("[CONFIG] "));
           break;
 
         case FLAG_TRAFFIC:
-          RetVal += "[TRAFFIC] ";
+          Line.print (F ("[TRAFFIC] "));
           break;
 
         case FLAG_LOOP:
-          RetVal += "[LOOP] ";
+          Line.print (F ("[LOOP] "));
           break;
 
         default:
-          RetVal += "[---]" ;
+          Line.print (F ("[---]"));
           break;
         }
-        if (_Framework) {
-          RetVal += "JCA::";
+        if (Record.Options & RECORD_FRAMEWORK) {
+          Line.print (F ("JCA::"));
         }
-        RetVal += String(_ElementName) + String("::") + String(_Function) + String(" - ");
-        NewLine = false;
+        Ring.readText (Line, Record.NameLength);
+        Line.print (F ("::"));
+        Line.print (Record.Function);
+        Line.print (F (" - "));
+      }
+      if (Record.Type == RECORD_TEXT) {
+        Ring.readText (Line, Record.Length - Record.NameLength);
+      } else {
+        Ring.readValue (Line, Record.Type, Record.Length - Record.NameLength);
+      }
+      if (Record.Options & RECORD_NEWLINE) {
+        Line.println ();
       }
-      return RetVal;
+      return true;
     }
 
     /**
@@ -93,6 +135,58 @@ namespace JCA {
       init (_Flags, JCA_SYS_DebugOut_DEFAULT_BAUD);
     }
 
+    /**
+     * @brief Hold the Output, like while timing-critical Hardware is moving
+     * The Records stay in the Ring-Buffer and are written by handle() when the Hold ends,
+     * a long Hold is interrupted every JCA_SYS_DebugOut_MAXHOLD to keep the Buffer from overflowing
+     * @param _Hold true to hold, false to continue the Output
+     */
+    void DebugOut::hold (bool _Hold) {
+      Holding = _Hold;
+    }
+
+    /**
+     * @brief Write the waiting Records to the Serial interface, has to be called in the Loop
+     * Only the free Space of the UART-FIFO is filled, so the Loop is never blocked
+     */
+    void DebugOut::handle () {
+      uint32_t ActMillis = millis ();
+      if (Holding && ActMillis - LastDrain < JCA_SYS_DebugOut_MAXHOLD) {
+        return;
+      }
+      LastDrain = ActMillis;
+      while (drain (false)) {
+      }
+    }
+
+    /**
+     * @brief Write all waiting Records and wait for the UART, like before a Restart
+     * Also ignores the Hold. Blocks the Loop until the UART is done (about 1 ms per 7 Chars at 74880 Baud),
+     * so it's only for Setup, before a Restart or after a fatal Error, never in the Loop or while a Drive is moving
+     */
+    void DebugOut::flush () {
+      while (drain (true)) {
+      }
+    }
+
+    /**
+     * @brief Bytes waiting in the Ring-Buffer
+     *
+     * @return size_t Length of the waiting Records
+     */
+    size_t DebugOut::pending () {
+      return Ring.length ();
+    }
+
+    /**
+     * @brief Messages dropped because the Ring-Buffer was full
+     *
+     * @return uint32_t Number of dropped Records
+     */
+    uint32_t DebugOut::dropped () {
+      return Ring.dropped ();
+    }
+
     /**
      * @brief Generate a Debug-Output depends on the selected Falgs on init, without line break.
      * "[JCA::IOT::]Object::Function - Message"
@@ -105,10 +199,11 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, const Printable &_Message) {
+    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, const Printable &_Message) {
       if (_Flag & Flags) {
-        DebugSerial.print(getPrefix(_Flag, _Framework, _ElementName, _Function));
-        DebugSerial.print(_Message);
+        beginRecord (_Flag, _Framework, _ElementName, _Function);
+        Ring.print (_Message);
+        Ring.commit ();
         return true;
       } else {
         return false;
@@ -126,9 +221,9 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, const Printable &_Message) {
+    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, const Printable &_Message) {
       if (print (_Flag, _Framework, _ElementName, _Function, _Message)) {
-        DebugSerial.println ();
+        Ring.endLine ();
         NewLine = true;
         return true;
       } else {
@@ -148,10 +243,11 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, const String &_Message) {
+    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, const String &_Message) {
       if (_Flag & Flags) {
-        DebugSerial.print (getPrefix (_Flag, _Framework, _ElementName, _Function));
-        DebugSerial.print (_Message);
+        beginRecord (_Flag, _Framework, _ElementName, _Function);
+        Ring.print (_Message);
+        Ring.commit ();
         return true;
       } else {
         return false;
@@ -169,9 +265,9 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, const String &_Message) {
+    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, const String &_Message) {
       if (print (_Flag, _Framework, _ElementName, _Function, _Message)) {
-        DebugSerial.println ();
+        Ring.endLine ();
         NewLine = true;
         return true;
       } else {
@@ -191,10 +287,11 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, const char *_Message) {
+    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, const char *_Message) {
       if (_Flag & Flags) {
-        DebugSerial.print (getPrefix (_Flag, _Framework, _ElementName, _Function));
-        DebugSerial.print (_Message);
+        beginRecord (_Flag, _Framework, _ElementName, _Function);
+        Ring.print (_Message);
+        Ring.commit ();
         return true;
       } else {
         return false;
@@ -212,9 +309,52 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, const char *_Message) {
+    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, const char *_Message) {
+      if (print (_Flag, _Framework, _ElementName, _Function, _Message)) {
+        Ring.endLine ();
+        NewLine = true;
+        return true;
+      } else {
+        return false;
+      }
+    }
+    /**
+     * @brief Generate a Debug-Output depends on the selected Falgs on init, without line break.
+     * "[JCA::IOT::]Object::Function - Message"
+     *
+     * @param _Flag Flag for Debug Message, only Output if Flag set on init
+     * @param _Framework use from Framework, add the Namespace tp Prefix
+     * @param _ElementName Name of the Object or Function-Group that calls the Function
+     * @param _Function Name of the Function
+     * @param _Message Message Text in Flash, only the Pointer is stored
+     * @return true Message was output to Debug-Interface
+     * @return false Message not output to Debug-Interface
+     */
+    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, const __FlashStringHelper *_Message) {
+      if (_Flag & Flags) {
+        beginRecord (_Flag, _Framework, _ElementName, _Function);
+        Ring.value (_Message);
+        Ring.commit ();
+        return true;
+      } else {
+        return false;
+      }
+    }
+    /**
+     * @brief Generate a Debug-Output depends on the selected Falgs on init, with line break.
+     * "[JCA::IOT::]Object::Function - Message"
+     *
+     * @param _Flag Flag for Debug Message, only Output if Flag set on init
+     * @param _Framework use from Framework, add the Namespace tp Prefix
+     * @param _ElementName Name of the Object or Function-Group that calls the Function
+     * @param _Function Name of the Function
+     * @param _Message Message Text in Flash, only the Pointer is stored
+     * @return true Message was output to Debug-Interface
+     * @return false Message not output to Debug-Interface
+     */
+    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, const __FlashStringHelper *_Message) {
       if (print (_Flag, _Framework, _ElementName, _Function, _Message)) {
-        DebugSerial.println ();
+        Ring.endLine ();
         NewLine = true;
         return true;
       } else {
@@ -234,10 +374,11 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, double _Message) {
+    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, double _Message) {
       if (_Flag & Flags) {
-        DebugSerial.print (getPrefix (_Flag, _Framework, _ElementName, _Function));
-        DebugSerial.print (_Message);
+        beginRecord (_Flag, _Framework, _ElementName, _Function);
+        Ring.value (_Message);
+        Ring.commit ();
         return true;
       } else {
         return false;
@@ -255,9 +396,9 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, double _Message) {
+    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, double _Message) {
       if (print (_Flag, _Framework, _ElementName, _Function, _Message)) {
-        DebugSerial.println ();
+        Ring.endLine ();
         NewLine = true;
         return true;
       } else {
@@ -277,10 +418,11 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, unsigned long long _Message) {
+    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, unsigned long long _Message) {
       if (_Flag & Flags) {
-        DebugSerial.print (getPrefix (_Flag, _Framework, _ElementName, _Function));
-        DebugSerial.print (_Message);
+        beginRecord (_Flag, _Framework, _ElementName, _Function);
+        Ring.value (_Message);
+        Ring.commit ();
         return true;
       } else {
         return false;
@@ -298,9 +440,9 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, unsigned long long _Message) {
+    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, unsigned long long _Message) {
       if (print (_Flag, _Framework, _ElementName, _Function, _Message)) {
-        DebugSerial.println ();
+        Ring.endLine ();
         NewLine = true;
         return true;
       } else {
@@ -320,10 +462,11 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, long long _Message) {
+    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, long long _Message) {
       if (_Flag & Flags) {
-        DebugSerial.print (getPrefix (_Flag, _Framework, _ElementName, _Function));
-        DebugSerial.print (_Message);
+        beginRecord (_Flag, _Framework, _ElementName, _Function);
+        Ring.value (_Message);
+        Ring.commit ();
         return true;
       } else {
         return false;
@@ -341,9 +484,9 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, long long _Message) {
+    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, long long _Message) {
       if (print (_Flag, _Framework, _ElementName, _Function, _Message)) {
-        DebugSerial.println ();
+        Ring.endLine ();
         NewLine = true;
         return true;
       } else {
@@ -363,10 +506,11 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, unsigned long _Message) {
+    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, unsigned long _Message) {
       if (_Flag & Flags) {
-        DebugSerial.print (getPrefix (_Flag, _Framework, _ElementName, _Function));
-        DebugSerial.print (_Message);
+        beginRecord (_Flag, _Framework, _ElementName, _Function);
+        Ring.value ((unsigned long long)_Message);
+        Ring.commit ();
         return true;
       } else {
         return false;
@@ -384,9 +528,9 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, unsigned long _Message) {
+    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, unsigned long _Message) {
       if (print (_Flag, _Framework, _ElementName, _Function, _Message)) {
-        DebugSerial.println ();
+        Ring.endLine ();
         NewLine = true;
         return true;
       } else {
@@ -406,10 +550,11 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, long _Message) {
+    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, long _Message) {
       if (_Flag & Flags) {
-        DebugSerial.print (getPrefix (_Flag, _Framework, _ElementName, _Function));
-        DebugSerial.print (_Message);
+        beginRecord (_Flag, _Framework, _ElementName, _Function);
+        Ring.value ((long long)_Message);
+        Ring.commit ();
         return true;
       } else {
         return false;
@@ -427,9 +572,9 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, long _Message) {
+    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, long _Message) {
       if (print (_Flag, _Framework, _ElementName, _Function, _Message)) {
-        DebugSerial.println ();
+        Ring.endLine ();
         NewLine = true;
         return true;
       } else {
@@ -449,10 +594,11 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, unsigned int _Message) {
+    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, unsigned int _Message) {
       if (_Flag & Flags) {
-        DebugSerial.print (getPrefix (_Flag, _Framework, _ElementName, _Function));
-        DebugSerial.print (_Message);
+        beginRecord (_Flag, _Framework, _ElementName, _Function);
+        Ring.value ((unsigned long long)_Message);
+        Ring.commit ();
         return true;
       } else {
         return false;
@@ -470,9 +616,9 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, unsigned int _Message) {
+    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, unsigned int _Message) {
       if (print (_Flag, _Framework, _ElementName, _Function, _Message)) {
-        DebugSerial.println ();
+        Ring.endLine ();
         NewLine = true;
         return true;
       } else {
@@ -492,10 +638,11 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, int _Message) {
+    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, int _Message) {
       if (_Flag & Flags) {
-        DebugSerial.print (getPrefix (_Flag, _Framework, _ElementName, _Function));
-        DebugSerial.print (_Message);
+        beginRecord (_Flag, _Framework, _ElementName, _Function);
+        Ring.value ((long long)_Message);
+        Ring.commit ();
         return true;
       } else {
         return false;
@@ -513,9 +660,9 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, int _Message) {
+    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, int _Message) {
       if (print (_Flag, _Framework, _ElementName, _Function, _Message)) {
-        DebugSerial.println ();
+        Ring.endLine ();
         NewLine = true;
         return true;
       } else {
@@ -535,10 +682,11 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, unsigned char _Message) {
+    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, unsigned char _Message) {
       if (_Flag & Flags) {
-        DebugSerial.print (getPrefix (_Flag, _Framework, _ElementName, _Function));
-        DebugSerial.print (_Message);
+        beginRecord (_Flag, _Framework, _ElementName, _Function);
+        Ring.value ((unsigned long long)_Message);
+        Ring.commit ();
         return true;
       } else {
         return false;
@@ -556,9 +704,9 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, unsigned char _Message) {
+    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, unsigned char _Message) {
       if (print (_Flag, _Framework, _ElementName, _Function, _Message)) {
-        DebugSerial.println ();
+        Ring.endLine ();
         NewLine = true;
         return true;
       } else {
@@ -578,10 +726,11 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, char _Message) {
+    bool DebugOut::print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, char _Message) {
       if (_Flag & Flags) {
-        DebugSerial.print (getPrefix (_Flag, _Framework, _ElementName, _Function));
-        DebugSerial.print (_Message);
+        beginRecord (_Flag, _Framework, _ElementName, _Function);
+        Ring.print (_Message);
+        Ring.commit ();
         return true;
       } else {
         return false;
@@ -599,9 +748,9 @@ namespace JCA {
      * @return true Message was output to Debug-Interface
      * @return false Message not output to Debug-Interface
      */
-    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, char _Message) {
+    bool DebugOut::println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, char _Message) {
       if (print (_Flag, _Framework, _ElementName, _Function, _Message)) {
-        DebugSerial.println ();
+        Ring.endLine ();
         NewLine = true;
         return true;
       } else {
@@ -609,6 +758,318 @@ namespace JCA {
       }
     }
 
+    /**
+     * @brief Write the Name to the Debug-Interface
+     *
+     * @param _Target Debug-Interface
+     * @return size_t Number of written Bytes
+     */
+    size_t DebugName::printTo (Print &_Target) const {
+      if (Text == nullptr) {
+        return 0;
+      }
+      if (Flash) {
+        return _Target.print ((const __FlashStringHelper *)Text);
+      }
+      return _Target.print (Text);
+    }
+
+    /**
+     * @brief Construct a new DebugRing::DebugRing object
+     *
+     */
+    DebugRing::DebugRing () {
+      Head = 0;
+      Tail = 0;
+      Write = 0;
+      Last = 0;
+      LastValid = false;
+      Overflow = false;
+      Dropped = 0;
+    }
+
+    /**
+     * @brief Copy Data into the Ring-Buffer, with Wrap-Around
+     *
+     * @param _Pos Position (free running)
+     * @param _Data Data to copy
+     * @param _Length Number of Bytes
+     */
+    void DebugRing::copyIn (uint32_t _Pos, const void *_Data, size_t _Length) {
+      const uint8_t *Data = (const uint8_t *)_Data;
+      for (size_t i = 0; i < _Length; i++) {
+        Buffer[(_Pos + i) & (JCA_SYS_DebugOut_RINGSIZE - 1)] = Data[i];
+      }
+    }
+
+    /**
+     * @brief Copy Data out of the Ring-Buffer, with Wrap-Around
+     *
+     * @param _Pos Position (free running)
+     * @param _Data Buffer for the Data
+     * @param _Length Number of Bytes
+     */
+    void DebugRing::copyOut (uint32_t _Pos, void *_Data, size_t _Length) {
+      uint8_t *Data = (uint8_t *)_Data;
+      for (size_t i = 0; i < _Length; i++) {
+        Data[i] = Buffer[(_Pos + i) & (JCA_SYS_DebugOut_RINGSIZE - 1)];
+      }
+    }
+
+    /**
+     * @brief Open a new Record, the following write() calls add the Message
+     * The Name is copied, so it doesn't need to be valid until the Record is read
+     * @param _Flag Flag for Debug Message
+     * @param _Framework use from Framework, add the Namespace tp Prefix
+     * @param _ElementName Name of the Object or Function-Group that calls the Function
+     * @param _Function Name of the Function, has to be a String-Literal
+     * @param _Prefix Start of a Line, the Prefix is added
+     */
+    void DebugRing::begin (DEBUGOUT_FLAGS _Flag, bool _Framework, const DebugName &_ElementName, const char *_Function, bool _Prefix) {
+      Pending.Function = _Function;
+      Pending.Length = 0;
+      Pending.NameLength = 0;
+      Pending.Flag = (uint8_t)_Flag;
+      Pending.Options = (_Prefix ? RECORD_PREFIX : 0) | (_Framework ? RECORD_FRAMEWORK : 0);
+      Pending.Type = RECORD_TEXT;
+      Write = Head + sizeof (DebugRecord);
+      Overflow = Write - Tail > JCA_SYS_DebugOut_RINGSIZE;
+      if (_Prefix) {
+        _ElementName.printTo (*this);
+        Pending.NameLength = Pending.Length > UINT8_MAX ? UINT8_MAX : Pending.Length;
+        Pending.Length = Pending.NameLength;
+        Write = Head + sizeof (DebugRecord) + Pending.Length;
+      }
+    }
+
+    /**
+     * @brief Add a Char to the open Record
+     * If the Ring-Buffer is full, the Record is dropped on commit()
+     * @param _Char Char to add
+     * @return size_t 1 if the Char is stored
+     */
+    size_t DebugRing::write (uint8_t _Char) {
+      if (Overflow || Write - Tail >= JCA_SYS_DebugOut_RINGSIZE || Pending.Length == UINT16_MAX) {
+        Overflow = true;
+        return 0;
+      }
+      Buffer[Write & (JCA_SYS_DebugOut_RINGSIZE - 1)] = _Char;
+      Write++;
+      Pending.Length++;
+      return 1;
+    }
+
+    /**
+     * @brief Store a Value binary in the open Record, it is formatted when the Record is read
+     *
+     * @param _Type DEBUGRECORD_TYPES of the Value
+     * @param _Data Value
+     * @param _Length Size of the Value
+     */
+    void DebugRing::writeValue (uint8_t _Type, const void *_Data, size_t _Length) {
+      const uint8_t *Data = (const uint8_t *)_Data;
+      for (size_t i = 0; i < _Length; i++) {
+        write (Data[i]);
+      }
+      Pending.Type = _Type;
+    }
+
+    void DebugRing::value (long long _Value) {
+      int64_t Value = _Value;
+      writeValue (RECORD_SIGNED, &Value, sizeof (Value));
+    }
+
+    void DebugRing::value (unsigned long long _Value) {
+      uint64_t Value = _Value;
+      writeValue (RECORD_UNSIGNED, &Value, sizeof (Value));
+    }
+
+    void DebugRing::value (double _Value) {
+      writeValue (RECORD_FLOAT, &_Value, sizeof (_Value));
+    }
+
+    void DebugRing::value (const __FlashStringHelper *_Value) {
+      writeValue (RECORD_FLASH, &_Value, sizeof (_Value));
+    }
+
+    /**
+     * @brief Close the open Record, it can be read after that
+     * A Record that didn't fit is dropped and counted
+     */
+    void DebugRing::commit () {
+      if (Overflow) {
+        Overflow = false;
+        LastValid = false;
+        Dropped++;
+        return;
+      }
+      copyIn (Head, &Pending, sizeof (DebugRecord));
+      Last = Head;
+      LastValid = true;
+      Head = Write;
+    }
+
+    /**
+     * @brief Mark the End of a Line
+     * Sets the Option of the last Record if it's not read yet, else an empty Record is added
+     */
+    void DebugRing::endLine () {
+      if (LastValid) {
+        DebugRecord Record;
+        copyOut (Last, &Record, sizeof (DebugRecord));
+        Record.Options |= RECORD_NEWLINE;
+        copyIn (Last, &Record, sizeof (DebugRecord));
+        return;
+      }
+      Pending.Function = nullptr;
+      Pending.Length = 0;
+      Pending.NameLength = 0;
+      Pending.Flag = FLAG_NONE;
+      Pending.Options = RECORD_NEWLINE;
+      Pending.Type = RECORD_TEXT;
+      Write = Head + sizeof (DebugRecord);
+      Overflow = Write - Tail > JCA_SYS_DebugOut_RINGSIZE;
+      commit ();
+    }
+
+    /**
+     * @brief Read the Header of the next Record
+     * Name and Message have to be read with readText() afterwards
+     * @param _Record Header of the Record
+     * @return true Record available
+     * @return false Ring-Buffer is empty
+     */
+    bool DebugRing::read (DebugRecord &_Record) {
+      if (Tail == Head) {
+        return false;
+      }
+      copyOut (Tail, &_Record, sizeof (DebugRecord));
+      if (LastValid && Last == Tail) {
+        LastValid = false;
+      }
+      Tail += sizeof (DebugRecord);
+      return true;
+    }
+
+    /**
+     * @brief Read Text of the current Record
+     *
+     * @param _Target Output for the Text
+     * @param _Length Number of Bytes
+     * @return size_t Number of read Bytes
+     */
+    size_t DebugRing::readText (Print &_Target, size_t _Length) {
+      for (size_t i = 0; i < _Length; i++) {
+        _Target.write (Buffer[Tail & (JCA_SYS_DebugOut_RINGSIZE - 1)]);
+        Tail++;
+      }
+      return _Length;
+    }
+
+    /**
+     * @brief Read a binary Value of the current Record and print it
+     *
+     * @param _Target Output for the Value
+     * @param _Type DEBUGRECORD_TYPES of the Value
+     * @param _Length Size of the Value
+     * @return size_t Number of read Bytes
+     */
+    size_t DebugRing::readValue (Print &_Target, uint8_t _Type, size_t _Length) {
+      union {
+        int64_t Signed;
+        uint64_t Unsigned;
+        double Float;
+        const __FlashStringHelper *Flash;
+      } Value;
+      if (_Length > sizeof (Value)) {
+        Tail += _Length;
+        return _Length;
+      }
+      copyOut (Tail, &Value, _Length);
+      Tail += _Length;
+      switch (_Type) {
+      case RECORD_SIGNED:
+        _Target.print ((long long)Value.Signed);
+        break;
+      case RECORD_UNSIGNED:
+        _Target.print ((unsigned long long)Value.Unsigned);
+        break;
+      case RECORD_FLOAT:
+        _Target.print (Value.Float);
+        break;
+      case RECORD_FLASH:
+        _Target.print (Value.Flash);
+        break;
+      }
+      return _Length;
+    }
+
+    /**
+     * @brief Bytes of the committed Records
+     *
+     * @return size_t Number of Bytes
+     */
+    size_t DebugRing::length () {
+      return Head - Tail;
+    }
+
+    uint32_t DebugRing::dropped () {
+      return Dropped;
+    }
+
+    /**
+     * @brief Construct a new DebugLine::DebugLine object
+     *
+     */
+    DebugLine::DebugLine () {
+      Length = 0;
+      Sent = 0;
+    }
+
+    /**
+     * @brief Add a Char to the Line, cut if the Line is full
+     *
+     * @param _Char Char to add
+     * @return size_t 1 if the Char is stored
+     */
+    size_t DebugLine::write (uint8_t _Char) {
+      if (Length >= JCA_SYS_DebugOut_LINESIZE) {
+        return 0;
+      }
+      Buffer[Length++] = _Char;
+      return 1;
+    }
+
+    void DebugLine::clear () {
+      Length = 0;
+      Sent = 0;
+    }
+
+    /**
+     * @brief Write the Rest of the Line to the Serial interface
+     *
+     * @param _Serial Debug-Interface
+     * @param _Block Wait for the UART, else only fill the free Space of the FIFO
+     * @return true whole Line is sent
+     * @return false UART is busy, call again later
+     */
+    bool DebugLine::send (HardwareSerial &_Serial, bool _Block) {
+      if (Sent < Length) {
+        size_t Count = Length - Sent;
+        if (!_Block) {
+          int Free = _Serial.availableForWrite ();
+          if (Free <= 0) {
+            return false;
+          }
+          if ((size_t)Free < Count) {
+            Count = Free;
+          }
+        }
+        Sent += _Serial.write (Buffer + Sent, Count);
+      }
+      return Sent >= Length;
+    }
+
     DebugOut Debug (Serial);
   }
 }
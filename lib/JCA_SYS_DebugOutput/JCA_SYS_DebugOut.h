@@ -4,6 +4,9 @@
  * @brief The DebugOut Class is used to handle Debug-Prints,
  * Serial prints for the selected Debug-Level.
  * It's declerated as `extern DebugOut Debug(Serial)` to use in all other Parts of the JCA::IOT Namespace
+ * The Messages are stored as Records in a Ring-Buffer and written to the Serial interface by handle(),
+ * only as much as the UART-FIFO takes without blocking.
+ * Numbers and Flash-Strings are stored binary, so they are formatted in handle() and not by the Caller.
  * @version 0.1
  * @date 2022-09-04
  *
@@ -20,6 +23,38 @@
  * Default Baud rate if not defined on init.
  */
 #define JCA_SYS_DebugOut_DEFAULT_BAUD 74880
+/**
+ * @brief
+ * Size of the Ring-Buffer for the Records, must be a power of two.
+ * A Message that doesn't fit is dropped and counted.
+ */
+#define JCA_SYS_DebugOut_RINGSIZE 1024
+/**
+ * @brief
+ * Maximum Length of one Output-Line (Prefix and Message), longer Lines are cut.
+ */
+#define JCA_SYS_DebugOut_LINESIZE 160
+/**
+ * @brief
+ * Maximum Time the Output is held (ms), then the UART-FIFO is filled once and the Output is held again.
+ */
+#define JCA_SYS_DebugOut_MAXHOLD 2000
+/**
+ * @brief
+ * Flags compiled into the Firmware, like -D JCA_SYS_DebugOut_LEVEL=0x1 in the build_flags for Errors only.
+ * Messages of other Flags are removed by the Compiler, if they are written with JCA_DEBUG_PRINT/JCA_DEBUG_PRINTLN.
+ */
+#ifndef JCA_SYS_DebugOut_LEVEL
+#define JCA_SYS_DebugOut_LEVEL 0xFFFF
+#endif
+/**
+ * @brief
+ * Write a Debug-Message, returns true if it was output like DebugOut::print/println.
+ * The Arguments are only evaluated if the Flag is compiled in and selected on init,
+ * so a disabled Message costs one Branch and no String-Formatting.
+ */
+#define JCA_DEBUG_PRINT(_Flag, ...) (((_Flag) & JCA_SYS_DebugOut_LEVEL) && JCA::SYS::Debug.enabled (_Flag) && JCA::SYS::Debug.print ((_Flag), __VA_ARGS__))
+#define JCA_DEBUG_PRINTLN(_Flag, ...) (((_Flag) & JCA_SYS_DebugOut_LEVEL) && JCA::SYS::Debug.enabled (_Flag) && JCA::SYS::Debug.println ((_Flag), __VA_ARGS__))
 
 namespace JCA {
   namespace SYS {
@@ -36,6 +71,115 @@ namespace JCA {
       FLAG_LOOP = 0x10,    ///< Loop Informations, like readen Values or Counter (not recomended)
       FLAG_PROTOCOL = 0x20 ///< Loop Informations, like readen Values or Counter (not recomended)
     };
+    /**
+     * @brief
+     * Name of the calling Element, only the Pointer is passed so no String is copied.
+     * Created implicitly from C-Strings, Strings and Flash-Strings (F("...")).
+     */
+    class DebugName {
+    private:
+      const char *Text;
+      bool Flash;
+
+    public:
+      DebugName (const char *_Name) : Text (_Name), Flash (false) {}
+      DebugName (const String &_Name) : Text (_Name.c_str ()), Flash (false) {}
+      DebugName (const __FlashStringHelper *_Name) : Text ((const char *)_Name), Flash (true) {}
+      size_t printTo (Print &_Target) const;
+    };
+
+    /**
+     * @brief
+     * Options of a Debug-Record
+     */
+    enum DEBUGRECORD_OPTIONS : uint8_t {
+      RECORD_PREFIX = 0x1,    ///< Start of a Line, the Name follows the Record
+      RECORD_FRAMEWORK = 0x2, ///< add the Namespace to the Prefix
+      RECORD_NEWLINE = 0x4    ///< End of a Line
+    };
+
+    /**
+     * @brief
+     * Type of the Message inside a Debug-Record, Values are stored binary and formatted by DebugOut::handle()
+     */
+    enum DEBUGRECORD_TYPES : uint8_t {
+      RECORD_TEXT,     ///< Text, copied Char by Char
+      RECORD_SIGNED,   ///< int64_t
+      RECORD_UNSIGNED, ///< uint64_t
+      RECORD_FLOAT,    ///< double, printed with 2 Decimals
+      RECORD_FLASH     ///< Pointer to a Flash-String (F("..."))
+    };
+
+    /**
+     * @brief
+     * Header of one Message inside the Ring-Buffer, followed by the Element-Name and the Message (Text or Value).
+     * The Function-Name is stored as Pointer, it's always a String-Literal (__func__).
+     */
+    struct DebugRecord {
+      const char *Function; ///< Name of the Function
+      uint16_t Length;      ///< Bytes of Name and Message
+      uint8_t NameLength;   ///< Bytes of the Name, 0 without Prefix
+      uint8_t Flag;         ///< DEBUGOUT_FLAGS of the Message
+      uint8_t Options;      ///< DEBUGRECORD_OPTIONS
+      uint8_t Type;         ///< DEBUGRECORD_TYPES of the Message
+    };
+
+    /**
+     * @brief
+     * Ring-Buffer of Debug-Records, written by the Messages and read by DebugOut::handle()
+     */
+    class DebugRing : public Print {
+    private:
+      uint8_t Buffer[JCA_SYS_DebugOut_RINGSIZE];
+      uint32_t Head;       ///< End of the committed Records
+      uint32_t Tail;       ///< Start of the next Record to read
+      uint32_t Write;      ///< Write-Position inside the open Record
+      uint32_t Last;       ///< Start of the last committed Record
+      bool LastValid;      ///< Last Record is committed and not read yet
+      bool Overflow;       ///< open Record doesn't fit
+      DebugRecord Pending; ///< Header of the open Record
+      uint32_t Dropped;
+
+      void copyIn (uint32_t _Pos, const void *_Data, size_t _Length);
+      void copyOut (uint32_t _Pos, void *_Data, size_t _Length);
+      void writeValue (uint8_t _Type, const void *_Data, size_t _Length);
+
+    public:
+      DebugRing ();
+      void begin (DEBUGOUT_FLAGS _Flag, bool _Framework, const DebugName &_ElementName, const char *_Function, bool _Prefix);
+      size_t write (uint8_t _Char);
+      using Print::write;
+      void value (long long _Value);
+      void value (unsigned long long _Value);
+      void value (double _Value);
+      void value (const __FlashStringHelper *_Value);
+      void commit ();
+      void endLine ();
+      bool read (DebugRecord &_Record);
+      size_t readText (Print &_Target, size_t _Length);
+      size_t readValue (Print &_Target, uint8_t _Type, size_t _Length);
+      size_t length ();
+      uint32_t dropped ();
+    };
+
+    /**
+     * @brief
+     * Fixed Buffer for the Line that is written to the Serial interface
+     */
+    class DebugLine : public Print {
+    private:
+      uint8_t Buffer[JCA_SYS_DebugOut_LINESIZE];
+      size_t Length;
+      size_t Sent;
+
+    public:
+      DebugLine ();
+      size_t write (uint8_t _Char);
+      using Print::write;
+      void clear ();
+      bool send (HardwareSerial &_Serial, bool _Block);
+    };
+
     /**
      * @brief 
      * Generate and output Debug-Messages to Serial interface
@@ -46,7 +190,12 @@ namespace JCA {
       uint16_t Flags;
       HardwareSerial DebugSerial;
       bool NewLine;
-      String getPrefix (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function);
+      DebugRing Ring;
+      DebugLine Line;
+      bool Holding;
+      uint32_t LastDrain;
+      void beginRecord (DEBUGOUT_FLAGS _Flag, bool _Framework, const DebugName &_ElementName, const char *_Function);
+      bool drain (bool _Block);
 
     public:
       DebugOut (const HardwareSerial &_Serial);
@@ -54,31 +203,41 @@ namespace JCA {
 
       void init (uint16_t _Flags, unsigned long _Baud);
       void init (uint16_t _Flags);
+      void hold (bool _Hold);
+      void handle ();
+      void flush ();
+      size_t pending ();
+      uint32_t dropped ();
+      bool enabled (DEBUGOUT_FLAGS _Flag) const {
+        return (_Flag & Flags) != 0;
+      }
 
-      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, const Printable &_Message);
-      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, const Printable &_Message);
-      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, const String &_Message);
-      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, const String &_Message);
-      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, const char *_Message);
-      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, const char *_Message);
-      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, double _Message);
-      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, double _Message);
-      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, unsigned long long _Message);
-      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, unsigned long long _Message);
-      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, long long _Message);
-      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, long long _Message);
-      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, unsigned long _Message);
-      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, unsigned long _Message);
-      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, long _Message);
-      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, long _Message);
-      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, unsigned int _Message);
-      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, unsigned int _Message);
-      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, int _Message);
-      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, int _Message);
-      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, unsigned char _Message);
-      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, unsigned char _Message);
-      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, char _Message);
-      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, char _Message);
+      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, const Printable &_Message);
+      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, const Printable &_Message);
+      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, const String &_Message);
+      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, const String &_Message);
+      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, const char *_Message);
+      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, const char *_Message);
+      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, const __FlashStringHelper *_Message);
+      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, const __FlashStringHelper *_Message);
+      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, double _Message);
+      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, double _Message);
+      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, unsigned long long _Message);
+      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, unsigned long long _Message);
+      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, long long _Message);
+      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, long long _Message);
+      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, unsigned long _Message);
+      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, unsigned long _Message);
+      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, long _Message);
+      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, long _Message);
+      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, unsigned int _Message);
+      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, unsigned int _Message);
+      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, int _Message);
+      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, int _Message);
+      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, unsigned char _Message);
+      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, unsigned char _Message);
+      bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, char _Message);
+      bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, DebugName _ElementName, const char *_Function, char _Message);
     };
 
     extern DebugOut Debug;
@@ -0,0 +1,156 @@
+/**
+ * @file JCA_SYS_Histogram.cpp
+ * @author JCA (https://github.com/ichok)
+ * @brief Histogram with fixed Bucket-Bounds for Timing-Statistics
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Copyright Jochen Cabrera 2022
+ * Apache License
+ *
+ */
+
+#include <JCA_SYS_Histogram.h>
+
+namespace JCA {
+  namespace SYS {
+    /**
+     * @brief Construct a new Histogram::Histogram object
+     *
+     * @param _Bounds Upper Bound of each Bucket (ascending), the Table must exist as long as the Histogram
+     * @param _BoundCount Number of Bounds, limited to JCA_SYS_HISTOGRAM_MAXBOUNDS
+     */
+    Histogram::Histogram (const uint32_t *_Bounds, uint8_t _BoundCount) {
+      setBounds (_Bounds, _BoundCount);
+    }
+
+    /**
+     * @brief Set the Bucket-Bounds, used for Arrays of Histograms
+     * All Buckets are cleared
+     * @param _Bounds Upper Bound of each Bucket (ascending), the Table must exist as long as the Histogram
+     * @param _BoundCount Number of Bounds, limited to JCA_SYS_HISTOGRAM_MAXBOUNDS
+     */
+    void Histogram::setBounds (const uint32_t *_Bounds, uint8_t _BoundCount) {
+      Bounds = _Bounds;
+      BoundCount = _Bounds == nullptr ? 0 : (_BoundCount < JCA_SYS_HISTOGRAM_MAXBOUNDS ? _BoundCount : JCA_SYS_HISTOGRAM_MAXBOUNDS);
+      reset ();
+    }
+
+    /**
+     * @brief Count a Value in its Bucket
+     * The Bucket of a Value is the first with Value <= Bound.
+     * Placed in IRAM, so it can be called from an Interrupt-Routine
+     * @param _Value Value to add
+     */
+    void IRAM_ATTR Histogram::add (uint32_t _Value) {
+      uint8_t Index = 0;
+      while (Index < BoundCount && _Value > Bounds[Index]) {
+        Index++;
+      }
+      Buckets[Index]++;
+      Count++;
+      Sum += _Value;
+      if (_Value < Min) {
+        Min = _Value;
+      }
+      if (_Value > Max) {
+        Max = _Value;
+      }
+    }
+
+    /**
+     * @brief Clear all Buckets and Statistics
+     */
+    void Histogram::reset () {
+      memset (Buckets, 0, sizeof (Buckets));
+      Count = 0;
+      Sum = 0;
+      Min = UINT32_MAX;
+      Max = 0;
+    }
+
+    /**
+     * @brief Number of Buckets, including the Bucket above the last Bound
+     *
+     * @return uint8_t Number of Buckets
+     */
+    uint8_t Histogram::size () {
+      return BoundCount + 1;
+    }
+
+    /**
+     * @brief Upper Bound of a Bucket
+     *
+     * @param _Index Index of the Bucket
+     * @return uint32_t Bound, UINT32_MAX for the last Bucket
+     */
+    uint32_t Histogram::bound (uint8_t _Index) {
+      return _Index < BoundCount ? Bounds[_Index] : UINT32_MAX;
+    }
+
+    /**
+     * @brief Values counted in a Bucket (not cumulative)
+     *
+     * @param _Index Index of the Bucket
+     * @return uint32_t Number of Values
+     */
+    uint32_t Histogram::bucket (uint8_t _Index) {
+      return _Index <= BoundCount ? Buckets[_Index] : 0;
+    }
+
+    uint32_t Histogram::count () {
+      return Count;
+    }
+
+    uint64_t Histogram::sum () {
+      return Sum;
+    }
+
+    /**
+     * @brief Smallest Value
+     *
+     * @return uint32_t Value, 0 if nothing counted
+     */
+    uint32_t Histogram::min () {
+      return Count > 0 ? Min : 0;
+    }
+
+    uint32_t Histogram::max () {
+      return Max;
+    }
+
+    /**
+     * @brief Mean of all Values
+     *
+     * @return uint32_t Mean, 0 if nothing counted
+     */
+    uint32_t Histogram::mean () {
+      return Count > 0 ? (uint32_t)(Sum / Count) : 0;
+    }
+
+    /**
+     * @brief Create the Text of the Histogram
+     * Only used Buckets are listed as "<Upper Bound>:<Count>", the last Bucket is "inf"
+     * @param _Buffer Buffer for the Text
+     * @param _Size Size of the Buffer
+     * @return size_t Length of the Text
+     */
+    size_t Histogram::printBuckets (char *_Buffer, size_t _Size) {
+      size_t Length = 0;
+      _Buffer[0] = '\0';
+      for (uint8_t i = 0; i < size () && Length < _Size; i++) {
+        uint32_t Count = Buckets[i];
+        if (Count == 0) {
+          continue;
+        }
+        const char *Separator = Length > 0 ? "," : "";
+        if (i < BoundCount) {
+          Length += snprintf (_Buffer + Length, _Size - Length, "%s%lu:%lu", Separator, (unsigned long)Bounds[i], (unsigned long)Count);
+        } else {
+          Length += snprintf (_Buffer + Length, _Size - Length, "%sinf:%lu", Separator, (unsigned long)Count);
+        }
+      }
+      return Length < _Size ? Length : _Size - 1;
+    }
+  }
+}
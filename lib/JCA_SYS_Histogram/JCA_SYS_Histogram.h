@@ -0,0 +1,57 @@
+/**
+ * @file JCA_SYS_Histogram.h
+ * @author JCA (https://github.com/ichok)
+ * @brief Histogram with fixed Bucket-Bounds for Timing-Statistics
+ * The Bounds are a constant Table of the User (upper Bound of each Bucket, ascending),
+ * Values above the last Bound are counted in an additional Bucket.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Copyright Jochen Cabrera 2022
+ * Apache License
+ *
+ */
+
+#ifndef _JCA_SYS_HISTOGRAM_
+#define _JCA_SYS_HISTOGRAM_
+#include <Arduino.h>
+
+// Maximum Number of Bounds, one more Bucket for Values above the last Bound
+#define JCA_SYS_HISTOGRAM_MAXBOUNDS 24
+
+namespace JCA {
+  namespace SYS {
+    /**
+     * @brief
+     * Count Values in Buckets and keep Count, Sum, Min and Max
+     */
+    class Histogram {
+    private:
+      const uint32_t *Bounds;
+      uint8_t BoundCount;
+      uint32_t Buckets[JCA_SYS_HISTOGRAM_MAXBOUNDS + 1];
+      uint32_t Count;
+      uint64_t Sum;
+      uint32_t Min;
+      uint32_t Max;
+
+    public:
+      Histogram (const uint32_t *_Bounds = nullptr, uint8_t _BoundCount = 0);
+      void setBounds (const uint32_t *_Bounds, uint8_t _BoundCount);
+      void add (uint32_t _Value);
+      void reset ();
+
+      uint8_t size ();
+      uint32_t bound (uint8_t _Index);
+      uint32_t bucket (uint8_t _Index);
+      uint32_t count ();
+      uint64_t sum ();
+      uint32_t min ();
+      uint32_t max ();
+      uint32_t mean ();
+      size_t printBuckets (char *_Buffer, size_t _Size);
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,155 @@
+/**
+ * @file JCA_SYS_JsonPool.cpp
+ * @author JCA (https://github.com/ichok)
+ * @brief Fixed Pool of reusable JSON-Documents
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Copyright Jochen Cabrera 2022
+ * Apache License
+ *
+ */
+
+#include <JCA_SYS_JsonPool.h>
+
+namespace JCA {
+  namespace SYS {
+    /**
+     * @brief Construct a new JsonPool::JsonPool object
+     * The Documents are allocated on begin()
+     * @param _Count Number of Documents, limited to JCA_SYS_JSONPOOL_MAXDOCS
+     * @param _Capacity Capacity of every Document in Bytes
+     */
+    JsonPool::JsonPool (uint8_t _Count, size_t _Capacity) {
+      Count = _Count < JCA_SYS_JSONPOOL_MAXDOCS ? _Count : JCA_SYS_JSONPOOL_MAXDOCS;
+      Size = 0;
+      Capacity = _Capacity;
+      InUse = 0;
+      Used = 0;
+      MaxUsed = 0;
+      MaxMemory = 0;
+      Exhausted = 0;
+    }
+
+    /**
+     * @brief Destroy the JsonPool::JsonPool object
+     */
+    JsonPool::~JsonPool () {
+      for (uint8_t i = 0; i < Size; i++) {
+        delete Docs[i];
+      }
+    }
+
+    /**
+     * @brief Allocate the Documents
+     * Stops on the first Document that can't get its Memory
+     * @return uint8_t Number of allocated Documents
+     */
+    uint8_t JsonPool::begin () {
+      while (Size < Count) {
+        DynamicJsonDocument *Doc = new DynamicJsonDocument (Capacity);
+        if (Doc->capacity () == 0) {
+          delete Doc;
+          break;
+        }
+        Docs[Size++] = Doc;
+      }
+      return Size;
+    }
+
+    /**
+     * @brief Check out a free Document
+     * The Document is empty, it has to be given back with give()
+     * @return JsonDocument* Document, nullptr if all Documents are in use
+     */
+    JsonDocument *JsonPool::take () {
+      for (uint8_t i = 0; i < Size; i++) {
+        uint8_t Mask = 1 << i;
+        if ((InUse & Mask) == 0) {
+          InUse |= Mask;
+          Used++;
+          if (Used > MaxUsed) {
+            MaxUsed = Used;
+          }
+          Docs[i]->clear ();
+          return Docs[i];
+        }
+      }
+      Exhausted++;
+      return nullptr;
+    }
+
+    /**
+     * @brief Give a Document back to the Pool
+     *
+     * @param _Doc Document from take(), nullptr is ignored
+     */
+    void JsonPool::give (JsonDocument *_Doc) {
+      for (uint8_t i = 0; i < Size; i++) {
+        uint8_t Mask = 1 << i;
+        if (Docs[i] == _Doc && (InUse & Mask) != 0) {
+          if (_Doc->memoryUsage () > MaxMemory) {
+            MaxMemory = _Doc->memoryUsage ();
+          }
+          InUse &= ~Mask;
+          Used--;
+          return;
+        }
+      }
+    }
+
+    /**
+     * @brief Number of allocated Documents
+     *
+     * @return uint8_t Documents
+     */
+    uint8_t JsonPool::size () {
+      return Size;
+    }
+
+    /**
+     * @brief Number of checked out Documents
+     *
+     * @return uint8_t Documents
+     */
+    uint8_t JsonPool::used () {
+      return Used;
+    }
+
+    /**
+     * @brief Maximum Number of checked out Documents at the same Time
+     *
+     * @return uint8_t Documents
+     */
+    uint8_t JsonPool::maxUsed () {
+      return MaxUsed;
+    }
+
+    /**
+     * @brief Capacity of every Document
+     *
+     * @return size_t Bytes
+     */
+    size_t JsonPool::capacity () {
+      return Capacity;
+    }
+
+    /**
+     * @brief Maximum Memory-Usage of a Document
+     *
+     * @return size_t Bytes
+     */
+    size_t JsonPool::maxMemory () {
+      return MaxMemory;
+    }
+
+    /**
+     * @brief Number of Requests without a free Document
+     *
+     * @return uint32_t Rejected Requests
+     */
+    uint32_t JsonPool::exhausted () {
+      return Exhausted;
+    }
+  }
+}
@@ -0,0 +1,88 @@
+/**
+ * @file JCA_SYS_JsonPool.h
+ * @author JCA (https://github.com/ichok)
+ * @brief Fixed Pool of reusable JSON-Documents
+ * The Documents are allocated once on begin() and checked out per Request,
+ * so the Heap is not fragmented by a new Document for every Message.
+ * If all Documents are in use the Request has to be rejected.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Copyright Jochen Cabrera 2022
+ * Apache License
+ *
+ */
+
+#ifndef _JCA_SYS_JSONPOOL_
+#define _JCA_SYS_JSONPOOL_
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// Maximum Number of Documents inside one Pool
+#define JCA_SYS_JSONPOOL_MAXDOCS 8
+
+namespace JCA {
+  namespace SYS {
+    /**
+     * @brief
+     * Pool of preallocated Documents with Usage-Statistics
+     */
+    class JsonPool {
+    private:
+      JsonDocument *Docs[JCA_SYS_JSONPOOL_MAXDOCS];
+      uint8_t Count;
+      uint8_t Size;
+      size_t Capacity;
+      uint8_t InUse;     ///< Bit n = Document n is checked out
+      uint8_t Used;
+      uint8_t MaxUsed;   ///< High-Water-Mark of checked out Documents
+      size_t MaxMemory;  ///< High-Water-Mark of the Memory-Usage of a Document
+      uint32_t Exhausted;
+
+    public:
+      JsonPool (uint8_t _Count, size_t _Capacity);
+      ~JsonPool ();
+      uint8_t begin ();
+
+      JsonDocument *take ();
+      void give (JsonDocument *_Doc);
+
+      uint8_t size ();
+      uint8_t used ();
+      uint8_t maxUsed ();
+      size_t capacity ();
+      size_t maxMemory ();
+      uint32_t exhausted ();
+    };
+
+    /**
+     * @brief
+     * Checked out Document, given back to the Pool when leaving the Scope
+     */
+    class JsonPoolDoc {
+    private:
+      JsonPool &Pool;
+      JsonDocument *Doc;
+
+    public:
+      JsonPoolDoc (JsonPool &_Pool) : Pool (_Pool), Doc (_Pool.take ()) {}
+      ~JsonPoolDoc () {
+        Pool.give (Doc);
+      }
+      JsonPoolDoc (const JsonPoolDoc &) = delete;
+      JsonPoolDoc &operator= (const JsonPoolDoc &) = delete;
+
+      explicit operator bool () const {
+        return Doc != nullptr;
+      }
+      JsonDocument &operator* () const {
+        return *Doc;
+      }
+      JsonDocument *operator-> () const {
+        return Doc;
+      }
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,244 @@
+/**
+ * @file JCA_SYS_JsonStream.cpp
+ * @author JCA (https://github.com/ichok)
+ * @brief Streaming JSON-Writer without Heap-Allocations
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Copyright Jochen Cabrera 2022
+ * Apache License
+ *
+ */
+
+#include <JCA_SYS_JsonStream.h>
+
+namespace JCA {
+  namespace SYS {
+    /**
+     * @brief Construct a new JsonStream::JsonStream object
+     *
+     * @param _Target Output for the JSON-Text, like a File
+     */
+    JsonStream::JsonStream (Print &_Target) : Target (_Target) {
+      Length = 0;
+      Written = 0;
+      HasEntry = 0;
+      Depth = 0;
+    }
+
+    /**
+     * @brief Destroy the JsonStream::JsonStream object
+     * Remaining Data is written to the Target
+     */
+    JsonStream::~JsonStream () {
+      flush ();
+    }
+
+    /**
+     * @brief Add a single Char to the Buffer
+     * If the Buffer is full, it is written to the Target first
+     * @param _Char Char to add
+     */
+    void JsonStream::write (char _Char) {
+      if (Length >= JCA_SYS_JSONSTREAM_BUFFERSIZE) {
+        flush ();
+      }
+      Buffer[Length++] = _Char;
+    }
+
+    /**
+     * @brief Add a Text without escaping
+     *
+     * @param _Text Text to add
+     */
+    void JsonStream::write (const char *_Text) {
+      while (*_Text != '\0') {
+        write (*_Text++);
+      }
+    }
+
+    /**
+     * @brief Add a Text as JSON-String
+     * Quotes, Backslashes and Control-Chars are escaped, UTF-8 is passed unchanged
+     * @param _Text Text to add, nullptr is written as null
+     */
+    void JsonStream::writeEscaped (const char *_Text) {
+      static const char *HexChars = "0123456789abcdef";
+      if (_Text == nullptr) {
+        write ("null");
+        return;
+      }
+      write ('"');
+      for (; *_Text != '\0'; _Text++) {
+        char Char = *_Text;
+        switch (Char) {
+        case '"':
+          write ("\\\"");
+          break;
+        case '\\':
+          write ("\\\\");
+          break;
+        case '\n':
+          write ("\\n");
+          break;
+        case '\r':
+          write ("\\r");
+          break;
+        case '\t':
+          write ("\\t");
+          break;
+        default:
+          if ((uint8_t)Char < 0x20) {
+            write ("\\u00");
+            write (HexChars[(uint8_t)Char >> 4]);
+            write (HexChars[(uint8_t)Char & 0x0F]);
+          } else {
+            write (Char);
+          }
+        }
+      }
+      write ('"');
+    }
+
+    /**
+     * @brief Start a new Entry in the current Level
+     * Adds the Comma if needed and the Key inside an Object
+     * @param _Key Key of the Entry, nullptr inside Arrays
+     */
+    void JsonStream::writeKey (const char *_Key) {
+      if (Depth > 0 && Depth <= JCA_SYS_JSONSTREAM_MAXDEPTH) {
+        uint32_t Mask = 1UL << (Depth - 1);
+        if (HasEntry & Mask) {
+          write (',');
+        }
+        HasEntry |= Mask;
+      }
+      if (_Key != nullptr) {
+        writeEscaped (_Key);
+        write (':');
+      }
+    }
+
+    /**
+     * @brief Open an Object or Array
+     *
+     * @param _Key Key inside an Object, nullptr inside Arrays or on Top-Level
+     * @param _Bracket Opening Bracket
+     */
+    void JsonStream::open (const char *_Key, char _Bracket) {
+      writeKey (_Key);
+      write (_Bracket);
+      Depth++;
+      if (Depth <= JCA_SYS_JSONSTREAM_MAXDEPTH) {
+        HasEntry &= ~(1UL << (Depth - 1));
+      }
+    }
+
+    /**
+     * @brief Close an Object or Array
+     *
+     * @param _Bracket Closing Bracket
+     */
+    void JsonStream::close (char _Bracket) {
+      if (Depth > 0) {
+        Depth--;
+      }
+      write (_Bracket);
+    }
+
+    void JsonStream::beginObject (const char *_Key) {
+      open (_Key, '{');
+    }
+
+    void JsonStream::endObject () {
+      close ('}');
+    }
+
+    void JsonStream::beginArray (const char *_Key) {
+      open (_Key, '[');
+    }
+
+    void JsonStream::endArray () {
+      close (']');
+    }
+
+    /**
+     * @brief Add a String-Value
+     *
+     * @param _Key Key inside an Object, nullptr inside Arrays
+     * @param _Value Text, nullptr is written as null
+     */
+    void JsonStream::add (const char *_Key, const char *_Value) {
+      writeKey (_Key);
+      writeEscaped (_Value);
+    }
+
+    void JsonStream::add (const char *_Key, const String &_Value) {
+      add (_Key, _Value.c_str ());
+    }
+
+    void JsonStream::add (const char *_Key, bool _Value) {
+      writeKey (_Key);
+      write (_Value ? "true" : "false");
+    }
+
+    void JsonStream::add (const char *_Key, int _Value) {
+      add (_Key, (long)_Value);
+    }
+
+    void JsonStream::add (const char *_Key, unsigned int _Value) {
+      add (_Key, (unsigned long)_Value);
+    }
+
+    void JsonStream::add (const char *_Key, long _Value) {
+      char Number[12];
+      snprintf (Number, sizeof (Number), "%ld", _Value);
+      writeKey (_Key);
+      write (Number);
+    }
+
+    void JsonStream::add (const char *_Key, unsigned long _Value) {
+      char Number[12];
+      snprintf (Number, sizeof (Number), "%lu", _Value);
+      writeKey (_Key);
+      write (Number);
+    }
+
+    /**
+     * @brief Add a Number with JCA_SYS_JSONSTREAM_DECIMALS Decimals
+     * NaN and Infinity are not valid in JSON and written as null
+     * @param _Key Key inside an Object, nullptr inside Arrays
+     * @param _Value Value to add
+     */
+    void JsonStream::add (const char *_Key, double _Value) {
+      char Number[24];
+      writeKey (_Key);
+      if (isnan (_Value) || isinf (_Value) || _Value > 1e15 || _Value < -1e15) {
+        write ("null");
+        return;
+      }
+      dtostrf (_Value, 1, JCA_SYS_JSONSTREAM_DECIMALS, Number);
+      write (Number);
+    }
+
+    /**
+     * @brief Write the Buffer to the Target
+     * Called automatically if the Buffer is full and on Destruction
+     */
+    void JsonStream::flush () {
+      if (Length > 0) {
+        Written += Target.write ((const uint8_t *)Buffer, Length);
+        Length = 0;
+      }
+    }
+
+    /**
+     * @brief Bytes written to the Target so far
+     *
+     * @return size_t Number of Bytes
+     */
+    size_t JsonStream::written () {
+      return Written;
+    }
+  }
+}
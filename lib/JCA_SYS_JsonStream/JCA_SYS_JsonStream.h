@@ -0,0 +1,72 @@
+/**
+ * @file JCA_SYS_JsonStream.h
+ * @author JCA (https://github.com/ichok)
+ * @brief Streaming JSON-Writer without Heap-Allocations
+ * The Output is collected in a fixed Buffer and written in Blocks to the Target (File, Client, Serial, ...).
+ * Commas between Entries are inserted automatically, Strings are escaped.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Copyright Jochen Cabrera 2022
+ * Apache License
+ *
+ */
+
+#ifndef _JCA_SYS_JSONSTREAM_
+#define _JCA_SYS_JSONSTREAM_
+#include <Arduino.h>
+
+// Size of the Write-Buffer, the Target is written in Blocks of this Size
+#define JCA_SYS_JSONSTREAM_BUFFERSIZE 128
+// Maximum Nesting of Objects and Arrays
+#define JCA_SYS_JSONSTREAM_MAXDEPTH 32
+// Decimals of float Values
+#define JCA_SYS_JSONSTREAM_DECIMALS 2
+
+namespace JCA {
+  namespace SYS {
+    /**
+     * @brief
+     * Write JSON directly to a Print-Target through a fixed Buffer
+     */
+    class JsonStream {
+    private:
+      Print &Target;
+      char Buffer[JCA_SYS_JSONSTREAM_BUFFERSIZE];
+      size_t Length;
+      size_t Written;
+      uint32_t HasEntry; ///< Bit n = Level n contains already an Entry
+      uint8_t Depth;
+
+      void write (char _Char);
+      void write (const char *_Text);
+      void writeEscaped (const char *_Text);
+      void writeKey (const char *_Key);
+      void open (const char *_Key, char _Bracket);
+      void close (char _Bracket);
+
+    public:
+      JsonStream (Print &_Target);
+      ~JsonStream ();
+
+      void beginObject (const char *_Key = nullptr);
+      void endObject ();
+      void beginArray (const char *_Key = nullptr);
+      void endArray ();
+
+      void add (const char *_Key, const char *_Value);
+      void add (const char *_Key, const String &_Value);
+      void add (const char *_Key, bool _Value);
+      void add (const char *_Key, int _Value);
+      void add (const char *_Key, unsigned int _Value);
+      void add (const char *_Key, long _Value);
+      void add (const char *_Key, unsigned long _Value);
+      void add (const char *_Key, double _Value);
+
+      void flush ();
+      size_t written ();
+    };
+  }
+}
+
+#endif
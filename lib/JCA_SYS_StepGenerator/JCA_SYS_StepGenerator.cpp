@@ -0,0 +1,419 @@
+/**
+ * @file JCA_SYS_StepGenerator.cpp
+ * @author JCA (https://github.com/ichok)
+ * @brief Interrupt driven Step-Pulse generation for a Stepper-Driver (Step/Dir/Enable)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Copyright Jochen Cabrera 2022
+ * Apache License
+ *
+ */
+
+#include <JCA_SYS_StepGenerator.h>
+
+// Prevent the Compiler from reordering the Queue-Access and the Index-Update
+#define JCA_SYS_STEPGENERATOR_BARRIER() __asm__ __volatile__ ("" ::: "memory")
+
+namespace JCA {
+  namespace SYS {
+    StepGenerator *StepGenerator::Instance = nullptr;
+    // Upper Bounds of the Lateness-Buckets in us
+    const uint32_t StepGenerator::LateBounds[JCA_SYS_STEPGENERATOR_LATEBOUNDS] = {5, 10, 20, 50, 100, 200, 500};
+
+    /**
+     * @brief Compile an Acceleration-Ramp into an Interval-Table
+     * Entry n contains the Interval of Ramp-Step (n << RampShift) in Generator-Ticks,
+     * the Shift is increased until the whole Ramp fits into the Table.
+     * @param _Ramp Interval-Table to fill
+     * @param _Size Entries of the Table
+     * @param _Acceleration Acceleration in Steps/s2
+     * @param _MaxSpeed Cruise-Speed in Steps/s
+     * @param _RampShift returns the Ramp-Steps per Table-Entry as Power of two
+     * @return uint32_t Steps until the Ramp reaches the Cruise-Speed, 0 if there is no Ramp
+     */
+    uint32_t StepGenerator::buildRamp (uint32_t *_Ramp, uint16_t _Size, float _Acceleration, float _MaxSpeed, uint8_t &_RampShift) {
+      _RampShift = 0;
+      if (_Size == 0 || _Acceleration <= 0.0 || _MaxSpeed <= 0.0) {
+        return 0;
+      }
+
+      // Steps until the Ramp reaches MaxSpeed, v(n) = sqrt(2an)
+      float CruiseTime = 1.0 / _MaxSpeed;
+      uint32_t RampSteps = (uint32_t)(_MaxSpeed * _MaxSpeed / (2.0 * _Acceleration));
+      while (RampSteps > 0 && getRampTime (_Acceleration, RampSteps - 1) <= CruiseTime) {
+        RampSteps--;
+      }
+      while (getRampTime (_Acceleration, RampSteps) > CruiseTime) {
+        RampSteps++;
+      }
+      if (RampSteps == 0) {
+        return 0;
+      }
+      while (((RampSteps - 1) >> _RampShift) >= _Size) {
+        _RampShift++;
+      }
+
+      for (uint32_t i = 0; i <= ((RampSteps - 1) >> _RampShift); i++) {
+        float Ticks = getRampTime (_Acceleration, i << _RampShift) * JCA_SYS_STEPGENERATOR_TICKS_PER_SECOND;
+        if (Ticks > JCA_SYS_STEPGENERATOR_INTERVAL_MAX) {
+          _Ramp[i] = JCA_SYS_STEPGENERATOR_INTERVAL_MAX;
+        } else if (Ticks < JCA_SYS_STEPGENERATOR_INTERVAL_MIN) {
+          _Ramp[i] = JCA_SYS_STEPGENERATOR_INTERVAL_MIN;
+        } else {
+          _Ramp[i] = (uint32_t)Ticks;
+        }
+      }
+      return RampSteps;
+    }
+
+    /**
+     * @brief Time between two Steps inside the Acceleration-Ramp
+     * Starting from stand still Step n is reached at t(n) = sqrt(2n/a)
+     * @param _Acceleration Acceleration in Steps/s2
+     * @param _RampStep Step-Number counted from stand still
+     * @return float Interval in Seconds
+     */
+    float StepGenerator::getRampTime (float _Acceleration, uint32_t _RampStep) {
+      // sqrt(n+1) - sqrt(n) without cancellation for big n
+      return sqrt (2.0 / _Acceleration) / (sqrt ((float)(_RampStep + 1)) + sqrt ((float)_RampStep));
+    }
+
+    /**
+     * @brief Construct a new StepGenerator::StepGenerator object
+     * The Enable-Input of the Driver is low active
+     * @param _PinEnable Pin that is connected to the Enable in on the Stepper-Driver
+     * @param _PinStep Pin that is connected to the Step in on the Stepper-Driver
+     * @param _PinDir Pin that is connected to the Direction in on the Stepper-Driver
+     */
+    StepGenerator::StepGenerator (uint8_t _PinEnable, uint8_t _PinStep, uint8_t _PinDir) {
+      PinEnable = _PinEnable;
+      PinStep = _PinStep;
+      PinDir = _PinDir;
+      TimerAttached = false;
+      Head = 0;
+      Tail = 0;
+      Active.Interval = 0;
+      Active.Steps = 0;
+      Active.Forward = true;
+      Active.Ramp = nullptr;
+      Active.RampStep = 0;
+      Active.RampDelta = 0;
+      Active.RampShift = 0;
+      Running = false;
+      Position = 0;
+      CurrentInterval = 0;
+      CurrentForward = true;
+      ArmedInterval = 0;
+      ArmedCycles = 0;
+      ArmedStep = false;
+      Lateness.setBounds (LateBounds, JCA_SYS_STEPGENERATOR_LATEBOUNDS);
+      MissedSteps = 0;
+      Instance = this;
+
+      pinMode (PinStep, OUTPUT);
+      pinMode (PinDir, OUTPUT);
+      pinMode (PinEnable, OUTPUT);
+      digitalWrite (PinStep, LOW);
+      digitalWrite (PinDir, HIGH);
+      disableOutputs ();
+    }
+
+    /**
+     * @brief Timer1 Interrupt-Routine
+     * Pass the Interrupt to the Instance
+     */
+    void IRAM_ATTR StepGenerator::onTimer () {
+      if (Instance != nullptr) {
+        Instance->doStep ();
+      }
+    }
+
+    /**
+     * @brief Output one Step and rearm the Timer for the next one
+     * If the active Segment is done the next Segment is taken from the Queue,
+     * if the Queue is empty the Timer is not rearmed and the Generator stops.
+     * Ramp-Segments take the Interval from the Table, so every Step costs one lookup.
+     * The Lateness of the Interrupt against the armed Interval is measured with the CPU-Cycle-Counter
+     * and counted in the Lateness-Histogram. Only Intervals between two Step-Pulses are counted,
+     * the Start, empty Segments and the final Stop-Interrupt are no Step-Samples.
+     * A Step that is later than its whole Interval has missed its Window.
+     */
+    void IRAM_ATTR StepGenerator::doStep () {
+      bool Measured = ArmedStep;
+      uint32_t Late = 0;
+      uint32_t Window = ArmedInterval;
+      if (Measured) {
+        uint32_t Elapsed = (ESP.getCycleCount () - ArmedCycles) / JCA_SYS_STEPGENERATOR_CYCLES_PER_TICK;
+        Late = Elapsed > Window ? Elapsed - Window : 0;
+      }
+      if (Active.Steps == 0) {
+        if (Tail == Head) {
+          Running = false;
+          CurrentInterval = 0;
+          ArmedInterval = 0;
+          ArmedStep = false;
+          return;
+        }
+        JCA_SYS_STEPGENERATOR_BARRIER ();
+        Active = Queue[Tail];
+        Tail = (Tail + 1) & (JCA_SYS_STEPGENERATOR_QUEUESIZE - 1);
+        if (Active.Forward != CurrentForward) {
+          digitalWrite (PinDir, Active.Forward ? HIGH : LOW);
+          CurrentForward = Active.Forward;
+          delayMicroseconds (JCA_SYS_STEPGENERATOR_PULSEWIDTH);
+        }
+        if (Active.Steps == 0) {
+          arm (JCA_SYS_STEPGENERATOR_INTERVAL_MIN, false);
+          return;
+        }
+      }
+
+      uint32_t Interval = Active.Interval;
+      if (Active.Ramp != nullptr) {
+        Interval = Active.Ramp[Active.RampStep >> Active.RampShift];
+        Active.RampStep += Active.RampDelta;
+      }
+
+      // Step-Pulse
+      digitalWrite (PinStep, HIGH);
+      delayMicroseconds (JCA_SYS_STEPGENERATOR_PULSEWIDTH);
+      digitalWrite (PinStep, LOW);
+      if (CurrentForward) {
+        Position = Position + 1;
+      } else {
+        Position = Position - 1;
+      }
+      Active.Steps--;
+      if (Measured) {
+        Lateness.add (Late / JCA_SYS_STEPGENERATOR_TICKS_PER_US);
+        if (Late >= Window) {
+          MissedSteps = MissedSteps + 1;
+        }
+      }
+      CurrentInterval = Interval;
+      arm (Interval, true);
+    }
+
+    /**
+     * @brief Rearm the Timer and remember the Interval for the Lateness-Measurement
+     *
+     * @param _Interval Timer-Ticks until the next Interrupt
+     * @param _Step true if a Step-Pulse was output right before, only then the next Interrupt is a Step-Sample
+     */
+    void IRAM_ATTR StepGenerator::arm (uint32_t _Interval, bool _Step) {
+      ArmedInterval = _Interval;
+      ArmedStep = _Step;
+      ArmedCycles = ESP.getCycleCount ();
+      timer1_write (_Interval);
+    }
+
+    /**
+     * @brief Copy a Segment to the Queue
+     *
+     * @param _Segment Segment to add
+     * @return true Segment added
+     * @return false Queue is full
+     */
+    bool StepGenerator::push (const StepSegment &_Segment) {
+      uint8_t Next = (Head + 1) & (JCA_SYS_STEPGENERATOR_QUEUESIZE - 1);
+      if (Next == Tail || _Segment.Steps == 0) {
+        return false;
+      }
+      Queue[Head] = _Segment;
+      JCA_SYS_STEPGENERATOR_BARRIER ();
+      Head = Next;
+      return true;
+    }
+
+    /**
+     * @brief Add a Segment with constant Interval to the Queue
+     * The Generator is not started automatically, call start() after the Queue is filled
+     * @param _Interval Timer-Ticks between two Steps (JCA_SYS_STEPGENERATOR_TICKS_PER_SECOND / Speed)
+     * @param _Steps Number of Steps
+     * @param _Forward Direction of the Steps
+     * @return true Segment added
+     * @return false Queue is full
+     */
+    bool StepGenerator::push (uint32_t _Interval, uint32_t _Steps, bool _Forward) {
+      StepSegment Segment;
+      if (_Interval < JCA_SYS_STEPGENERATOR_INTERVAL_MIN) {
+        _Interval = JCA_SYS_STEPGENERATOR_INTERVAL_MIN;
+      }
+      if (_Interval > JCA_SYS_STEPGENERATOR_INTERVAL_MAX) {
+        _Interval = JCA_SYS_STEPGENERATOR_INTERVAL_MAX;
+      }
+      Segment.Interval = _Interval;
+      Segment.Steps = _Steps;
+      Segment.Forward = _Forward;
+      Segment.Ramp = nullptr;
+      Segment.RampStep = 0;
+      Segment.RampDelta = 0;
+      Segment.RampShift = 0;
+      return push (Segment);
+    }
+
+    /**
+     * @brief Add a Ramp-Segment to the Queue
+     * Acceleration runs the Table from Ramp-Step 0 upwards, Deceleration from Ramp-Step (_Steps - 1) down to 0.
+     * The Table has to stay valid and unchanged until the Segment is done,
+     * the Entries have to be inside the Interval-Limits of the Generator.
+     * @param _Ramp Interval-Table in Timer-Ticks
+     * @param _RampShift Ramp-Steps per Table-Entry as Power of two
+     * @param _Steps Number of Steps
+     * @param _Accelerate true for Acceleration, false for Deceleration
+     * @param _Forward Direction of the Steps
+     * @return true Segment added
+     * @return false Queue is full
+     */
+    bool StepGenerator::pushRamp (const uint32_t *_Ramp, uint8_t _RampShift, uint32_t _Steps, bool _Accelerate, bool _Forward) {
+      StepSegment Segment;
+      Segment.Interval = 0;
+      Segment.Steps = _Steps;
+      Segment.Forward = _Forward;
+      Segment.Ramp = _Ramp;
+      Segment.RampShift = _RampShift;
+      if (_Accelerate) {
+        Segment.RampStep = 0;
+        Segment.RampDelta = 1;
+      } else {
+        Segment.RampStep = (int32_t)_Steps - 1;
+        Segment.RampDelta = -1;
+      }
+      return push (Segment);
+    }
+
+    /**
+     * @brief Number of free Segments inside the Queue
+     *
+     * @return uint8_t free Segments
+     */
+    uint8_t StepGenerator::available () {
+      return (Tail - Head - 1) & (JCA_SYS_STEPGENERATOR_QUEUESIZE - 1);
+    }
+
+    /**
+     * @brief Start the Timer if the Generator is stopped and Segments are queued
+     * On first call the Timer1-Interrupt is attached
+     */
+    void StepGenerator::start () {
+      if (!TimerAttached) {
+        timer1_isr_init ();
+        timer1_attachInterrupt (onTimer);
+        timer1_enable (TIM_DIV16, TIM_EDGE, TIM_SINGLE);
+        TimerAttached = true;
+      }
+      noInterrupts ();
+      if (!Running && Tail != Head) {
+        Running = true;
+        arm (JCA_SYS_STEPGENERATOR_INTERVAL_MIN, false);
+      }
+      interrupts ();
+    }
+
+    /**
+     * @brief Stop the Movement immediately
+     * Clears the Queue and the active Segment, the Generator stops on the next Interrupt
+     */
+    void StepGenerator::stop () {
+      noInterrupts ();
+      Head = Tail;
+      Active.Steps = 0;
+      interrupts ();
+    }
+
+    /**
+     * @brief Check if the Timer still outputs Steps
+     *
+     * @return true Generator is running
+     * @return false Generator is stopped
+     */
+    bool StepGenerator::isRunning () {
+      return Running;
+    }
+
+    /**
+     * @brief Check if there are queued Segments
+     *
+     * @return true Queue is empty
+     * @return false Queue contains Segments
+     */
+    bool StepGenerator::isEmpty () {
+      return Tail == Head;
+    }
+
+    /**
+     * @brief Current Position, counted by the Interrupt
+     *
+     * @return int32_t Position in Steps
+     */
+    int32_t StepGenerator::getPosition () {
+      return Position;
+    }
+
+    /**
+     * @brief Current Speed, calculated from the active Interval
+     *
+     * @return float Speed in Steps per Second, negative for backward
+     */
+    float StepGenerator::getSpeed () {
+      uint32_t Interval = CurrentInterval;
+      if (!Running || Interval == 0) {
+        return 0.0;
+      }
+      float Speed = (float)JCA_SYS_STEPGENERATOR_TICKS_PER_SECOND / (float)Interval;
+      return CurrentForward ? Speed : -Speed;
+    }
+
+    /**
+     * @brief Maximum Lateness of a Step-Interrupt since the last Reset
+     * Includes the Latency of the Interrupt and the Time other Interrupts block it
+     * @return uint32_t Lateness in us
+     */
+    uint32_t StepGenerator::getMaxLateness () {
+      return Lateness.max ();
+    }
+
+    /**
+     * @brief Lateness-Histogram of the Steps since the last Reset
+     * Bounds in us, written by the Interrupt
+     * @return Histogram& Histogram of the Lateness
+     */
+    Histogram &StepGenerator::getLateness () {
+      return Lateness;
+    }
+
+    /**
+     * @brief Number of Steps that missed their Window since the last Reset
+     * The Step was later than its whole Interval, so the Speed was at least halved for this Step
+     * @return uint32_t Number of Steps
+     */
+    uint32_t StepGenerator::getMissedSteps () {
+      return MissedSteps;
+    }
+
+    /**
+     * @brief Reset the Lateness-Statistic, like on Start of a Movement
+     */
+    void StepGenerator::resetLateness () {
+      noInterrupts ();
+      Lateness.reset ();
+      MissedSteps = 0;
+      interrupts ();
+    }
+
+    /**
+     * @brief Enable the Stepper-Driver (low active)
+     */
+    void StepGenerator::enableOutputs () {
+      digitalWrite (PinEnable, LOW);
+    }
+
+    /**
+     * @brief Disable the Stepper-Driver (low active)
+     */
+    void StepGenerator::disableOutputs () {
+      digitalWrite (PinEnable, HIGH);
+    }
+  }
+}
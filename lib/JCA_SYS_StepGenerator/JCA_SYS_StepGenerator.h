@@ -0,0 +1,115 @@
+/**
+ * @file JCA_SYS_StepGenerator.h
+ * @author JCA (https://github.com/ichok)
+ * @brief Interrupt driven Step-Pulse generation for a Stepper-Driver (Step/Dir/Enable)
+ * The Loop only plans the Movement and pushes Segments (Interval + Stepcount) to a Queue,
+ * the Timer1-Interrupt pops the Segments and outputs the Step-Pulses.
+ * Only one Instance is possible, because there is only one Timer1 on the ESP8266.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Copyright Jochen Cabrera 2022
+ * Apache License
+ *
+ */
+
+#ifndef _JCA_SYS_STEPGENERATOR_
+#define _JCA_SYS_STEPGENERATOR_
+#include <Arduino.h>
+#include <JCA_SYS_Histogram.h>
+
+// Number of queued Segments, must be a power of two
+#define JCA_SYS_STEPGENERATOR_QUEUESIZE 32
+// Timer1 runs with TIM_DIV16 -> 80MHz / 16 = 5MHz
+#define JCA_SYS_STEPGENERATOR_TICKS_PER_SECOND 5000000UL
+// Limits of the Timer1 Interval in Ticks (23 Bit Counter)
+#define JCA_SYS_STEPGENERATOR_INTERVAL_MIN 50UL
+#define JCA_SYS_STEPGENERATOR_INTERVAL_MAX 0x7FFFFFUL
+// Length of the Step-Pulse in us
+#define JCA_SYS_STEPGENERATOR_PULSEWIDTH 2
+// CPU-Cycles per Timer-Tick, to measure the Lateness of the Interrupt
+#define JCA_SYS_STEPGENERATOR_CYCLES_PER_TICK (F_CPU / JCA_SYS_STEPGENERATOR_TICKS_PER_SECOND)
+#define JCA_SYS_STEPGENERATOR_TICKS_PER_US (JCA_SYS_STEPGENERATOR_TICKS_PER_SECOND / 1000000UL)
+// Bounds of the Lateness-Histogram, one more Bucket counts all Steps later than the last Bound
+#define JCA_SYS_STEPGENERATOR_LATEBOUNDS 7
+
+namespace JCA {
+  namespace SYS {
+    /**
+     * @brief
+     * Part of a Movement, with constant Interval or Intervals from a Ramp-Table
+     */
+    struct StepSegment {
+      uint32_t Interval;     ///< Timer-Ticks between two Steps
+      uint32_t Steps;        ///< Number of Steps of the Segment
+      bool Forward;          ///< Direction of the Steps
+      const uint32_t *Ramp;  ///< Interval-Table (Ticks), nullptr for constant Interval
+      int32_t RampStep;      ///< Ramp-Step of the next Step, Table-Index is RampStep >> RampShift
+      int8_t RampDelta;      ///< +1 for Acceleration, -1 for Deceleration
+      uint8_t RampShift;     ///< Ramp-Steps per Table-Entry as Power of two
+    };
+
+    /**
+     * @brief
+     * Output Step-Pulses from a Segment-Queue inside the Timer1-Interrupt
+     */
+    class StepGenerator {
+    private:
+      static StepGenerator *Instance;
+      static const uint32_t LateBounds[JCA_SYS_STEPGENERATOR_LATEBOUNDS];
+      static void onTimer ();
+
+      // Hardware
+      uint8_t PinEnable;
+      uint8_t PinStep;
+      uint8_t PinDir;
+      bool TimerAttached;
+
+      // Queue, Head is only written by the Loop, Tail only by the Interrupt
+      StepSegment Queue[JCA_SYS_STEPGENERATOR_QUEUESIZE];
+      volatile uint8_t Head;
+      volatile uint8_t Tail;
+
+      // Interrupt State
+      StepSegment Active;
+      volatile bool Running;
+      volatile int32_t Position;
+      volatile uint32_t CurrentInterval;
+      volatile bool CurrentForward;
+
+      // Timing, Lateness of the Interrupt against the armed Interval
+      volatile uint32_t ArmedInterval;
+      volatile uint32_t ArmedCycles;
+      volatile bool ArmedStep;
+      Histogram Lateness;
+      volatile uint32_t MissedSteps;
+
+      void doStep ();
+      void arm (uint32_t _Interval, bool _Step);
+      bool push (const StepSegment &_Segment);
+
+    public:
+      static uint32_t buildRamp (uint32_t *_Ramp, uint16_t _Size, float _Acceleration, float _MaxSpeed, uint8_t &_RampShift);
+      static float getRampTime (float _Acceleration, uint32_t _RampStep);
+
+      StepGenerator (uint8_t _PinEnable, uint8_t _PinStep, uint8_t _PinDir);
+      bool push (uint32_t _Interval, uint32_t _Steps, bool _Forward);
+      bool pushRamp (const uint32_t *_Ramp, uint8_t _RampShift, uint32_t _Steps, bool _Accelerate, bool _Forward);
+      uint8_t available ();
+      void start ();
+      void stop ();
+      bool isRunning ();
+      bool isEmpty ();
+      int32_t getPosition ();
+      float getSpeed ();
+      uint32_t getMaxLateness ();
+      Histogram &getLateness ();
+      uint32_t getMissedSteps ();
+      void resetLateness ();
+      void enableOutputs ();
+      void disableOutputs ();
+    };
+  }
+}
+
+#endif
@@ -7,11 +7,13 @@
 // Basics
 #include <JCA_IOT_Webserver.h>
 #include <JCA_SYS_DebugOut.h>
+#include <JCA_SYS_JsonStream.h>
 
 // Project function
 #include <JCA_FNC_Feeder.h>
 #include <JCA_FNC_Level.h>
 #include <JCA_FNC_Parent.h>
+#include <JCA_FNC_Perf.h>
 
 using namespace JCA::IOT;
 using namespace JCA::SYS;
@@ -43,35 +45,44 @@ Level Futter (LEVEL_PIN, "Futter");
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++
 Webserver Server;
 //-------------------------------------------------------
+// Profiler, Run-Time of every Element, the Webserver and the Loop
+//-------------------------------------------------------
+Perf Profiler ("Perf");
+uint8_t HandleSlot = Profiler.addSlot ("handle");
+//-------------------------------------------------------
 // System Functions
 //-------------------------------------------------------
 void cbSystemReset () {
+  Debug.flush ();
   ESP.restart ();
 }
 void cbSaveConfig () {
   File ConfigFile = LittleFS.open (CONFIGPATH, "w");
-  bool ElementInit = false;
-  ConfigFile.println("{\"elements\":[");
-  Server.writeSetup(ConfigFile, ElementInit);
-  Spindel.writeSetup (ConfigFile, ElementInit);
-  Futter.writeSetup (ConfigFile, ElementInit);
-  ConfigFile.println ("]}");
+  JsonStream Setup (ConfigFile);
+  Setup.beginObject ();
+  Setup.beginArray (Protocol::JsonTagElements);
+  Server.writeSetup (Setup);
+  Spindel.writeSetup (Setup);
+  Futter.writeSetup (Setup);
+  Profiler.writeSetup (Setup);
+  Setup.endArray ();
+  Setup.endObject ();
+  Setup.flush ();
   ConfigFile.close ();
 }
 
-void getAllValues(JsonVariant &_Out) {
+void getAllValues(JsonVariant &_In, JsonVariant &_Out) {
+  // Only Changes after the Sequence of the Client, missing Sequence returns all Values
+  uint32_t Since = _In[Protocol::JsonTagSequence].as<uint32_t> ();
   JsonObject Elements = _Out.createNestedObject (Protocol::JsonTagElements);
-  Server.getValues (Elements);
-  Spindel.getValues (Elements);
-  Futter.getValues (Elements);
+  Protocol::getAllValues (Elements, Since, _In[Protocol::JsonTagSubscribe].as<JsonObject> ());
+  _Out[Protocol::JsonTagSequence] = Protocol::getSequence ();
 }
 
 void setAll(JsonVariant &_In) {
   if (_In.containsKey (Protocol::JsonTagElements)) {
     JsonArray Elements = (_In.as<JsonObject> ())[Protocol::JsonTagElements].as<JsonArray> ();
-    Server.set (Elements);
-    Spindel.set (Elements);
-    Futter.set (Elements);
+    Protocol::setAll (Elements);
   }
 }
 //-------------------------------------------------------
@@ -87,7 +98,7 @@ String cbWebConfigReplace (const String &var) {
 // RestAPI Functions
 //-------------------------------------------------------
 void cbRestApiGet (JsonVariant &_In, JsonVariant &_Out) {
-  getAllValues(_Out);
+  getAllValues(_In, _Out);
 }
 
 void cbRestApiPost (JsonVariant &_In, JsonVariant &_Out) {
@@ -99,7 +110,8 @@ void cbRestApiPut (JsonVariant &_In, JsonVariant &_Out) {
 }
 
 void cbRestApiPatch (JsonVariant &_In, JsonVariant &_Out) {
-  cbSaveConfig();
+  // Deferred while the Spindel is moving
+  Server.runJob (cbSaveConfig, JCA_IOT_WEBSERVER_JOB_SAVECONFIG);
 }
 
 void cbRestApiDelete (JsonVariant &_In, JsonVariant &_Out) {
@@ -110,13 +122,13 @@ void cbRestApiDelete (JsonVariant &_In, JsonVariant &_Out) {
 // Websocket Functions
 //-------------------------------------------------------
 void cbWsUpdate (JsonVariant &_In, JsonVariant &_Out) {
-  getAllValues(_Out);
+  getAllValues(_In, _Out);
 }
 void cbWsData (JsonVariant &_In, JsonVariant &_Out) {
   setAll(_In);
 
   // Return Value update
-  getAllValues(_Out);
+  getAllValues(_In, _Out);
 }
 
 //#######################################################
@@ -135,7 +147,7 @@ void setup () {
   // Filesystem
   //+++++++++++++++++++++++++++++++++++++++++++++++++++++++
   if (!LittleFS.begin ()) {
-    Debug.println (FLAG_ERROR, false, "root", "setup", "LITTLEFS Mount Failed");
+    JCA_DEBUG_PRINTLN (FLAG_ERROR, false, "root", "setup", "LITTLEFS Mount Failed");
     return;
   }
 
@@ -166,29 +178,36 @@ void setup () {
   //-------------------------------------------------------
   File ConfigFile = LittleFS.open (CONFIGPATH, "r");
   if (ConfigFile) {
-    Debug.println (FLAG_CONFIG, false, "main", "setup", "Config File Found");
+    JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, "main", "setup", "Config File Found");
     DeserializationError Error = deserializeJson (JDoc, ConfigFile);
     if (!Error) {
-      Debug.println (FLAG_CONFIG, false, "main", "setup", "Deserialize Done");
+      JCA_DEBUG_PRINTLN (FLAG_CONFIG, false, "main", "setup", "Deserialize Done");
       JsonVariant InConfig = JDoc.as<JsonVariant>();
       setAll(InConfig);
     } else {
-      Debug.print (FLAG_ERROR, false, "main", "setup", "deserializeJson() failed: ");
-      Debug.println (FLAG_ERROR, false, "main", "setup", Error.c_str ());
+      JCA_DEBUG_PRINT (FLAG_ERROR, false, "main", "setup", "deserializeJson() failed: ");
+      JCA_DEBUG_PRINTLN (FLAG_ERROR, false, "main", "setup", Error.c_str ());
     }
     ConfigFile.close ();
   } else {
-    Debug.println (FLAG_ERROR, false, "main", "setup", "Config File NOT found");
+    JCA_DEBUG_PRINTLN (FLAG_ERROR, false, "main", "setup", "Config File NOT found");
   }
+  Debug.flush ();
 }
 
 //#######################################################
 // Loop
 //#######################################################
 void loop () {
+  Profiler.loop ();
+  uint32_t Start = ESP.getCycleCount ();
   Server.handle ();
+  Profiler.measure (HandleSlot, Start);
   tm CurrentTime = Server.getTimeStruct ();
 
-  Spindel.update (CurrentTime);
-  Futter.update (CurrentTime);
+  // Due Elements by Priority, the Spindel in every Pass
+  Protocol::updateAll (CurrentTime);
+
+  // Debug-Output in the Rest of the Pass, without waiting for the UART
+  Debug.handle ();
 }
\ No newline at end of file
@@ -0,0 +1,292 @@
+/**
+ * @file Arduino.h
+ * @author JCA (https://github.com/ichok)
+ * @brief Host-Replacement of the Arduino-Core for the native Tests (pio test -e native)
+ * Only the Parts used by the hardware independent Libraries: Print, Printable, String,
+ * Time-Functions and empty Pin-, Timer1- and Serial-Functions.
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * Copyright Jochen Cabrera 2022
+ * Apache License
+ *
+ */
+
+#ifndef _JCA_TEST_ARDUINO_
+#define _JCA_TEST_ARDUINO_
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <time.h>
+
+using std::max;
+using std::min;
+
+#define IRAM_ATTR
+#define ICACHE_RAM_ATTR
+#define PROGMEM
+#define F_CPU 80000000L
+#define DEC 10
+#define HEX 16
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define TIM_DIV16 1
+#define TIM_EDGE 0
+#define TIM_SINGLE 0
+#define TIM_LOOP 1
+
+typedef uint8_t byte;
+
+// Flash-Strings are normal Strings on the Host
+class __FlashStringHelper;
+#define F(_Text) (reinterpret_cast<const __FlashStringHelper *> (_Text))
+#define FPSTR(_Text) (reinterpret_cast<const __FlashStringHelper *> (_Text))
+
+inline uint64_t hostMicros () {
+  static const auto Start = std::chrono::steady_clock::now ();
+  return std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - Start).count ();
+}
+inline unsigned long millis () {
+  return (unsigned long)(hostMicros () / 1000);
+}
+inline unsigned long micros () {
+  return (unsigned long)hostMicros ();
+}
+inline void delay (unsigned long) {}
+inline void delayMicroseconds (unsigned int) {}
+inline void yield () {}
+inline void noInterrupts () {}
+inline void interrupts () {}
+inline void pinMode (uint8_t, uint8_t) {}
+inline void digitalWrite (uint8_t, uint8_t) {}
+inline int digitalRead (uint8_t) {
+  return LOW;
+}
+inline int analogRead (uint8_t) {
+  return 0;
+}
+
+typedef void (*timercallback) (void);
+inline void timer1_isr_init () {}
+inline void timer1_enable (uint8_t, uint8_t, uint8_t) {}
+inline void timer1_disable () {}
+inline void timer1_attachInterrupt (timercallback) {}
+inline void timer1_detachInterrupt () {}
+inline void timer1_write (uint32_t) {}
+
+inline char *dtostrf (double _Value, signed char _Width, unsigned char _Decimals, char *_Buffer) {
+  sprintf (_Buffer, "%*.*f", _Width, _Decimals, _Value);
+  return _Buffer;
+}
+
+class EspClass {
+public:
+  // 80 MHz CPU-Cycles from the Host-Clock
+  uint32_t getCycleCount () {
+    return (uint32_t)(hostMicros () * 80);
+  }
+  uint32_t getCpuFreqMHz () {
+    return 80;
+  }
+  uint32_t getFreeHeap () {
+    return 0;
+  }
+  void restart () {}
+};
+inline EspClass ESP;
+
+class String {
+private:
+  std::string Text;
+
+public:
+  String () {}
+  String (const char *_Text) : Text (_Text != nullptr ? _Text : "") {}
+  String (const __FlashStringHelper *_Text) : Text ((const char *)_Text) {}
+  explicit String (int _Value) : Text (std::to_string (_Value)) {}
+  explicit String (unsigned int _Value) : Text (std::to_string (_Value)) {}
+  explicit String (long _Value) : Text (std::to_string (_Value)) {}
+  explicit String (unsigned long _Value) : Text (std::to_string (_Value)) {}
+  explicit String (double _Value, unsigned char _Decimals = 2) {
+    char Number[32];
+    snprintf (Number, sizeof (Number), "%.*f", _Decimals, _Value);
+    Text = Number;
+  }
+  String &operator+= (const String &_Text) {
+    Text += _Text.Text;
+    return *this;
+  }
+  String &operator+= (const char *_Text) {
+    Text += _Text;
+    return *this;
+  }
+  String &operator+= (char _Char) {
+    Text += _Char;
+    return *this;
+  }
+  friend String operator+ (const String &_Left, const String &_Right) {
+    String Result (_Left);
+    Result += _Right;
+    return Result;
+  }
+  friend String operator+ (const String &_Left, const char *_Right) {
+    String Result (_Left);
+    Result += _Right;
+    return Result;
+  }
+  friend String operator+ (const char *_Left, const String &_Right) {
+    String Result (_Left);
+    Result += _Right;
+    return Result;
+  }
+  bool operator== (const String &_Other) const {
+    return Text == _Other.Text;
+  }
+  bool operator== (const char *_Other) const {
+    return Text == _Other;
+  }
+  bool concat (const char *_Text) {
+    Text += _Text;
+    return true;
+  }
+  bool concat (char _Char) {
+    Text += _Char;
+    return true;
+  }
+  bool reserve (unsigned int _Size) {
+    Text.reserve (_Size);
+    return true;
+  }
+  unsigned int length () const {
+    return Text.size ();
+  }
+  const char *c_str () const {
+    return Text.c_str ();
+  }
+};
+
+class Print;
+class Printable {
+public:
+  virtual ~Printable () {}
+  virtual size_t printTo (Print &_Target) const = 0;
+};
+
+class Print {
+private:
+  template <class T>
+  size_t printFormat (const char *_Format, T _Value) {
+    char Number[32];
+    snprintf (Number, sizeof (Number), _Format, _Value);
+    return write (Number);
+  }
+
+public:
+  virtual ~Print () {}
+  virtual size_t write (uint8_t _Char) = 0;
+  virtual size_t write (const uint8_t *_Buffer, size_t _Size) {
+    size_t Written = 0;
+    while (_Size-- > 0) {
+      Written += write (*_Buffer++);
+    }
+    return Written;
+  }
+  size_t write (const char *_Text) {
+    return _Text == nullptr ? 0 : write ((const uint8_t *)_Text, strlen (_Text));
+  }
+  size_t write (const char *_Buffer, size_t _Size) {
+    return write ((const uint8_t *)_Buffer, _Size);
+  }
+  virtual int availableForWrite () {
+    return 0;
+  }
+  virtual void flush () {}
+
+  size_t print (const String &_Text) {
+    return write (_Text.c_str ());
+  }
+  size_t print (const char *_Text) {
+    return write (_Text);
+  }
+  size_t print (const __FlashStringHelper *_Text) {
+    return write ((const char *)_Text);
+  }
+  size_t print (char _Char) {
+    return write ((uint8_t)_Char);
+  }
+  size_t print (unsigned char _Value) {
+    return printFormat ("%u", (unsigned int)_Value);
+  }
+  size_t print (int _Value) {
+    return printFormat ("%d", _Value);
+  }
+  size_t print (unsigned int _Value) {
+    return printFormat ("%u", _Value);
+  }
+  size_t print (long _Value) {
+    return printFormat ("%ld", _Value);
+  }
+  size_t print (unsigned long _Value) {
+    return printFormat ("%lu", _Value);
+  }
+  size_t print (long long _Value) {
+    return printFormat ("%lld", _Value);
+  }
+  size_t print (unsigned long long _Value) {
+    return printFormat ("%llu", _Value);
+  }
+  size_t print (double _Value, int _Decimals = 2) {
+    char Format[8];
+    snprintf (Format, sizeof (Format), "%%.%df", _Decimals);
+    return printFormat (Format, _Value);
+  }
+  size_t print (const Printable &_Value) {
+    return _Value.printTo (*this);
+  }
+  size_t println () {
+    return write ("\r\n");
+  }
+  template <class T>
+  size_t println (const T &_Value) {
+    size_t Written = print (_Value);
+    return Written + println ();
+  }
+};
+
+class Stream : public Print {
+public:
+  virtual int available () {
+    return 0;
+  }
+  virtual int read () {
+    return -1;
+  }
+};
+
+// Serial without Output, the UART takes everything at once
+class HardwareSerial : public Stream {
+public:
+  HardwareSerial (int) {}
+  void begin (unsigned long) {}
+  size_t write (uint8_t) override {
+    return 1;
+  }
+  size_t write (const uint8_t *, size_t _Size) override {
+    return _Size;
+  }
+  using Print::write;
+  int availableForWrite () override {
+    return 128;
+  }
+};
+inline HardwareSerial Serial (0);
+
+#endif
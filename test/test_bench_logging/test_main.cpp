@@ -0,0 +1,121 @@
+#include <JCA_SYS_DebugOut.h>
+#include <new>
+#include <unity.h>
+using namespace JCA::SYS;
+
+// Host-Benchmark of the Protocol-Routing with Logging off.
+// Every Element of the Message is set like the former Protocol::set, one Log-Call in set
+// and in each of findConfig, findData and findCmd.
+#define BENCH_ROUNDS 200000
+#define BENCH_ELEMENTS 3
+
+static size_t Allocations = 0;
+static volatile uint32_t Sink;
+
+void *operator new (size_t _Size) {
+  Allocations++;
+  void *Memory = malloc (_Size);
+  if (Memory == nullptr) {
+    throw std::bad_alloc ();
+  }
+  return Memory;
+}
+void operator delete (void *_Memory) noexcept {
+  free (_Memory);
+}
+void operator delete (void *_Memory, size_t) noexcept {
+  free (_Memory);
+}
+
+/**
+ * @brief Former DebugOut-Interface, the Element-Name is passed as String by Value
+ * println passes the Name on to print, which checks the Flags
+ */
+class StringDebug {
+private:
+  uint16_t Flags = FLAG_NONE;
+
+public:
+  __attribute__ ((noinline)) bool print (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, const char *_Message) {
+    if (_Flag & Flags) {
+      Serial.print (_ElementName);
+      Serial.print (_Message);
+      return true;
+    }
+    return false;
+  }
+  __attribute__ ((noinline)) bool println (DEBUGOUT_FLAGS _Flag, bool _Framework, String _ElementName, const char *_Function, const char *_Message) {
+    if (print (_Flag, _Framework, _ElementName, _Function, _Message)) {
+      Serial.println ();
+      return true;
+    }
+    return false;
+  }
+};
+static StringDebug OldDebug;
+
+// Registered Elements, the last Name is longer than the Small-String-Buffer
+static String Names[BENCH_ELEMENTS] = {String ("System"), String ("Spindel"), String ("Temperatur_Aquarium")};
+static const char *Message[BENCH_ELEMENTS] = {"Temperatur_Aquarium", "Spindel", "System"};
+
+template <class LOG>
+static uint32_t findBlock (const String &_Name, LOG _Log) {
+  _Log (_Name);
+  for (uint8_t i = 0; i < BENCH_ELEMENTS; i++) {
+    if (strcmp (Message[i], _Name.c_str ()) == 0) {
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+template <class LOG>
+static uint32_t setAll (LOG _Log) {
+  uint32_t Found = 0;
+  for (uint8_t e = 0; e < BENCH_ELEMENTS; e++) {
+    _Log (Names[e]);
+    Found += findBlock (Names[e], _Log);
+    Found += findBlock (Names[e], _Log);
+    Found += findBlock (Names[e], _Log);
+  }
+  return Found;
+}
+
+template <class LOG>
+static void bench (const char *_Label, LOG _Log, double &_Ns, double &_Allocations) {
+  char Text[128];
+  size_t StartAllocations = Allocations;
+  uint64_t Start = hostMicros ();
+  for (int r = 0; r < BENCH_ROUNDS; r++) {
+    Sink = setAll (_Log);
+  }
+  _Ns = (hostMicros () - Start) * 1000.0 / BENCH_ROUNDS;
+  _Allocations = (double)(Allocations - StartAllocations) / BENCH_ROUNDS;
+  snprintf (Text, sizeof (Text), "%s %.1f ns/Message, %.1f Allocations/Message", _Label, _Ns, _Allocations);
+  TEST_MESSAGE (Text);
+}
+
+void setUp () {
+  Debug.init (FLAG_NONE);
+}
+void tearDown () {}
+
+void test_bench_logging () {
+  double NoneNs, NoneAllocations;
+  double StringNs, StringAllocations;
+  double MacroNs, MacroAllocations;
+  auto NoLog = [] (const String &) {};
+  auto StringLog = [] (const String &_Name) { OldDebug.println (FLAG_PROTOCOL, true, _Name, __func__, "Start"); };
+  auto MacroLog = [] (const String &_Name) { JCA_DEBUG_PRINTLN (FLAG_PROTOCOL, true, _Name, __func__, "Start"); };
+  bench ("No Logging:             ", NoLog, NoneNs, NoneAllocations);
+  bench ("String-Name, FLAG_NONE: ", StringLog, StringNs, StringAllocations);
+  bench ("JCA_DEBUG, FLAG_NONE:   ", MacroLog, MacroNs, MacroAllocations);
+  TEST_ASSERT_EQUAL (0, MacroAllocations);
+  TEST_ASSERT_LESS_THAN (StringNs, MacroNs);
+}
+
+int main (int argc, char **argv) {
+  UNITY_BEGIN ();
+  RUN_TEST (test_bench_logging);
+  return UNITY_END ();
+}
@@ -0,0 +1,126 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <unity.h>
+
+// Host-Benchmark of the Message-Encoding: JSON against MessagePack with ArduinoJson.
+// Full is the first Update of a new Client, Delta a cyclic Update while Feeding.
+#define BENCH_DOCSIZE 4096
+#define BENCH_BUFFERSIZE 2048
+#define BENCH_ROUNDS 20000
+
+static volatile size_t Sink;
+
+static void fillFull (JsonDocument &_Doc) {
+  _Doc["seq"] = 1234;
+  JsonObject Elements = _Doc.createNestedObject ("elements");
+  JsonObject System = Elements.createNestedObject ("System").createNestedObject ("data");
+  System["time"] = "2026-10-16 07:30:00";
+  System["wsRtt"] = 12;
+  System["wsClients"] = "1:12ms,2:48ms";
+
+  JsonObject Spindel = Elements.createNestedObject ("Spindel");
+  JsonObject Data = Spindel.createNestedObject ("data");
+  Data["Feeding"] = true;
+  Data["DistanceToGo"] = 1234;
+  Data["RunConst"] = false;
+  Data["Speed"] = 812.5f;
+  Data["StepLateness"] = 18;
+  Data["MissedSteps"] = 0;
+  Data["MissedFeedings"] = 0;
+  JsonObject Config = Spindel.createNestedObject ("config");
+  Config["SteppsPerRotation"] = 200;
+  Config["FeedingRotations"] = 2.5f;
+  Config["Acceleration"] = 500.0f;
+  Config["MaxSpeed"] = 4000.0f;
+  Config["ConstSpeed"] = 1000.0f;
+  Config["MotionPriority"] = true;
+  char Name[16];
+  for (int i = 1; i <= 4; i++) {
+    snprintf (Name, sizeof (Name), "Slot%dHour", i);
+    Config[Name] = 6 + i * 3;
+    snprintf (Name, sizeof (Name), "Slot%dMinute", i);
+    Config[Name] = 30;
+    snprintf (Name, sizeof (Name), "Slot%dDays", i);
+    Config[Name] = 127;
+    snprintf (Name, sizeof (Name), "Slot%dDose", i);
+    Config[Name] = 1.5f;
+  }
+
+  JsonObject Temperatur = Elements.createNestedObject ("Temperatur");
+  Temperatur.createNestedObject ("data")["Value"] = 24.25f;
+  Temperatur.createNestedObject ("config")["Offset"] = -0.5f;
+}
+
+static void fillDelta (JsonDocument &_Doc) {
+  _Doc["seq"] = 1235;
+  JsonObject Data = _Doc.createNestedObject ("elements").createNestedObject ("Spindel").createNestedObject ("data");
+  Data["DistanceToGo"] = 617;
+  Data["Speed"] = 4000.0f;
+}
+
+static void benchDocument (const char *_Label, void (*_Fill) (JsonDocument &)) {
+  static char Json[BENCH_BUFFERSIZE];
+  static char Pack[BENCH_BUFFERSIZE];
+  char Text[160];
+  DynamicJsonDocument Doc (BENCH_DOCSIZE);
+  DynamicJsonDocument In (BENCH_DOCSIZE);
+  _Fill (Doc);
+
+  size_t JsonLength = measureJson (Doc);
+  size_t PackLength = measureMsgPack (Doc);
+  TEST_ASSERT_EQUAL (JsonLength, serializeJson (Doc, Json, sizeof (Json)));
+  TEST_ASSERT_EQUAL (PackLength, serializeMsgPack (Doc, Pack, sizeof (Pack)));
+
+  // same Content after the Round-Trip
+  TEST_ASSERT_TRUE (deserializeMsgPack (In, Pack, PackLength) == DeserializationError::Ok);
+  static char Check[BENCH_BUFFERSIZE];
+  serializeJson (In, Check, sizeof (Check));
+  TEST_ASSERT_EQUAL_STRING (Json, Check);
+
+  uint64_t Start = hostMicros ();
+  for (int i = 0; i < BENCH_ROUNDS; i++) {
+    Sink = serializeJson (Doc, Json, sizeof (Json));
+  }
+  double JsonEncode = (hostMicros () - Start) * 1000.0 / BENCH_ROUNDS;
+  Start = hostMicros ();
+  for (int i = 0; i < BENCH_ROUNDS; i++) {
+    Sink = serializeMsgPack (Doc, Pack, sizeof (Pack));
+  }
+  double PackEncode = (hostMicros () - Start) * 1000.0 / BENCH_ROUNDS;
+  Start = hostMicros ();
+  for (int i = 0; i < BENCH_ROUNDS; i++) {
+    deserializeJson (In, (const char *)Json, JsonLength);
+    Sink = In.memoryUsage ();
+  }
+  double JsonDecode = (hostMicros () - Start) * 1000.0 / BENCH_ROUNDS;
+  Start = hostMicros ();
+  for (int i = 0; i < BENCH_ROUNDS; i++) {
+    deserializeMsgPack (In, (const char *)Pack, PackLength);
+    Sink = In.memoryUsage ();
+  }
+  double PackDecode = (hostMicros () - Start) * 1000.0 / BENCH_ROUNDS;
+
+  snprintf (Text, sizeof (Text), "%s JSON:        %u Bytes, Encode %.0f ns, Decode %.0f ns", _Label, (unsigned)JsonLength, JsonEncode, JsonDecode);
+  TEST_MESSAGE (Text);
+  snprintf (Text, sizeof (Text), "%s MessagePack: %u Bytes, Encode %.0f ns, Decode %.0f ns", _Label, (unsigned)PackLength, PackEncode, PackDecode);
+  TEST_MESSAGE (Text);
+  TEST_ASSERT_LESS_THAN (JsonLength, PackLength);
+}
+
+void setUp () {}
+void tearDown () {}
+
+void test_bench_full () {
+  benchDocument ("Full ", fillFull);
+}
+
+void test_bench_delta () {
+  benchDocument ("Delta", fillDelta);
+}
+
+int main (int argc, char **argv) {
+  UNITY_BEGIN ();
+  RUN_TEST (test_bench_full);
+  RUN_TEST (test_bench_delta);
+  return UNITY_END ();
+}
@@ -0,0 +1,132 @@
+#include <JCA_SYS_StepGenerator.h>
+#include <unity.h>
+using namespace JCA::SYS;
+
+// Host-Benchmark of the Interval per Step: Ramp-Table against the AccelStepper Float-Path.
+// The Host has an FPU, on the ESP8266 every Float-Division is emulated, so the Gap is bigger there.
+#define BENCH_RAMP_SIZE 256
+#define BENCH_MOVES 200
+#define BENCH_STEPS 20000UL
+#define BENCH_ACCELERATION 500.0
+#define BENCH_MAXSPEED 4000.0
+
+static volatile uint32_t Sink;
+
+/**
+ * @brief computeNewSpeed() of AccelStepper 1.64, reduced to forward Moves
+ * Called once per Step by AccelStepper::run()
+ */
+class AccelReference {
+private:
+  long Position;
+  long Target;
+  float Speed;
+  float Acceleration;
+  float C0;
+  float Cn;
+  float Cmin;
+  long N;
+
+public:
+  AccelReference (float _Acceleration, float _MaxSpeed) {
+    Acceleration = _Acceleration;
+    C0 = 0.676 * sqrt (2.0 / _Acceleration) * 1000000.0;
+    Cmin = 1000000.0 / _MaxSpeed;
+    Position = 0;
+    Target = 0;
+    Speed = 0.0;
+    Cn = 0.0;
+    N = 0;
+  }
+  void moveTo (long _Target) {
+    Target = _Target;
+  }
+  bool step (uint32_t &_Interval) {
+    long DistanceTo = Target - Position;
+    long StepsToStop = (long)((Speed * Speed) / (2.0 * Acceleration));
+    if (DistanceTo == 0 && StepsToStop <= 1) {
+      Speed = 0.0;
+      N = 0;
+      return false;
+    }
+    if (N > 0 && StepsToStop >= DistanceTo) {
+      N = -StepsToStop;
+    }
+    if (N == 0) {
+      Cn = C0;
+    } else {
+      Cn = Cn - ((2.0 * Cn) / ((4.0 * N) + 1));
+      Cn = max (Cn, Cmin);
+    }
+    N++;
+    Speed = 1000000.0 / Cn;
+    _Interval = (uint32_t)Cn;
+    Position++;
+    return true;
+  }
+};
+
+void setUp () {}
+void tearDown () {}
+
+void test_bench_ramp () {
+  char Message[128];
+
+  // Reference
+  AccelReference Reference (BENCH_ACCELERATION, BENCH_MAXSPEED);
+  uint64_t ReferenceSteps = 0;
+  uint64_t Start = hostMicros ();
+  for (int m = 0; m < BENCH_MOVES; m++) {
+    uint32_t Interval;
+    Reference.moveTo ((m + 1) * BENCH_STEPS);
+    while (Reference.step (Interval)) {
+      Sink = Interval;
+      ReferenceSteps++;
+    }
+  }
+  uint64_t ReferenceTime = hostMicros () - Start;
+
+  // Ramp-Table, Segments as planned by Feeder::planMove and stepped by StepGenerator::doStep
+  static uint32_t Ramp[BENCH_RAMP_SIZE];
+  uint8_t Shift;
+  uint32_t RampSteps = StepGenerator::buildRamp (Ramp, BENCH_RAMP_SIZE, BENCH_ACCELERATION, BENCH_MAXSPEED, Shift);
+  uint64_t TableSteps = 0;
+  Start = hostMicros ();
+  for (int m = 0; m < BENCH_MOVES; m++) {
+    StepSegment Segments[3];
+    uint32_t AccelSteps = min (RampSteps, (uint32_t)(BENCH_STEPS + 1) / 2);
+    uint32_t DecelSteps = min (RampSteps, (uint32_t)BENCH_STEPS / 2);
+    uint32_t ConstSteps = BENCH_STEPS - AccelSteps - DecelSteps;
+    Segments[0] = {0, AccelSteps, true, Ramp, 0, 1, Shift};
+    Segments[1] = {(uint32_t)(JCA_SYS_STEPGENERATOR_TICKS_PER_SECOND / BENCH_MAXSPEED), ConstSteps, true, nullptr, 0, 0, 0};
+    Segments[2] = {0, DecelSteps, true, Ramp, (int32_t)DecelSteps - 1, -1, Shift};
+    for (StepSegment &Active : Segments) {
+      while (Active.Steps > 0) {
+        uint32_t Interval = Active.Interval;
+        if (Active.Ramp != nullptr) {
+          Interval = Active.Ramp[Active.RampStep >> Active.RampShift];
+          Active.RampStep += Active.RampDelta;
+        }
+        Sink = Interval;
+        Active.Steps--;
+        TableSteps++;
+      }
+    }
+  }
+  uint64_t TableTime = hostMicros () - Start;
+
+  double ReferenceNs = ReferenceTime * 1000.0 / ReferenceSteps;
+  double TableNs = TableTime * 1000.0 / TableSteps;
+  snprintf (Message, sizeof (Message), "AccelStepper: %llu Steps, %.2f ns/Step, %.0f kSteps/s", (unsigned long long)ReferenceSteps, ReferenceNs, 1000000.0 / ReferenceNs);
+  TEST_MESSAGE (Message);
+  snprintf (Message, sizeof (Message), "Ramp-Table:   %llu Steps, %.2f ns/Step, %.0f kSteps/s", (unsigned long long)TableSteps, TableNs, 1000000.0 / TableNs);
+  TEST_MESSAGE (Message);
+  TEST_ASSERT_UINT32_WITHIN (BENCH_MOVES, ReferenceSteps, TableSteps);
+  TEST_ASSERT_LESS_THAN (ReferenceNs, TableNs);
+}
+
+int main (int argc, char **argv) {
+  UNITY_BEGIN ();
+  RUN_TEST (test_bench_ramp);
+  return UNITY_END ();
+}
@@ -0,0 +1,162 @@
+#include <JCA_FNC_Tag.h>
+#include <unity.h>
+using namespace JCA::FNC;
+
+// Host-Benchmark of the Element-Routing of a Message containing every Element.
+// The Message is a plain Array, so only the Routing is measured, not the JSON-Iteration.
+#define BENCH_MAXELEMENTS 32
+#define BENCH_ROUNDS 20000
+
+static volatile uint32_t Sink;
+
+/**
+ * @brief Element-Object of the Message ("elements": [{"name": ..., "config": [], "data": [], "cmd": []}])
+ */
+struct BenchMessage {
+  const char *Name;
+  bool HasConfig;
+  bool HasData;
+  bool HasCmd;
+};
+
+/**
+ * @brief Registered Element with Name-Hash like the Protocol
+ */
+struct BenchElement {
+  char Name[16];
+  uint32_t NameHash;
+  uint32_t Dispatched;
+};
+
+static BenchElement Elements[BENCH_MAXELEMENTS];
+static BenchElement *Index[BENCH_MAXELEMENTS];
+static BenchMessage Message[BENCH_MAXELEMENTS];
+static uint8_t ElementCount;
+
+static void createElements (uint8_t _Count) {
+  ElementCount = 0;
+  for (uint8_t i = 0; i < _Count; i++) {
+    BenchElement &Element = Elements[i];
+    snprintf (Element.Name, sizeof (Element.Name), "Element%02u", (unsigned)i);
+    Element.NameHash = tagHash (Element.Name);
+    Element.Dispatched = 0;
+    // Protocol::registerElement
+    uint8_t Pos = ElementCount;
+    while (Pos > 0 && Index[Pos - 1]->NameHash > Element.NameHash) {
+      Index[Pos] = Index[Pos - 1];
+      Pos--;
+    }
+    Index[Pos] = &Element;
+    ElementCount++;
+    // the Website sends the Elements in reverse Order
+    Message[_Count - 1 - i] = {Element.Name, true, true, true};
+  }
+}
+
+// ----- Before: every Element scans the whole Message for Config, Data and Cmd -----
+static const BenchMessage *findBlock (const BenchElement &_Element, uint8_t _Count, bool BenchMessage::*_Block) {
+  for (uint8_t i = 0; i < _Count; i++) {
+    if (strcmp (Message[i].Name, _Element.Name) == 0) {
+      if (Message[i].*_Block) {
+        return &Message[i];
+      }
+    }
+  }
+  return nullptr;
+}
+
+static void routeScan (uint8_t _Count) {
+  for (uint8_t e = 0; e < ElementCount; e++) {
+    BenchElement &Element = Elements[e];
+    if (findBlock (Element, _Count, &BenchMessage::HasConfig) != nullptr) {
+      Element.Dispatched++;
+    }
+    if (findBlock (Element, _Count, &BenchMessage::HasData) != nullptr) {
+      Element.Dispatched++;
+    }
+    if (findBlock (Element, _Count, &BenchMessage::HasCmd) != nullptr) {
+      Element.Dispatched++;
+    }
+  }
+}
+
+// ----- After: one Pass over the Message, Protocol::findElement on the Hash-Index -----
+static BenchElement *findElement (const char *_Name) {
+  uint32_t Hash = tagHash (_Name);
+  uint8_t Low = 0;
+  uint8_t High = ElementCount;
+  while (Low < High) {
+    uint8_t Mid = (Low + High) / 2;
+    if (Index[Mid]->NameHash < Hash) {
+      Low = Mid + 1;
+    } else {
+      High = Mid;
+    }
+  }
+  for (; Low < ElementCount && Index[Low]->NameHash == Hash; Low++) {
+    if (strcmp (Index[Low]->Name, _Name) == 0) {
+      return Index[Low];
+    }
+  }
+  return nullptr;
+}
+
+static void routeIndex (uint8_t _Count) {
+  for (uint8_t i = 0; i < _Count; i++) {
+    BenchElement *Target = findElement (Message[i].Name);
+    if (Target != nullptr) {
+      Target->Dispatched += Message[i].HasConfig + Message[i].HasData + Message[i].HasCmd;
+    }
+  }
+}
+
+static uint32_t dispatched () {
+  uint32_t Sum = 0;
+  for (uint8_t i = 0; i < ElementCount; i++) {
+    Sum += Elements[i].Dispatched;
+    Elements[i].Dispatched = 0;
+  }
+  return Sum;
+}
+
+void setUp () {}
+void tearDown () {}
+
+void test_bench_routing () {
+  static const uint8_t Counts[] = {3, 8, 24, 32};
+  char Text[128];
+  for (uint8_t Count : Counts) {
+    createElements (Count);
+
+    uint64_t Start = hostMicros ();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+      routeScan (Count);
+    }
+    uint64_t ScanTime = hostMicros () - Start;
+    uint32_t ScanDispatched = dispatched ();
+
+    Start = hostMicros ();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+      routeIndex (Count);
+    }
+    uint64_t IndexTime = hostMicros () - Start;
+    uint32_t IndexDispatched = dispatched ();
+    Sink = ScanDispatched + IndexDispatched;
+
+    double ScanNs = ScanTime * 1000.0 / BENCH_ROUNDS;
+    double IndexNs = IndexTime * 1000.0 / BENCH_ROUNDS;
+    snprintf (Text, sizeof (Text), "%2u Elements: 3 Scans %.0f ns/Message, Single Pass %.0f ns/Message", (unsigned)Count, ScanNs, IndexNs);
+    TEST_MESSAGE (Text);
+    TEST_ASSERT_EQUAL_UINT32 (3UL * Count * BENCH_ROUNDS, ScanDispatched);
+    TEST_ASSERT_EQUAL_UINT32 (ScanDispatched, IndexDispatched);
+    if (Count >= 8) {
+      TEST_ASSERT_LESS_THAN (ScanNs, IndexNs);
+    }
+  }
+}
+
+int main (int argc, char **argv) {
+  UNITY_BEGIN ();
+  RUN_TEST (test_bench_routing);
+  return UNITY_END ();
+}
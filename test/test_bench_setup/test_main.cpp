@@ -0,0 +1,243 @@
+#include <JCA_SYS_JsonStream.h>
+#include <new>
+#include <unity.h>
+using namespace JCA::SYS;
+
+// Host-Benchmark of the Setup-Save: String-Concatenation against the JsonStream.
+// The Element is the Feeder-Setup of the String-Version, written BENCH_ELEMENTS times.
+#define BENCH_ELEMENTS 3
+#define BENCH_SAVES 20000
+
+static size_t Allocations = 0;
+
+void *operator new (size_t _Size) {
+  Allocations++;
+  void *Memory = malloc (_Size);
+  if (Memory == nullptr) {
+    throw std::bad_alloc ();
+  }
+  return Memory;
+}
+void operator delete (void *_Memory) noexcept {
+  free (_Memory);
+}
+void operator delete (void *_Memory, size_t) noexcept {
+  free (_Memory);
+}
+
+/**
+ * @brief File-Replacement, counts the written Bytes
+ */
+class CountingFile : public Print {
+public:
+  size_t Bytes = 0;
+  size_t write (uint8_t _Char) override {
+    Bytes++;
+    return 1;
+  }
+  size_t write (const uint8_t *_Buffer, size_t _Size) override {
+    Bytes += _Size;
+    return _Size;
+  }
+  using Print::write;
+};
+
+static const char *JsonTagName = "name";
+static const char *JsonTagText = "text";
+static const char *JsonTagComment = "comment";
+static const char *JsonTagReadOnly = "readOnly";
+static const char *JsonTagUnit = "unit";
+static const char *JsonTagValue = "value";
+static const char *JsonTagOn = "on";
+static const char *JsonTagOff = "off";
+static const char *JsonTagType = "type";
+static const char *JsonTagBtnText = "btnText";
+static const char *JsonTagConfig = "config";
+static const char *JsonTagData = "data";
+static const char *JsonTagElements = "elements";
+
+struct BenchTag {
+  const char *Name;
+  const char *Text;
+  const char *Comment;
+  bool ReadOnly;
+  const char *Unit;
+  float Value;
+};
+
+static const BenchTag ConfigTags[] = {
+    {"FeedingHour", "Fütterung Stunde", nullptr, false, "h", 7},
+    {"FeedingMinute", "Fütterung Minute", nullptr, false, "min", 30},
+    {"SteppsPerRotation", "Schritte pro Umdrehung", nullptr, false, "st/r", 200},
+    {"FeedingRotations", "Umdrehungen pro Fütterung", nullptr, false, "r", 2.5},
+    {"Acceleration", "Beschleuningung", nullptr, false, "st/s2", 500},
+    {"MaxSpeed", "Maximale Geschwindigkeit", nullptr, false, "st/s", 4000},
+    {"ConstSpeed", "Konstante Geschwindigkeit", nullptr, false, "st/s", 1000}};
+static const BenchTag DataTags[] = {
+    {"DistanceToGo", "Reststrecke", nullptr, true, "st", 1234},
+    {"Speed", "Geschwindigkeit", nullptr, true, "st/s", 812.5}};
+
+// ----- Before: String-Concatenation like the former createSetupTag -----
+static String createDefaultTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly) {
+  String SetupTag;
+  SetupTag += "\"" + String (JsonTagName) + "\":\"" + String (_Name) + "\"";
+  SetupTag += ",\"" + String (JsonTagText) + "\":\"" + String (_Text) + "\"";
+  if (_Comment != nullptr) {
+    SetupTag += ",\"" + String (JsonTagComment) + "\":\"" + String (_Comment) + "\"";
+  }
+  SetupTag += ",\"" + String (JsonTagReadOnly) + "\":" + String (_ReadOnly);
+  return SetupTag;
+}
+
+static String createSetupTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_BtnOnText, const char *_BtnOffText, bool _Value) {
+  String SetupTag = createDefaultTag (_Name, _Text, _Comment, _ReadOnly);
+  SetupTag += ",\"" + String (JsonTagOn) + "\":\"" + String (_BtnOnText) + "\"";
+  SetupTag += ",\"" + String (JsonTagOff) + "\":\"" + String (_BtnOffText) + "\"";
+  SetupTag += ",\"" + String (JsonTagValue) + "\":";
+  SetupTag += _Value ? "true" : "false";
+  return SetupTag;
+}
+
+static String createSetupTag (const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, float _Value) {
+  String SetupTag = createDefaultTag (_Name, _Text, _Comment, _ReadOnly);
+  if (_Unit != nullptr) {
+    SetupTag += ",\"" + String (JsonTagUnit) + "\":\"" + String (_Unit) + "\"";
+  }
+  SetupTag += ",\"" + String (JsonTagValue) + "\":" + String (_Value);
+  return SetupTag;
+}
+
+static String createSetupCmdInfo (const char *_Name, const char *_Text, const char *_Comment, const char *_Type, const char *_BtnText) {
+  String SetupTag = createDefaultTag (_Name, _Text, _Comment, false);
+  SetupTag += ",\"" + String (JsonTagType) + "\":\"" + String (_Type) + "\"";
+  SetupTag += ",\"" + String (JsonTagBtnText) + "\":\"" + String (_BtnText) + "\"";
+  return SetupTag;
+}
+
+static void saveString (Print &_File) {
+  _File.println ("{\"" + String (JsonTagElements) + "\":[");
+  for (int e = 0; e < BENCH_ELEMENTS; e++) {
+    _File.println (e > 0 ? ",{" : "{");
+    _File.println ("\"" + String (JsonTagName) + "\":\"" + String ("Futter") + "\"");
+    _File.println (",\"" + String (JsonTagConfig) + "\":[");
+    for (size_t i = 0; i < sizeof (ConfigTags) / sizeof (ConfigTags[0]); i++) {
+      const BenchTag &Tag = ConfigTags[i];
+      _File.println ((i > 0 ? ",{" : "{") + createSetupTag (Tag.Name, Tag.Text, Tag.Comment, Tag.ReadOnly, Tag.Unit, Tag.Value) + "}");
+    }
+    _File.println ("]");
+    _File.println (",\"" + String (JsonTagData) + "\":[");
+    _File.println ("{" + createSetupTag ("Feeding", "Fütterung aktiv", nullptr, true, "Ja", "Nein", false) + "}");
+    for (size_t i = 0; i < sizeof (DataTags) / sizeof (DataTags[0]); i++) {
+      const BenchTag &Tag = DataTags[i];
+      _File.println (",{" + createSetupTag (Tag.Name, Tag.Text, Tag.Comment, Tag.ReadOnly, Tag.Unit, Tag.Value) + "}");
+    }
+    _File.println (",{" + createSetupTag ("RunConst", "Dauerlauf", nullptr, false, "Ein", "Aus", true) + "}");
+    _File.println (",{" + createSetupCmdInfo ("doFeed", "Füttern", nullptr, "button", "Start") + "}");
+    _File.println ("]");
+    _File.println ("}");
+  }
+  _File.println ("]}");
+}
+
+// ----- After: JsonStream like Protocol::writeSetupTag -----
+static void writeDefaultTag (JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly) {
+  _Setup.beginObject ();
+  _Setup.add (JsonTagName, _Name);
+  _Setup.add (JsonTagText, _Text);
+  if (_Comment != nullptr) {
+    _Setup.add (JsonTagComment, _Comment);
+  }
+  _Setup.add (JsonTagReadOnly, _ReadOnly);
+}
+
+static void writeSetupTag (JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_BtnOnText, const char *_BtnOffText, bool _Value) {
+  writeDefaultTag (_Setup, _Name, _Text, _Comment, _ReadOnly);
+  _Setup.add (JsonTagOn, _BtnOnText);
+  _Setup.add (JsonTagOff, _BtnOffText);
+  _Setup.add (JsonTagValue, _Value);
+  _Setup.endObject ();
+}
+
+static void writeSetupTag (JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, bool _ReadOnly, const char *_Unit, float _Value) {
+  writeDefaultTag (_Setup, _Name, _Text, _Comment, _ReadOnly);
+  if (_Unit != nullptr) {
+    _Setup.add (JsonTagUnit, _Unit);
+  }
+  _Setup.add (JsonTagValue, (double)_Value);
+  _Setup.endObject ();
+}
+
+static void writeSetupCmdTag (JsonStream &_Setup, const char *_Name, const char *_Text, const char *_Comment, const char *_Type, const char *_BtnText) {
+  writeDefaultTag (_Setup, _Name, _Text, _Comment, false);
+  _Setup.add (JsonTagType, _Type);
+  _Setup.add (JsonTagBtnText, _BtnText);
+  _Setup.endObject ();
+}
+
+static void saveStream (Print &_File) {
+  JsonStream Setup (_File);
+  Setup.beginObject ();
+  Setup.beginArray (JsonTagElements);
+  for (int e = 0; e < BENCH_ELEMENTS; e++) {
+    Setup.beginObject ();
+    Setup.add (JsonTagName, "Futter");
+    Setup.beginArray (JsonTagConfig);
+    for (const BenchTag &Tag : ConfigTags) {
+      writeSetupTag (Setup, Tag.Name, Tag.Text, Tag.Comment, Tag.ReadOnly, Tag.Unit, Tag.Value);
+    }
+    Setup.endArray ();
+    Setup.beginArray (JsonTagData);
+    writeSetupTag (Setup, "Feeding", "Fütterung aktiv", nullptr, true, "Ja", "Nein", false);
+    for (const BenchTag &Tag : DataTags) {
+      writeSetupTag (Setup, Tag.Name, Tag.Text, Tag.Comment, Tag.ReadOnly, Tag.Unit, Tag.Value);
+    }
+    writeSetupTag (Setup, "RunConst", "Dauerlauf", nullptr, false, "Ein", "Aus", true);
+    writeSetupCmdTag (Setup, "doFeed", "Füttern", nullptr, "button", "Start");
+    Setup.endArray ();
+    Setup.endObject ();
+  }
+  Setup.endArray ();
+  Setup.endObject ();
+}
+
+void setUp () {}
+void tearDown () {}
+
+void test_bench_setup () {
+  char Message[128];
+  CountingFile File;
+
+  size_t StartAllocations = Allocations;
+  uint64_t Start = hostMicros ();
+  for (int i = 0; i < BENCH_SAVES; i++) {
+    saveString (File);
+  }
+  uint64_t StringTime = hostMicros () - Start;
+  double StringAllocations = (double)(Allocations - StartAllocations) / BENCH_SAVES;
+  size_t StringBytes = File.Bytes / BENCH_SAVES;
+
+  File.Bytes = 0;
+  StartAllocations = Allocations;
+  Start = hostMicros ();
+  for (int i = 0; i < BENCH_SAVES; i++) {
+    saveStream (File);
+  }
+  uint64_t StreamTime = hostMicros () - Start;
+  double StreamAllocations = (double)(Allocations - StartAllocations) / BENCH_SAVES;
+  size_t StreamBytes = File.Bytes / BENCH_SAVES;
+
+  double StringUs = (double)StringTime / BENCH_SAVES;
+  double StreamUs = (double)StreamTime / BENCH_SAVES;
+  snprintf (Message, sizeof (Message), "String:     %.2f us/Save, %.1f Allocations/Save, %u Bytes", StringUs, StringAllocations, (unsigned)StringBytes);
+  TEST_MESSAGE (Message);
+  snprintf (Message, sizeof (Message), "JsonStream: %.2f us/Save, %.1f Allocations/Save, %u Bytes", StreamUs, StreamAllocations, (unsigned)StreamBytes);
+  TEST_MESSAGE (Message);
+  TEST_ASSERT_EQUAL (0, StreamAllocations);
+  TEST_ASSERT_LESS_THAN (StringUs, StreamUs);
+}
+
+int main (int argc, char **argv) {
+  UNITY_BEGIN ();
+  RUN_TEST (test_bench_setup);
+  return UNITY_END ();
+}
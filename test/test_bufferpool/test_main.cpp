@@ -0,0 +1,60 @@
+#include <JCA_SYS_BufferPool.h>
+#include <unity.h>
+using namespace JCA::SYS;
+
+void setUp () {}
+void tearDown () {}
+
+void test_take_before_begin () {
+  BufferPool Pool (2, 16);
+  TEST_ASSERT_NULL (Pool.take ());
+  TEST_ASSERT_EQUAL_UINT32 (1, Pool.exhausted ());
+}
+
+void test_take_and_give () {
+  BufferPool Pool (2, 16);
+  TEST_ASSERT_TRUE (Pool.begin ());
+  uint8_t *First = Pool.take ();
+  uint8_t *Second = Pool.take ();
+  TEST_ASSERT_NOT_NULL (First);
+  TEST_ASSERT_NOT_NULL (Second);
+  TEST_ASSERT_EQUAL (16, Second - First);
+  TEST_ASSERT_NULL (Pool.take ());
+  TEST_ASSERT_EQUAL_UINT32 (1, Pool.exhausted ());
+  Pool.give (First);
+  TEST_ASSERT_EQUAL_UINT8 (1, Pool.used ());
+  TEST_ASSERT_EQUAL_PTR (First, Pool.take ());
+  TEST_ASSERT_EQUAL_UINT8 (2, Pool.maxUsed ());
+}
+
+void test_give_foreign_or_twice () {
+  BufferPool Pool (2, 16);
+  Pool.begin ();
+  uint8_t Foreign[16];
+  uint8_t *Buffer = Pool.take ();
+  Pool.give (Foreign);
+  Pool.give (nullptr);
+  TEST_ASSERT_EQUAL_UINT8 (1, Pool.used ());
+  Pool.give (Buffer);
+  Pool.give (Buffer);
+  TEST_ASSERT_EQUAL_UINT8 (0, Pool.used ());
+}
+
+void test_count_is_limited () {
+  BufferPool Pool (JCA_SYS_BUFFERPOOL_MAXBUFFERS + 4, 4);
+  Pool.begin ();
+  uint8_t Taken = 0;
+  while (Pool.take () != nullptr) {
+    Taken++;
+  }
+  TEST_ASSERT_EQUAL_UINT8 (JCA_SYS_BUFFERPOOL_MAXBUFFERS, Taken);
+}
+
+int main (int argc, char **argv) {
+  UNITY_BEGIN ();
+  RUN_TEST (test_take_before_begin);
+  RUN_TEST (test_take_and_give);
+  RUN_TEST (test_give_foreign_or_twice);
+  RUN_TEST (test_count_is_limited);
+  return UNITY_END ();
+}
@@ -0,0 +1,81 @@
+#include <JCA_SYS_Histogram.h>
+#include <unity.h>
+using namespace JCA::SYS;
+
+static const uint32_t Bounds[] = {10, 100, 1000};
+
+void setUp () {}
+void tearDown () {}
+
+void test_bucket_by_upper_bound () {
+  Histogram Values (Bounds, 3);
+  Values.add (0);
+  Values.add (10);
+  Values.add (11);
+  Values.add (1000);
+  Values.add (1001);
+  TEST_ASSERT_EQUAL_UINT8 (4, Values.size ());
+  TEST_ASSERT_EQUAL_UINT32 (2, Values.bucket (0));
+  TEST_ASSERT_EQUAL_UINT32 (1, Values.bucket (1));
+  TEST_ASSERT_EQUAL_UINT32 (1, Values.bucket (2));
+  TEST_ASSERT_EQUAL_UINT32 (1, Values.bucket (3));
+  TEST_ASSERT_EQUAL_UINT32 (0, Values.bucket (4));
+  TEST_ASSERT_EQUAL_UINT32 (UINT32_MAX, Values.bound (3));
+}
+
+void test_statistics () {
+  Histogram Values (Bounds, 3);
+  TEST_ASSERT_EQUAL_UINT32 (0, Values.min ());
+  TEST_ASSERT_EQUAL_UINT32 (0, Values.mean ());
+  Values.add (5);
+  Values.add (15);
+  Values.add (40);
+  TEST_ASSERT_EQUAL_UINT32 (3, Values.count ());
+  TEST_ASSERT_EQUAL_UINT64 (60, Values.sum ());
+  TEST_ASSERT_EQUAL_UINT32 (5, Values.min ());
+  TEST_ASSERT_EQUAL_UINT32 (40, Values.max ());
+  TEST_ASSERT_EQUAL_UINT32 (20, Values.mean ());
+  Values.reset ();
+  TEST_ASSERT_EQUAL_UINT32 (0, Values.count ());
+  TEST_ASSERT_EQUAL_UINT32 (0, Values.bucket (0));
+}
+
+void test_without_bounds () {
+  Histogram Values;
+  Values.add (123);
+  TEST_ASSERT_EQUAL_UINT8 (1, Values.size ());
+  TEST_ASSERT_EQUAL_UINT32 (1, Values.bucket (0));
+}
+
+void test_print_buckets () {
+  Histogram Values (Bounds, 3);
+  char Text[64];
+  TEST_ASSERT_EQUAL (0, Values.printBuckets (Text, sizeof (Text)));
+  TEST_ASSERT_EQUAL_STRING ("", Text);
+  Values.add (1);
+  Values.add (2);
+  Values.add (500);
+  Values.add (5000);
+  Values.printBuckets (Text, sizeof (Text));
+  TEST_ASSERT_EQUAL_STRING ("10:2,1000:1,inf:1", Text);
+}
+
+void test_print_buckets_cut () {
+  Histogram Values (Bounds, 3);
+  char Text[8];
+  Values.add (1);
+  Values.add (500);
+  size_t Length = Values.printBuckets (Text, sizeof (Text));
+  TEST_ASSERT_EQUAL (7, Length);
+  TEST_ASSERT_EQUAL_STRING ("10:1,10", Text);
+}
+
+int main (int argc, char **argv) {
+  UNITY_BEGIN ();
+  RUN_TEST (test_bucket_by_upper_bound);
+  RUN_TEST (test_statistics);
+  RUN_TEST (test_without_bounds);
+  RUN_TEST (test_print_buckets);
+  RUN_TEST (test_print_buckets_cut);
+  return UNITY_END ();
+}
@@ -0,0 +1,63 @@
+#include <JCA_SYS_JsonPool.h>
+#include <unity.h>
+using namespace JCA::SYS;
+
+void setUp () {}
+void tearDown () {}
+
+void test_begin_allocates_all () {
+  JsonPool Pool (3, 256);
+  TEST_ASSERT_EQUAL_UINT8 (3, Pool.begin ());
+  TEST_ASSERT_EQUAL_UINT8 (3, Pool.size ());
+  TEST_ASSERT_EQUAL (256, Pool.capacity ());
+}
+
+void test_exhausted () {
+  JsonPool Pool (2, 256);
+  Pool.begin ();
+  JsonDocument *First = Pool.take ();
+  JsonDocument *Second = Pool.take ();
+  TEST_ASSERT_NOT_NULL (First);
+  TEST_ASSERT_NOT_NULL (Second);
+  TEST_ASSERT_NULL (Pool.take ());
+  TEST_ASSERT_EQUAL_UINT32 (1, Pool.exhausted ());
+  Pool.give (First);
+  TEST_ASSERT_EQUAL_PTR (First, Pool.take ());
+  TEST_ASSERT_EQUAL_UINT8 (2, Pool.maxUsed ());
+}
+
+void test_cleared_on_take () {
+  JsonPool Pool (1, 256);
+  Pool.begin ();
+  JsonDocument *Doc = Pool.take ();
+  (*Doc)["seq"] = 1;
+  size_t Usage = Doc->memoryUsage ();
+  TEST_ASSERT_GREATER_THAN (0, Usage);
+  Pool.give (Doc);
+  TEST_ASSERT_EQUAL (Usage, Pool.maxMemory ());
+  Doc = Pool.take ();
+  TEST_ASSERT_EQUAL (0, Doc->memoryUsage ());
+}
+
+void test_lease_gives_back () {
+  JsonPool Pool (1, 256);
+  Pool.begin ();
+  {
+    JsonPoolDoc Lease (Pool);
+    TEST_ASSERT_TRUE ((bool)Lease);
+    JsonPoolDoc Busy (Pool);
+    TEST_ASSERT_FALSE ((bool)Busy);
+  }
+  TEST_ASSERT_EQUAL_UINT8 (0, Pool.used ());
+  JsonPoolDoc Lease (Pool);
+  TEST_ASSERT_TRUE ((bool)Lease);
+}
+
+int main (int argc, char **argv) {
+  UNITY_BEGIN ();
+  RUN_TEST (test_begin_allocates_all);
+  RUN_TEST (test_exhausted);
+  RUN_TEST (test_cleared_on_take);
+  RUN_TEST (test_lease_gives_back);
+  return UNITY_END ();
+}
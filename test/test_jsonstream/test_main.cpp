@@ -0,0 +1,98 @@
+#include <JCA_SYS_JsonStream.h>
+#include <unity.h>
+using namespace JCA::SYS;
+
+/**
+ * @brief Target collecting the Output and counting the Blocks
+ */
+class TextTarget : public Print {
+public:
+  std::string Text;
+  size_t Blocks = 0;
+  size_t write (uint8_t _Char) override {
+    Text += (char)_Char;
+    return 1;
+  }
+  size_t write (const uint8_t *_Buffer, size_t _Size) override {
+    Text.append ((const char *)_Buffer, _Size);
+    Blocks++;
+    return _Size;
+  }
+  using Print::write;
+};
+
+void setUp () {}
+void tearDown () {}
+
+void test_nested_with_commas () {
+  TextTarget Target;
+  {
+    JsonStream Json (Target);
+    Json.beginObject ();
+    Json.beginArray ("elements");
+    Json.beginObject ();
+    Json.add ("name", "Spindel");
+    Json.add ("run", true);
+    Json.endObject ();
+    Json.beginObject ();
+    Json.add ("name", "Futter");
+    Json.endObject ();
+    Json.endArray ();
+    Json.add ("seq", 42);
+    Json.endObject ();
+  }
+  TEST_ASSERT_EQUAL_STRING ("{\"elements\":[{\"name\":\"Spindel\",\"run\":true},{\"name\":\"Futter\"}],\"seq\":42}", Target.Text.c_str ());
+}
+
+void test_escape () {
+  TextTarget Target;
+  {
+    JsonStream Json (Target);
+    Json.beginObject ();
+    Json.add ("text", "a\"b\\c\nd\te\x01");
+    Json.add ("null", (const char *)nullptr);
+    Json.endObject ();
+  }
+  TEST_ASSERT_EQUAL_STRING ("{\"text\":\"a\\\"b\\\\c\\nd\\te\\u0001\",\"null\":null}", Target.Text.c_str ());
+}
+
+void test_numbers () {
+  TextTarget Target;
+  {
+    JsonStream Json (Target);
+    Json.beginArray ();
+    Json.add (nullptr, -12);
+    Json.add (nullptr, 4000000000UL);
+    Json.add (nullptr, 1.5);
+    Json.add (nullptr, -0.25);
+    Json.add (nullptr, NAN);
+    Json.add (nullptr, 1e20);
+    Json.endArray ();
+  }
+  TEST_ASSERT_EQUAL_STRING ("[-12,4000000000,1.50,-0.25,null,null]", Target.Text.c_str ());
+}
+
+void test_blocks () {
+  TextTarget Target;
+  JsonStream Json (Target);
+  Json.beginArray ();
+  for (int i = 0; i < 100; i++) {
+    Json.add (nullptr, "0123456789");
+  }
+  Json.endArray ();
+  TEST_ASSERT_EQUAL (0, Target.Text.size () % JCA_SYS_JSONSTREAM_BUFFERSIZE);
+  Json.flush ();
+  // Brackets, 100 quoted Strings and 99 Commas
+  TEST_ASSERT_EQUAL (2 + 100 * 12 + 99, Target.Text.size ());
+  TEST_ASSERT_EQUAL (Target.Text.size (), Json.written ());
+  TEST_ASSERT_EQUAL ((Target.Text.size () + JCA_SYS_JSONSTREAM_BUFFERSIZE - 1) / JCA_SYS_JSONSTREAM_BUFFERSIZE, Target.Blocks);
+}
+
+int main (int argc, char **argv) {
+  UNITY_BEGIN ();
+  RUN_TEST (test_nested_with_commas);
+  RUN_TEST (test_escape);
+  RUN_TEST (test_numbers);
+  RUN_TEST (test_blocks);
+  return UNITY_END ();
+}
@@ -0,0 +1,65 @@
+#include <JCA_SYS_StepGenerator.h>
+#include <unity.h>
+using namespace JCA::SYS;
+
+#define RAMP_SIZE 256
+
+static uint32_t Ramp[RAMP_SIZE];
+
+void setUp () {
+  memset (Ramp, 0, sizeof (Ramp));
+}
+void tearDown () {}
+
+void test_no_ramp () {
+  uint8_t Shift = 7;
+  TEST_ASSERT_EQUAL_UINT32 (0, StepGenerator::buildRamp (Ramp, RAMP_SIZE, 0.0, 1000.0, Shift));
+  TEST_ASSERT_EQUAL_UINT8 (0, Shift);
+  TEST_ASSERT_EQUAL_UINT32 (0, StepGenerator::buildRamp (Ramp, RAMP_SIZE, 1000.0, 0.0, Shift));
+  TEST_ASSERT_EQUAL_UINT32 (0, Ramp[0]);
+}
+
+void test_short_ramp () {
+  uint8_t Shift;
+  // 100 st/s with 1000 st/s2 -> v(n) = sqrt(2an) reaches 100 st/s after 5 Steps
+  uint32_t Steps = StepGenerator::buildRamp (Ramp, RAMP_SIZE, 1000.0, 100.0, Shift);
+  TEST_ASSERT_UINT32_WITHIN (1, 5, Steps);
+  TEST_ASSERT_EQUAL_UINT8 (0, Shift);
+  // First Step needs sqrt(2/a) = 44.7ms
+  TEST_ASSERT_UINT32_WITHIN (5, 223607, Ramp[0]);
+}
+
+void test_long_ramp_fits () {
+  uint8_t Shift;
+  float MaxSpeed = 4000.0;
+  uint32_t Steps = StepGenerator::buildRamp (Ramp, RAMP_SIZE, 500.0, MaxSpeed, Shift);
+  TEST_ASSERT_UINT32_WITHIN (2, 16000, Steps);
+  TEST_ASSERT_LESS_THAN (RAMP_SIZE, (Steps - 1) >> Shift);
+  TEST_ASSERT_GREATER_OR_EQUAL (RAMP_SIZE / 2, (Steps - 1) >> Shift);
+
+  uint32_t Last = (Steps - 1) >> Shift;
+  for (uint32_t i = 1; i <= Last; i++) {
+    TEST_ASSERT_LESS_OR_EQUAL (Ramp[i - 1], Ramp[i]);
+  }
+  // the Ramp ends just above the Cruise-Interval
+  uint32_t Cruise = JCA_SYS_STEPGENERATOR_TICKS_PER_SECOND / MaxSpeed;
+  TEST_ASSERT_GREATER_OR_EQUAL (Cruise, Ramp[Last]);
+  TEST_ASSERT_LESS_THAN (Cruise + Cruise / 10, Ramp[Last]);
+}
+
+void test_interval_limits () {
+  uint8_t Shift;
+  // very slow Start is clipped to the 23 Bit Timer
+  uint32_t Steps = StepGenerator::buildRamp (Ramp, RAMP_SIZE, 0.001, 0.5, Shift);
+  TEST_ASSERT_GREATER_THAN (0, Steps);
+  TEST_ASSERT_EQUAL_UINT32 (JCA_SYS_STEPGENERATOR_INTERVAL_MAX, Ramp[0]);
+}
+
+int main (int argc, char **argv) {
+  UNITY_BEGIN ();
+  RUN_TEST (test_no_ramp);
+  RUN_TEST (test_short_ramp);
+  RUN_TEST (test_long_ramp_fits);
+  RUN_TEST (test_interval_limits);
+  return UNITY_END ();
+}
@@ -0,0 +1,101 @@
+#include <JCA_FNC_Schedule.h>
+#include <unity.h>
+using namespace JCA::FNC;
+
+static FeedingSlot Slots[JCA_FNC_FEEDER_SLOTS];
+
+static struct tm makeTime (int _WeekDay, int _Hour, int _Minute, int _Second) {
+  struct tm Time = {};
+  Time.tm_year = 126;
+  Time.tm_wday = _WeekDay;
+  Time.tm_hour = _Hour;
+  Time.tm_min = _Minute;
+  Time.tm_sec = _Second;
+  return Time;
+}
+
+void setUp () {
+  for (uint8_t i = 0; i < JCA_FNC_FEEDER_SLOTS; i++) {
+    Slots[i].Hour = -1;
+    Slots[i].Minute = 0;
+    Slots[i].Days = JCA_FNC_FEEDER_DAYS_ALL;
+    Slots[i].Dose = 0.0;
+  }
+}
+void tearDown () {}
+
+void test_sorted_by_time_of_day () {
+  Schedule Plan;
+  Slots[0].Hour = 18;
+  Slots[1].Hour = 7;
+  Slots[1].Minute = 30;
+  Slots[3].Hour = 12;
+  Plan.compile (Slots);
+  TEST_ASSERT_EQUAL_UINT8 (3, Plan.size ());
+  TEST_ASSERT_EQUAL_UINT8 (1, Plan.slot (0));
+  TEST_ASSERT_EQUAL_UINT8 (3, Plan.slot (1));
+  TEST_ASSERT_EQUAL_UINT8 (0, Plan.slot (2));
+}
+
+void test_invalid_slots_skipped () {
+  Schedule Plan;
+  Slots[0].Hour = 24;
+  Slots[1].Hour = 8;
+  Slots[1].Minute = 60;
+  Slots[2].Hour = 9;
+  Slots[2].Days = 0;
+  Plan.compile (Slots);
+  TEST_ASSERT_EQUAL_UINT8 (0, Plan.size ());
+  int32_t Delta;
+  uint8_t Slot;
+  TEST_ASSERT_FALSE (Plan.next (Slots, makeTime (1, 8, 0, 0), Delta, Slot));
+}
+
+void test_next_today () {
+  Schedule Plan;
+  Slots[0].Hour = 18;
+  Slots[1].Hour = 7;
+  Plan.compile (Slots);
+  int32_t Delta;
+  uint8_t Slot;
+  TEST_ASSERT_TRUE (Plan.next (Slots, makeTime (1, 12, 0, 0), Delta, Slot));
+  TEST_ASSERT_EQUAL_UINT8 (0, Slot);
+  TEST_ASSERT_EQUAL_INT32 (6 * 3600, Delta);
+}
+
+void test_due_slot_not_found_again () {
+  Schedule Plan;
+  Slots[0].Hour = 7;
+  Plan.compile (Slots);
+  int32_t Delta;
+  uint8_t Slot;
+  TEST_ASSERT_TRUE (Plan.next (Slots, makeTime (1, 7, 0, 0), Delta, Slot));
+  TEST_ASSERT_EQUAL_INT32 (86400, Delta);
+}
+
+void test_next_on_weekday () {
+  Schedule Plan;
+  // Saturday only
+  Slots[2].Hour = 10;
+  Slots[2].Days = 1 << 6;
+  Plan.compile (Slots);
+  int32_t Delta;
+  uint8_t Slot;
+  // Monday 10:00 -> Saturday 10:00
+  TEST_ASSERT_TRUE (Plan.next (Slots, makeTime (1, 10, 0, 0), Delta, Slot));
+  TEST_ASSERT_EQUAL_UINT8 (2, Slot);
+  TEST_ASSERT_EQUAL_INT32 (5 * 86400, Delta);
+  // Saturday 10:00 -> next Saturday
+  TEST_ASSERT_TRUE (Plan.next (Slots, makeTime (6, 10, 0, 0), Delta, Slot));
+  TEST_ASSERT_EQUAL_INT32 (7 * 86400, Delta);
+}
+
+int main (int argc, char **argv) {
+  UNITY_BEGIN ();
+  RUN_TEST (test_sorted_by_time_of_day);
+  RUN_TEST (test_invalid_slots_skipped);
+  RUN_TEST (test_next_today);
+  RUN_TEST (test_due_slot_not_found_again);
+  RUN_TEST (test_next_on_weekday);
+  return UNITY_END ();
+}
@@ -0,0 +1,41 @@
+#include <JCA_FNC_Tag.h>
+#include <unity.h>
+using namespace JCA::FNC;
+
+// Descriptor-Tables rely on the Hash being evaluated by the Compiler
+static_assert (tagHash ("") == JCA_FNC_TAG_HASH_BASIS, "tagHash has to be constexpr");
+
+void setUp () {}
+void tearDown () {}
+
+void test_fnv1a_vectors () {
+  TEST_ASSERT_EQUAL_HEX32 (0x811c9dc5UL, tagHash (""));
+  TEST_ASSERT_EQUAL_HEX32 (0xe40c292cUL, tagHash ("a"));
+  TEST_ASSERT_EQUAL_HEX32 (0xbf9cf968UL, tagHash ("foobar"));
+}
+
+void test_runtime_equals_compiletime () {
+  constexpr uint32_t Fixed = tagHash ("FeedingRotations");
+  char Name[] = "FeedingRotations";
+  TEST_ASSERT_EQUAL_HEX32 (Fixed, tagHash (Name));
+}
+
+void test_names_distinct () {
+  static const char *Names[] = {"System", "Spindel", "Futter", "Perf", "time", "seq", "elements", "config", "data", "cmd",
+                                "SteppsPerRotation", "FeedingRotations", "Acceleration", "MaxSpeed", "ConstSpeed", "Feeding",
+                                "RunConst", "doFeed", "Slot1Hour", "Slot1Minute", "Slot2Hour", "Slot2Minute", "StepLateInf"};
+  const size_t Count = sizeof (Names) / sizeof (Names[0]);
+  for (size_t i = 0; i < Count; i++) {
+    for (size_t j = i + 1; j < Count; j++) {
+      TEST_ASSERT_TRUE (tagHash (Names[i]) != tagHash (Names[j]));
+    }
+  }
+}
+
+int main (int argc, char **argv) {
+  UNITY_BEGIN ();
+  RUN_TEST (test_fnv1a_vectors);
+  RUN_TEST (test_runtime_equals_compiletime);
+  RUN_TEST (test_names_distinct);
+  return UNITY_END ();
+}